@@ -45,6 +45,8 @@ public class DialogSystemEditor : ModuleRules
                 "ApplicationCore",
                 "DesktopPlatform",
                 "XmlParser",
+                "AssetRegistry",
+                "Json",
 
                 "DialogSystemRuntime",
             }
@@ -0,0 +1,210 @@
+#include "DialogSystemEditor.h"
+#include "DialogAssetCompiler.h"
+#include "DialogAsset.h"
+#include "DialogNodes.h"
+#include "DialogEditorNodes.h"
+#include "QaDSSettings.h"
+#include "StoryPredicateProfiler.h"
+
+FDialogAssetCompiler::FDialogAssetCompiler(UDialogAsset* InAsset, FCompilerResultsLog& InLog)
+	: FQaDSAssetCompiler(InAsset, InLog), DialogAsset(InAsset)
+{
+}
+
+void FDialogAssetCompiler::BindGraph()
+{
+	auto rootNode = FindRootNode<UDialogRootEdGraphNode>();
+	if (rootNode == NULL)
+	{
+		Log.Error(TEXT("Root node not found"));
+		return;
+	}
+
+	ResetCompile(rootNode);
+	phrases.Reset();
+
+	DialogAsset->RootNode = Compile(rootNode);
+}
+
+bool FDialogAssetCompiler::BindNodes(const TArray<UQaDSEdGraphNode*>& DirtyNodes)
+{
+	auto rootNode = FindRootNode<UDialogRootEdGraphNode>();
+	if (rootNode == NULL || !rootNode->IsCompile() || rootNode->CompileNode == NULL || DialogAsset->RootNode != rootNode->CompileNode)
+		return false;
+
+	phrases.Reset();
+
+	// new children are not compiled yet and are picked up by the recursion, compiled children return their node
+	for (auto node : DirtyNodes)
+	{
+		auto dialogNode = Cast<UDialogEdGraphNode>(node);
+		if (dialogNode == NULL)
+			continue;
+
+		dialogNode->UQaDSEdGraphNode::ResetCompile();
+		Compile(dialogNode);
+	}
+
+	return true;
+}
+
+template<class TNode>
+TNode* FDialogAssetCompiler::GetCompileNode(UDialogEdGraphNode* Node)
+{
+	auto compileNode = Cast<TNode>(Node->CompileNode);
+	if (compileNode != NULL && compileNode->GetClass() == TNode::StaticClass() && compileNode->GetOuter() == DialogAsset)
+	{
+		compileNode->Childs.Reset();
+		return compileNode;
+	}
+
+	compileNode = NewObject<TNode>((UObject*)DialogAsset);
+	Node->CompileNode = compileNode;
+	return compileNode;
+}
+
+UDialogNode* FDialogAssetCompiler::Compile(UDialogEdGraphNode* node)
+{
+	if (node->IsCompile())
+		return node->CompileNode;
+
+	node->SetCompile();
+	OnNodeCompiled(node);
+
+	auto phraseNode = Cast<UDialogPhraseEdGraphNode>(node);
+	auto rootNode = Cast<UDialogRootEdGraphNode>(node);
+	auto subGraphNode = Cast<UDialogSubGraphEdGraphNode>(node);
+	auto elseIfNode = Cast<UDialogElseIfEdGraphNode>(node);
+
+	if (rootNode != NULL)
+	{
+		GetCompileNode<UDialogNode>(node);
+	}
+	else if (subGraphNode != NULL)
+	{
+		auto compileNode = GetCompileNode<UDialogSubGraphNode>(node);
+		compileNode->TargetDialogAsset = subGraphNode->TargetDialogAsset;
+	}
+	else if (elseIfNode != NULL)
+	{
+		auto compileNode = GetCompileNode<UDialogElseIfNode>(node);
+		compileNode->Conditions = elseIfNode->Conditions;
+	}
+	else if (phraseNode != NULL)
+	{
+		auto compileNode = GetCompileNode<UDialogPhraseNode>(node);
+
+		auto& data = phraseNode->Data;
+		data.UID = *node->NodeGuid.ToString();
+
+		compileNode->OwnerDialog = DialogAsset;
+
+		FString ErrorMessage;
+
+		for (auto& Event : data.Action)
+		{
+			Event.OwnerNode = compileNode;
+
+			if (!Event.Compile(ErrorMessage))
+			{
+				Error(node, ErrorMessage + "\tIn node \"" + data.Text.ToString() + "\"");
+			}
+		}
+
+		for (auto& Condition : data.Predicate)
+		{
+			Condition.OwnerNode = compileNode;
+
+			if (!Condition.Compile(ErrorMessage))
+			{
+				Error(node, ErrorMessage + "\tIn node \"" + data.Text.ToString() + "\"");
+			}
+		}
+
+		compileNode->Data = data;
+
+		phrases.Add(compileNode);
+		AddExpression(&compileNode->Data.Condition, node, data.Predicate.Num(), "\tIn node \"" + data.Text.ToString() + "\"");
+	}
+
+	auto childs = node->GetOrderedChildNodes();
+
+	bool first = true;
+	EDialogPhraseSource source = EDialogPhraseSource::NPC;
+
+	for (auto& child : childs)
+	{
+		auto childPhrase = Cast<UDialogPhraseEdGraphNode>(child);
+		auto dialogPhrase = Cast<UDialogEdGraphNode>(child);
+
+		if (childPhrase)
+		{
+			if (first)
+			{
+				source = childPhrase->Data.Source;
+				first = false;
+			}
+			else if (source != childPhrase->Data.Source)
+			{
+				Error(node, TEXT("Invalid graph: Phrase cannot simultaneously refer to phrases of different types"));
+			}
+		}
+
+		if (dialogPhrase != NULL)
+			node->CompileNode->Childs.Add(Compile(dialogPhrase));
+	}
+	
+	return node->CompileNode;
+}
+
+void FDialogAssetCompiler::OnExpressionCompiled(int32 Index, bool bIsEmpty)
+{
+	auto phrase = phrases[Index];
+	if (GetDefault<UQaDSSettings>()->bReorderPredicatesByProfile && bIsEmpty)
+		FStoryPredicateProfiler::SortPredicates(phrase->Data.Predicate, DialogAsset, phrase->Data.UID.ToString());
+}
+
+void FDialogAssetCompiler::UpdateUsage()
+{
+	auto& usage = DialogAsset->Usage;
+	usage.Reset();
+
+	TArray<UDialogNode*> stack;
+	TSet<UDialogNode*> visited;
+	stack.Add(DialogAsset->RootNode);
+
+	while (stack.Num() > 0)
+	{
+		auto node = stack.Pop(false);
+		if (node == NULL || visited.Contains(node))
+			continue;
+
+		visited.Add(node);
+		stack.Append(node->Childs);
+
+		if (auto elseIf = Cast<UDialogElseIfNode>(node))
+		{
+			for (auto& condition : elseIf->Conditions)
+			{
+				usage.CheckKeys.Append(condition.CheckHasKeys);
+				usage.CheckKeys.Append(condition.CheckDontHasKeys);
+			}
+		}
+
+		auto phrase = Cast<UDialogPhraseNode>(node);
+		if (phrase == NULL)
+			continue;
+
+		auto& data = phrase->Data;
+		usage.GiveKeys.Append(data.GiveKeys);
+		usage.CheckKeys.Append(data.CheckHasKeys);
+		usage.CheckKeys.Append(data.CheckDontHasKeys);
+		usage.CheckKeys.Append(data.Condition.Keys);
+		usage.RemoveKeys.Append(data.RemoveKeys);
+
+		if (!data.StartQuest.IsNull())
+			usage.StartQuests.Add(*data.StartQuest.ToSoftObjectPath().ToString());
+	}
+
+	usage.Normalize();
+}
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "DialogGraphSchema.h"
 #include "BrushSet.h"
 #include "QaDSGraphSchema.h"
+#include "QaDSSettings.h"
 
 #define LOCTEXT_NAMESPACE "DialogGraph"
 
@@ -75,8 +76,8 @@ void FDialogAssetEditor::BuildToolbar(FToolBarBuilder &builder)
 	builder.AddSeparator();
 	builder.AddToolBarButton(FDialogCommands::Get().Compile, NAME_None, FText::FromString("Compile"), FText::FromString("Compile this dialog"), iconCompile, NAME_None);
 	builder.AddSeparator(); 
-	//builder.AddToolBarButton(FDialogCommands::Get().Find, NAME_None, FText::FromString("Find"), FText::FromString("Open find dialog"), iconFind, NAME_None);
-	//builder.AddSeparator(); 
+	builder.AddToolBarButton(FDialogCommands::Get().Find, NAME_None, FText::FromString("Find"), FText::FromString("Open find dialog"), iconFind, NAME_None);
+	builder.AddSeparator(); 
 	builder.AddToolBarButton(FDialogCommands::Get().Export, NAME_None, FText::FromString("Export"), FText::FromString("Export graph to file"), iconImport, NAME_None);
 	builder.AddToolBarButton(FDialogCommands::Get().Import, NAME_None, FText::FromString("Import"), FText::FromString("Imoprt graph from file"), iconExport, NAME_None);
 	builder.AddSeparator();
@@ -84,17 +85,6 @@ void FDialogAssetEditor::BuildToolbar(FToolBarBuilder &builder)
 	FPlayWorldCommands::BuildToolbar(builder);
 }
 
-UDialogRootEdGraphNode* FDialogAssetEditor::GetRootNode()
-{
-	for (auto node : GraphEditor->GetCurrentGraph()->Nodes)
-	{
-		if (auto root = Cast<UDialogRootEdGraphNode>(node))
-			return root;
-	}
-
-	return NULL;
-}
-
 UEdGraph* FDialogAssetEditor::CreateGraphFromAsset()
 {
 	auto CustGraph = NewObject<UEdGraph>(EditedAsset, UEdGraph::StaticClass(), NAME_None, RF_Transactional);
@@ -106,114 +96,4 @@ UEdGraph* FDialogAssetEditor::CreateGraphFromAsset()
 	return CustGraph;
 }
 
-void FDialogAssetEditor::Compile()
-{
-	auto rootNode = GetRootNode();
-	if (rootNode == NULL)
-	{		
-		CompileLogResults.Error(TEXT("Root node not found"));
-		return;
-	}
-
-	ResetCompilePhrase(rootNode);
-	EditedAsset->RootNode = Compile(rootNode);
-}
-
-UDialogNode* FDialogAssetEditor::Compile(UDialogEdGraphNode* node)
-{
-	if (node->IsCompile())
-		return node->CompileNode;
-
-	node->SetCompile();
-
-	auto phraseNode = Cast<UDialogPhraseEdGraphNode>(node);
-	auto rootNode = Cast<UDialogRootEdGraphNode>(node);
-	auto subGraphNode = Cast<UDialogSubGraphEdGraphNode>(node);
-	auto elseIfNode = Cast<UDialogElseIfEdGraphNode>(node);
-
-	if (rootNode != NULL)
-	{
-		auto compileNode = NewObject<UDialogNode>((UObject*)EditedAsset);
-		node->CompileNode = compileNode;
-	}
-	else if (subGraphNode != NULL)
-	{
-		auto compileNode = NewObject<UDialogSubGraphNode>((UObject*)EditedAsset);
-		compileNode->TargetDialogAsset = subGraphNode->TargetDialogAsset;
-		node->CompileNode = compileNode;
-	}
-	else if (elseIfNode != NULL)
-	{
-		auto compileNode = NewObject<UDialogElseIfNode>((UObject*)EditedAsset);
-		compileNode->Conditions = elseIfNode->Conditions;
-		node->CompileNode = compileNode;
-	}
-	else if (phraseNode != NULL)
-	{
-		auto compileNode = NewObject<UDialogPhraseNode>((UObject*)EditedAsset);
-		node->CompileNode = compileNode;
-
-		auto& data = phraseNode->Data;
-		data.UID = *node->NodeGuid.ToString();
-
-		compileNode->OwnerDialog = Cast<UDialogAsset>(EditedAsset);
-		compileNode->Data = data;
-
-		FString ErrorMessage;
-
-		for (auto& Event : data.Action)
-		{
-			Event.OwnerNode = compileNode;
-
-			if (!Event.Compile(ErrorMessage))
-			{
-				CompileLogResults.Error(*(ErrorMessage + "\tIn node \"" + data.Text.ToString() + "\""));
-			}
-		}
-
-		for (auto& Condition : data.Predicate)
-		{
-			Condition.OwnerNode = compileNode;
-
-			if (!Condition.Compile(ErrorMessage))
-			{
-				CompileLogResults.Error(*(ErrorMessage + "\tIn node \"" + data.Text.ToString() + "\""));
-			}
-		}
-	}
-
-	auto childs = node->GetChildNodes();
-	childs.Sort([](auto& a, auto& b)
-	{
-		return a.GetOrder() < b.GetOrder();
-	});
-
-	bool first = true;
-	EDialogPhraseSource source = EDialogPhraseSource::NPC;
-
-	for (auto& child : childs)
-	{
-		auto childPhrase = Cast<UDialogPhraseEdGraphNode>(child);
-		auto dialogPhrase = Cast<UDialogEdGraphNode>(child);
-
-		if (childPhrase)
-		{
-			if (first)
-			{
-				source = childPhrase->Data.Source;
-				first = false;
-			}
-			else if (source != childPhrase->Data.Source)
-			{
-				CompileLogResults.Error(TEXT("Invalid graph: Phrase cannot simultaneously refer to phrases of different types"));
-			}
-		}
-
-		if (dialogPhrase != NULL)
-			node->CompileNode->Childs.Add(Compile(dialogPhrase));
-	}
-	
-	return node->CompileNode;
-}
-
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
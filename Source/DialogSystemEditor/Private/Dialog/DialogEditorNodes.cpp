@@ -49,11 +49,12 @@ FXmlWriteNode UDialogPhraseEdGraphNode::SaveToXml() const
 	node.Append("check_dont_has_keys", Data.CheckDontHasKeys);
 	node.Append("actions", Data.Action);
 	node.Append("predicates", Data.Predicate);
+	node.Append("condition", Data.Condition.Expression);
 	
 	return node;
 }
 
-void UDialogPhraseEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById)
+void UDialogPhraseEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById)
 {
 	Super::LoadInXml(reader, nodeById);
 
@@ -68,6 +69,7 @@ void UDialogPhraseEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FStrin
 	reader->TryGet("check_dont_has_keys", Data.CheckDontHasKeys);
 	reader->TryGet("give_actionskeys", Data.Action);
 	reader->TryGet("predicates", Data.Predicate);
+	reader->TryGet("condition", Data.Condition.Expression);
 
 	Data.AutoTime = Data.PhraseManualTime > 0;
 	Data.StartQuest = TAssetPtr<UQuestAsset>(reader->Get("quest"));
@@ -93,7 +95,7 @@ FXmlWriteNode UDialogSubGraphEdGraphNode::SaveToXml() const
 	return node;
 }
 
-void UDialogSubGraphEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById)
+void UDialogSubGraphEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById)
 {
 	Super::LoadInXml(reader, nodeById);
 	TargetDialogAsset = TAssetPtr<UDialogAsset>(reader->Get("asset"));
@@ -122,7 +124,7 @@ FXmlWriteNode UDialogElseIfEdGraphNode::SaveToXml() const
 	return node;
 }
 
-void UDialogElseIfEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById)
+void UDialogElseIfEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById)
 {
 }
 
@@ -151,7 +153,7 @@ FXmlWriteNode UDialogRootEdGraphNode::SaveToXml() const
 	return node;
 }
 
-void UDialogRootEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById)
+void UDialogRootEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById)
 {
 	Super::LoadInXml(reader, nodeById);
 }
@@ -200,10 +202,12 @@ void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<FDialogPhraseCondition
 {
 	node << FXmlWriteTuple<FDialogPhraseEvent>(tuple.Tag, tuple.Value);
 	node.Childrens.Last().Append("invert", tuple.Value.InvertCondition);
+	node.Childrens.Last().Append("pure", tuple.Value.bIsPure);
 }
 
 void operator>>(const FXmlReadNode& node, FDialogPhraseCondition& value)
 {
 	node >> (FDialogPhraseEvent&)value;
 	node.TryGet("invert", value.InvertCondition);
+	node.TryGet("pure", value.bIsPure);
 }
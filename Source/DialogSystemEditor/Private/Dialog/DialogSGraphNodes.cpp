@@ -33,36 +33,57 @@ FName SGraphNode_Phrase::GetIcon() const
 	}
 }
 
-void SGraphNode_Phrase::CreateNodeWidget()
+void SGraphNode_Phrase::CreateDetailGroups()
 {
 	auto phraseNode = CastChecked<UDialogPhraseEdGraphNode>(GraphNode);
-	auto& data = phraseNode->Data;
 
-	SGraphNode_QaDSNodeBase::CreateNodeWidget();
-	
-	for (auto key : data.CheckHasKeys)
-		AddTextToContent(ConditionsBox, TEXT(""), key.ToString(), FColor(170, 255, 0));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, CheckHasKeys), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : phraseNode->Data.CheckHasKeys)
+			AddTextToContent(Box, TEXT(""), key.ToString(), FColor(170, 255, 0));
+	});
 
-	for (auto key : data.CheckDontHasKeys)
-		AddTextToContent(ConditionsBox, TEXT("!"), key.ToString(), FColor(255, 150, 0));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, CheckDontHasKeys), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : phraseNode->Data.CheckDontHasKeys)
+			AddTextToContent(Box, TEXT("!"), key.ToString(), FColor(255, 150, 0));
+	});
 
-	for (auto key : data.Predicate)
-		AddTextToContent(ConditionsBox, TEXT("IF"), key.ToString(), FColor(255, 255, 0));
-	
-	if(!data.StartQuest.ToSoftObjectPath().IsNull())
-		AddTextToContent(EventsBox, TEXT("Start Quest "), data.StartQuest.GetAssetName(), FColor(255, 0, 255));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, Predicate), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : phraseNode->Data.Predicate)
+			AddTextToContent(Box, TEXT("IF"), key.ToString(), FColor(255, 255, 0));
+	});
 
-	for (auto key : data.Action)
-		AddTextToContent(EventsBox, TEXT(""), key.ToString(), FColor(0, 170, 255));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, Condition), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		if (!phraseNode->Data.Condition.Expression.IsEmpty())
+			AddTextToContent(Box, TEXT("IF"), phraseNode->Data.Condition.Expression, FColor(255, 255, 0));
+	});
 
-	for (auto key : data.GiveKeys)
-		AddTextToContent(EventsBox, TEXT("+"), key.ToString(), FColor(0, 255, 0));
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, StartQuest), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		if (!phraseNode->Data.StartQuest.ToSoftObjectPath().IsNull())
+			AddTextToContent(Box, TEXT("Start Quest "), phraseNode->Data.StartQuest.GetAssetName(), FColor(255, 0, 255));
+	});
 
-	for (auto key : data.RemoveKeys)
-		AddTextToContent(EventsBox, TEXT("-"), key.ToString(), FColor(255, 0, 0));
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, Action), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : phraseNode->Data.Action)
+			AddTextToContent(Box, TEXT(""), key.ToString(), FColor(0, 170, 255));
+	});
+
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, GiveKeys), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : phraseNode->Data.GiveKeys)
+			AddTextToContent(Box, TEXT("+"), key.ToString(), FColor(0, 255, 0));
+	});
 
-	ConditionsBox->SetVisibility(ConditionsBox->NumSlots() > 0 ? EVisibility::Visible : EVisibility::Collapsed);
-	EventsBox->SetVisibility(EventsBox->NumSlots() > 0 ? EVisibility::Visible : EVisibility::Collapsed);
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FDialogPhraseInfo, RemoveKeys), [this, phraseNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : phraseNode->Data.RemoveKeys)
+			AddTextToContent(Box, TEXT("-"), key.ToString(), FColor(255, 0, 0));
+	});
 }
 
 FReply SGraphNode_Phrase::OnClickedIcon()
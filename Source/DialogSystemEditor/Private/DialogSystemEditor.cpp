@@ -5,9 +5,13 @@
 #include "Editor/WorkspaceMenuStructure/Public/WorkspaceMenuStructureModule.h"
 #include "ISettingsModule.h"
 #include "ThumbnailRendering/ThumbnailManager.h"
+#include "EditorStyleSet.h"
 #include "BrushSet.h"
 
 #include "StoryKeyWindow.h"
+#include "PredicateProfileWindow.h"
+#include "QaDSSearchWindow.h"
+#include "QaDSSearchIndex.h"
 #include "QaDSSettings.h"
 
 #include "DialogEditorNodeFactory.h"
@@ -63,6 +67,15 @@ void FDialogSystemEditorModule::StartupModule()
 		.SetIcon(FSlateIcon("DialogSystem", "DialogSystem.StoryKeyIcon_16"));
 
 	SpawnerEntry.SetGroup(developerCategory);
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner("PredicateProfileWindow", FOnSpawnTab::CreateRaw(this, &FDialogSystemEditorModule::SpawnPredicateProfileTab))
+		.SetDisplayName(LOCTEXT("PredicateProfile", "Story Predicate Profile"))
+		.SetGroup(developerCategory);
+
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner("QaDSSearchWindow", FOnSpawnTab::CreateRaw(this, &FDialogSystemEditorModule::SpawnSearchTab))
+		.SetDisplayName(LOCTEXT("QaDSSearch", "Dialog and Quest Search"))
+		.SetIcon(FSlateIcon(FEditorStyle::GetStyleSetName(), "Kismet.Tabs.FindResults"))
+		.SetGroup(developerCategory);
 }
 
 
@@ -70,6 +83,7 @@ void FDialogSystemEditorModule::ShutdownModule()
 {
 	FDialogCommands::Unregister();
 	FBrushSet::Unregister();
+	FQaDSSearchIndex::Shutdown();
 
 	if (FModuleManager::Get().IsModuleLoaded("Settings"))
 	{
@@ -107,6 +121,26 @@ TSharedRef<SDockTab> FDialogSystemEditorModule::SpawnStoryKeyTab(const FSpawnTab
 	return tab;
 }
 
+TSharedRef<SDockTab> FDialogSystemEditorModule::SpawnPredicateProfileTab(const FSpawnTabArgs&)
+{
+	TSharedRef<SDockTab> tab = SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab);
+
+	tab->SetContent(SNew(SPredicateProfileWindow));
+
+	return tab;
+}
+
+TSharedRef<SDockTab> FDialogSystemEditorModule::SpawnSearchTab(const FSpawnTabArgs&)
+{
+	TSharedRef<SDockTab> tab = SNew(SDockTab)
+		.TabRole(ETabRole::NomadTab);
+
+	tab->SetContent(SNew(SQaDSSearchWindow));
+
+	return tab;
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FDialogSystemEditorModule, DialogSystemEditor)
\ No newline at end of file
@@ -0,0 +1,172 @@
+#include "DialogSystemEditor.h"
+#include "PredicateProfileWindow.h"
+
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SOverlay.h"
+#include "Styling/CoreStyle.h"
+#include "SlateOptMacros.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Input/SButton.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+
+class SPredicateProfileRow : public SMultiColumnTableRow<FPredicateProfileItemPtr>
+{
+	FPredicateProfileItemPtr item;
+
+public:
+	SLATE_BEGIN_ARGS(SPredicateProfileRow){}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, FPredicateProfileItemPtr Item)
+	{
+		item = Item;
+		SMultiColumnTableRow<FPredicateProfileItemPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FString text;
+		auto& stats = item->Stats;
+
+		if (ColumnName == "Predicate")
+			text = item->Id;
+		else if (ColumnName == "Calls")
+			text = FString::Printf(TEXT("%lld"), stats.Calls);
+		else if (ColumnName == "True")
+			text = FString::Printf(TEXT("%.1f%%"), stats.GetTrueRate() * 100);
+		else if (ColumnName == "Time")
+			text = FString::Printf(TEXT("%.2f us"), stats.GetAverageTime() * 1000000);
+		else if (ColumnName == "Rank")
+			text = FString::Printf(TEXT("%.2f"), stats.GetRank() * 1000000);
+
+		return SNew(STextBlock).Text(FText::FromString(text)).ToolTipText(FText::FromString(item->Id));
+	}
+};
+
+BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
+void SPredicateProfileWindow::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FCoreStyle::Get().GetBrush("ToolPanel.GroupBorder"))
+		[
+			SNew(SOverlay)
+
+			+ SOverlay::Slot()
+			.Padding(4.0f, 2.0f, 4.0f, 2.0f)
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+					+ SHorizontalBox::Slot()
+					.FillWidth(1.0f)
+					[
+						SAssignNew(searchBox, SSearchBox)
+						.OnTextChanged(this, &SPredicateProfileWindow::HandleSearch)
+					]
+					+ SHorizontalBox::Slot()
+					.Padding(4.0f, 0.0f, 0.0f, 0.0f)
+					.AutoWidth()
+					[
+						SNew(SButton)
+						.Text(FText::FromString("Reload"))
+						.OnClicked(this, &SPredicateProfileWindow::HandleReloadButton)
+					]
+					+ SHorizontalBox::Slot()
+					.AutoWidth()
+					[
+						SNew(SButton)
+						.Text(FText::FromString("Reset"))
+						.OnClicked(this, &SPredicateProfileWindow::HandleResetButton)
+					]
+				]
+				+ SVerticalBox::Slot()
+				.Padding(0.0f, 4.0f, 0.0f, 4.0f)
+				[
+					SAssignNew(itemListView, SListView<FPredicateProfileItemPtr>)
+					.ItemHeight(16.0f)
+					.ListItemsSource(&items)
+					.OnGenerateRow(this, &SPredicateProfileWindow::HandleGenerateRow)
+					.SelectionMode(ESelectionMode::Single)
+					.HeaderRow
+					(
+						SNew(SHeaderRow)
+						+ SHeaderRow::Column("Predicate").DefaultLabel(FText::FromString("Predicate")).FillWidth(6.0f)
+						+ SHeaderRow::Column("Calls").DefaultLabel(FText::FromString("Calls")).FillWidth(1.0f)
+						+ SHeaderRow::Column("True").DefaultLabel(FText::FromString("True")).FillWidth(1.0f)
+						+ SHeaderRow::Column("Time").DefaultLabel(FText::FromString("Avg time")).FillWidth(1.0f)
+						+ SHeaderRow::Column("Rank").DefaultLabel(FText::FromString("Rank")).FillWidth(1.0f)
+					)
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString("Set QaDS.ProfilePredicates 1 and play. Rank is the expected cost per rejection, lower runs first when reordering is enabled."))
+					.AutoWrapText(true)
+				]
+			]
+		]
+	];
+
+	UpdateItems();
+}
+END_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+TSharedRef<ITableRow> SPredicateProfileWindow::HandleGenerateRow(FPredicateProfileItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SPredicateProfileRow, OwnerTable, Item);
+}
+
+void SPredicateProfileWindow::UpdateItems()
+{
+	items.Reset();
+
+	auto filter = searchBox->GetText().ToString();
+
+	for (auto& kpv : FStoryPredicateProfiler::GetStats())
+	{
+		if (filter.IsEmpty() || kpv.Key.Contains(filter))
+		{
+			auto item = MakeShared<FPredicateProfileItem>();
+			item->Id = kpv.Key;
+			item->Stats = kpv.Value;
+			items.Add(item);
+		}
+	}
+
+	items.Sort([](const FPredicateProfileItemPtr& a, const FPredicateProfileItemPtr& b)
+	{
+		return a->Stats.Seconds > b->Stats.Seconds;
+	});
+
+	itemListView->RequestListRefresh();
+}
+
+FReply SPredicateProfileWindow::HandleReloadButton()
+{
+	FStoryPredicateProfiler::Load();
+	UpdateItems();
+
+	return FReply::Handled();
+}
+
+FReply SPredicateProfileWindow::HandleResetButton()
+{
+	FStoryPredicateProfiler::Reset();
+	FStoryPredicateProfiler::Save();
+	UpdateItems();
+
+	return FReply::Handled();
+}
+
+void SPredicateProfileWindow::HandleSearch(const FText& Text)
+{
+	UpdateItems();
+}
\ No newline at end of file
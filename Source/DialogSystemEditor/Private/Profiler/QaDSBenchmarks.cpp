@@ -0,0 +1,691 @@
+#include "DialogSystemEditor.h"
+#include "DialogSystemRuntime.h"
+#include "QuestStageMaskTable.h"
+#include "StoryContext.h"
+#include "StoryInformationManager.h"
+#include "StoryInbox.h"
+#include "StoryNativeRegistry.h"
+#include "XmlSerealizeHelper.h"
+#include "XmlFile.h"
+#include "QaDSGraphOrderCache.h"
+#include "QaDSEdGraphNode.h"
+#include "DialogEditorNodes.h"
+#include "DialogGraphSchema.h"
+#include "RectConnectionDrawingPolicy.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+#include "Rendering/DrawElements.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Async/Async.h"
+#include "Containers/Queue.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/OutputDeviceNull.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectHash.h"
+
+/*
+	Console benchmarks comparing the optimized story and editor paths with the previous ones,
+	results are written to the log. Editor only, nothing here ships with the game.
+*/
+
+/* Story contexts */
+
+static uint64 GetStoryContextMemory(UStoryContext* Context)
+{
+	TArray<UObject*> objects;
+	GetObjectsWithOuter(Context, objects, true);
+	objects.Add(Context);
+
+	uint64 bytes = 0;
+	for (auto object : objects)
+	{
+		FResourceSizeEx size(EResourceSizeMode::Exclusive);
+		object->GetResourceSizeEx(size);
+
+		bytes += object->GetClass()->GetStructureSize() + size.GetTotalMemoryBytes();
+	}
+
+	return bytes;
+}
+
+// QaDS.BenchmarkContexts [keys] - story state memory of 1 to 64 simulated players with own contexts
+static void BenchmarkContexts(const TArray<FString>& Args)
+{
+	auto numKeys = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 500;
+
+	TArray<UStoryContext*> contexts;
+	auto startTime = FPlatformTime::Seconds();
+
+	for (auto numPlayers = 1; numPlayers <= 64; numPlayers *= 2)
+	{
+		while (contexts.Num() < numPlayers)
+		{
+			// half of the keys are shared by all players
+			TSet<FName> keys;
+			for (auto i = 0; i < numKeys; i++)
+				keys.Add(*FString::Printf(TEXT("BenchmarkKey_%d"), i % 2 == 0 ? i : i + contexts.Num() * numKeys));
+
+			auto context = UStoryContext::CreateStoryContext(GetTransientPackage());
+			context->AddToRoot();
+			context->StoryKeyManager->SetKeys(keys);
+
+			contexts.Add(context);
+		}
+
+		uint64 bytes = 0;
+		for (auto context : contexts)
+			bytes += GetStoryContextMemory(context);
+
+		UE_LOG(DialogModuleLog, Display, TEXT("Story contexts, %d players with %d keys: %llu KB, %llu bytes per player"),
+			numPlayers, numKeys, bytes / 1024, bytes / numPlayers);
+	}
+
+	UE_LOG(DialogModuleLog, Display, TEXT("Story contexts created in %.1f ms"), (FPlatformTime::Seconds() - startTime) * 1000);
+
+	for (auto context : contexts)
+	{
+		context->RemoveFromRoot();
+		context->MarkPendingKill();
+	}
+}
+
+static FAutoConsoleCommand BenchmarkContextsCommand(
+	TEXT("QaDS.BenchmarkContexts"),
+	TEXT("Create story contexts for 1 to 64 simulated players (500 keys each or the given count) and log their memory"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkContexts));
+
+/* Key inbox */
+
+struct FBenchmarkPost
+{
+	FName Key;
+	bool bAdd;
+};
+
+// producers post on own threads while the game thread drains, returns seconds until everything is drained
+template<typename PostFuncType, typename DrainFuncType>
+static double RunInboxContention(int32 NumProducers, int32 NumPosts, PostFuncType Post, DrainFuncType Drain)
+{
+	TArray<TFuture<void>> producers;
+	auto startTime = FPlatformTime::Seconds();
+
+	for (auto p = 0; p < NumProducers; p++)
+	{
+		producers.Add(Async<void>(EAsyncExecution::Thread, [&Post, NumPosts, p]()
+		{
+			FBenchmarkPost post = { FName(TEXT("BenchmarkKey"), p), true };
+			for (auto i = 0; i < NumPosts; i++)
+				Post(post);
+		}));
+	}
+
+	auto total = NumProducers * NumPosts;
+	auto drained = 0;
+
+	while (drained < total)
+	{
+		auto count = Drain();
+		if (count == 0)
+			FPlatformProcess::Yield();
+
+		drained += count;
+	}
+
+	for (auto& producer : producers)
+		producer.Wait();
+
+	return FPlatformTime::Seconds() - startTime;
+}
+
+// QaDS.BenchmarkKeyInbox [posts] [producers] - concurrent key posts through the node per post queue against the preallocated ring
+static void BenchmarkKeyInbox(const TArray<FString>& Args)
+{
+	auto numPosts = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+	auto numProducers = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 8;
+
+	auto queue = MakeUnique<TQueue<FBenchmarkPost, EQueueMode::Mpsc>>();
+	auto queueTime = RunInboxContention(numProducers, numPosts,
+		[&queue](const FBenchmarkPost& Post) { queue->Enqueue(Post); },
+		[&queue]()
+		{
+			auto count = 0;
+			FBenchmarkPost post;
+			while (queue->Dequeue(post))
+				count++;
+			return count;
+		});
+
+	auto inbox = MakeUnique<TStoryInbox<FBenchmarkPost, 256>>();
+	auto inboxTime = RunInboxContention(numProducers, numPosts,
+		[&inbox](const FBenchmarkPost& Post) { inbox->Enqueue(Post); },
+		[&inbox]() { return inbox->Drain([](const FBenchmarkPost&) {}); });
+
+	auto total = (double)numPosts * numProducers;
+
+	UE_LOG(DialogModuleLog, Display, TEXT("Key inbox, %d producers x %d posts: queue %.1f ms (%.1f ns/post), ring %.1f ms (%.1f ns/post)"),
+		numProducers, numPosts, queueTime * 1000, queueTime * 1e9 / total, inboxTime * 1000, inboxTime * 1e9 / total);
+}
+
+static FAutoConsoleCommand BenchmarkKeyInboxCommand(
+	TEXT("QaDS.BenchmarkKeyInbox"),
+	TEXT("Post keys from 8 threads (100000 posts each or the given counts) while the game thread drains, TQueue against the story inbox ring"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkKeyInbox));
+
+/* Quest stage masks */
+
+// QaDS.BenchmarkStageMasks [stages] - compares the sweep with per-stage key lookups
+static void BenchmarkStageMasks(const TArray<FString>& Args)
+{
+	const int32 numKeys = 512;
+	const int32 iterations = 100;
+
+	TArray<int32> counts;
+	if (Args.Num() > 0)
+		counts.Add(FCString::Atoi(*Args[0]));
+	else
+		counts = { 1000, 10000 };
+
+	FRandomStream random(1234);
+
+	TArray<FName> keyNames;
+	TSet<FName> keySet;
+	TArray<uint32> keyWords, changedWords;
+	keyWords.AddZeroed(Align(numKeys / 32, 4));
+	changedWords.AddZeroed(keyWords.Num());
+
+	for (auto i = 0; i < numKeys; i++)
+	{
+		keyNames.Add(*FString::Printf(TEXT("BenchmarkKey_%d"), i));
+
+		if (random.FRand() < 0.5f)
+		{
+			keySet.Add(keyNames[i]);
+			keyWords[i / 32] |= 1u << (i % 32);
+		}
+	}
+
+	for (auto count : counts)
+	{
+		FQuestStageMaskTable table;
+		TArray<FQuestStageMaskRow> rows;
+
+		for (auto i = 0; i < count; i++)
+		{
+			FQuestStageMaskRow row;
+			row.WaitHas = { random.RandRange(0, numKeys - 1), random.RandRange(0, numKeys - 1) };
+			row.WaitDontHas = { random.RandRange(0, numKeys - 1) };
+			row.FailedIfGive = { random.RandRange(0, numKeys - 1) };
+
+			table.Add(NULL, row);
+			rows.Add(row);
+		}
+
+		auto changedKey = random.RandRange(0, numKeys - 1);
+		changedWords[changedKey / 32] = 1u << (changedKey % 32);
+
+		// per-stage loop as done by key change delegates: contains check then full key check
+		int32 loopCandidates = 0;
+		auto startTime = FPlatformTime::Seconds();
+		for (auto it = 0; it < iterations; it++)
+		{
+			loopCandidates = 0;
+			auto key = keyNames[changedKey];
+
+			for (auto& row : rows)
+			{
+				auto contains = [&](const TArray<int32>& ids)
+				{
+					for (auto id : ids)
+					{
+						if (keyNames[id] == key)
+							return true;
+					}
+					return false;
+				};
+
+				if (!contains(row.WaitHas) && !contains(row.WaitDontHas) && !contains(row.FailedIfGive))
+					continue;
+
+				auto blocked = false;
+				for (auto id : row.WaitHas)
+					blocked |= !keySet.Contains(keyNames[id]);
+				for (auto id : row.WaitDontHas)
+					blocked |= keySet.Contains(keyNames[id]);
+
+				auto failed = false;
+				for (auto id : row.FailedIfGive)
+					failed |= keySet.Contains(keyNames[id]);
+
+				loopCandidates += !blocked || failed;
+			}
+		}
+		auto loopTime = FPlatformTime::Seconds() - startTime;
+
+		TArray<UQuestRuntimeNode*> candidates;
+		startTime = FPlatformTime::Seconds();
+		for (auto it = 0; it < iterations; it++)
+		{
+			candidates.Reset();
+			table.SweepScalar(keyWords.GetData(), changedWords.GetData(), candidates);
+		}
+		auto scalarTime = FPlatformTime::Seconds() - startTime;
+
+		startTime = FPlatformTime::Seconds();
+		for (auto it = 0; it < iterations; it++)
+		{
+			candidates.Reset();
+			table.Sweep(keyWords.GetData(), changedWords.GetData(), candidates);
+		}
+		auto vectorTime = FPlatformTime::Seconds() - startTime;
+
+		changedWords[changedKey / 32] = 0;
+
+		UE_LOG(DialogModuleLog, Display, TEXT("Stage masks, %d stages x %d keys: per-stage loop %.3f us, scalar sweep %.3f us, vector sweep %.3f us (%d / %d candidates)"),
+			count, numKeys,
+			loopTime * 1000000 / iterations,
+			scalarTime * 1000000 / iterations,
+			vectorTime * 1000000 / iterations,
+			loopCandidates, candidates.Num());
+	}
+}
+
+static FAutoConsoleCommand BenchmarkStageMasksCommand(
+	TEXT("QaDS.BenchmarkStageMasks"),
+	TEXT("Compare the quest stage mask sweep with per-stage key checks for 1k and 10k stages, or the given count"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkStageMasks));
+
+/* Xml */
+
+static FXmlWriteNode MakeBenchmarkNode(int32 Index, int32 NumNodes)
+{
+	auto node = FXmlWriteNode("node");
+
+	node.Append("id", FGuid(Index, 0, 0, 1).ToString());
+	node.Append("class", FName("DialogPhraseEdGraphNode"));
+	node.Append("x", Index * 40);
+	node.Append("y", Index % 100 * 20);
+	node.Append("text", FString::Printf(TEXT("Phrase %d with \"quoted\" <markup> & some longer text to export"), Index));
+	node.Append("source", Index % 2);
+
+	TArray<FName> keys = { "Benchmark_KeyA", "Benchmark_KeyB" };
+	node.Append("give_keys", keys);
+	node.Append("check_has_keys", keys);
+
+	TArray<FString> links = { FGuid((Index + 1) % NumNodes, 0, 0, 1).ToString(), FGuid((Index + 2) % NumNodes, 0, 0, 1).ToString() };
+	node.Append("links", links);
+
+	return node;
+}
+
+// QaDS.BenchmarkXmlExport [nodes] - full document string against streaming to a file
+static void BenchmarkXmlExport(const TArray<FString>& Args)
+{
+	auto numNodes = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+	auto filePath = FPaths::ProjectSavedDir() / TEXT("QaDS") / TEXT("ExportBenchmark.xml");
+
+	auto startTime = FPlatformTime::Seconds();
+	FXmlWriteNode nodes("nodes");
+
+	for (auto i = 0; i < numNodes; i++)
+		nodes.Childrens.Add(MakeBenchmarkNode(i, numNodes));
+
+	auto xml = nodes.GetXml();
+	FFileHelper::SaveStringToFile(xml, *filePath);
+
+	auto documentTime = FPlatformTime::Seconds() - startTime;
+	auto documentBytes = xml.GetAllocatedSize();
+
+	startTime = FPlatformTime::Seconds();
+	int32 streamBytes = 0;
+
+	{
+		TUniquePtr<FArchive> file(IFileManager::Get().CreateFileWriter(*filePath));
+		if (!file.IsValid())
+		{
+			UE_LOG(DialogModuleLog, Error, TEXT("Failed open %s"), *filePath);
+			return;
+		}
+
+		FXmlStreamWriter writer(file.Get());
+		writer.WriteHeader();
+		writer.BeginElement("nodes");
+
+		for (auto i = 0; i < numNodes; i++)
+			writer.WriteNode(MakeBenchmarkNode(i, numNodes));
+
+		writer.EndElement();
+		streamBytes = writer.GetBuffer().GetAllocatedSize();
+	}
+
+	auto streamTime = FPlatformTime::Seconds() - startTime;
+
+	UE_LOG(DialogModuleLog, Display, TEXT("Xml export of %d nodes: document %.1f ms (%d KB string, whole tree kept), stream %.1f ms (%d KB buffer, one node kept)"),
+		numNodes, documentTime * 1000, documentBytes / 1024, streamTime * 1000, streamBytes / 1024);
+}
+
+static FAutoConsoleCommand BenchmarkXmlExportCommand(
+	TEXT("QaDS.BenchmarkXmlExport"),
+	TEXT("Export a generated graph (10k nodes or the given count) as one xml string and with the stream writer, and log time and memory"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkXmlExport));
+
+// QaDS.BenchmarkXmlImport [nodes] - DOM with child search against the one pass import document
+static void BenchmarkXmlImport(const TArray<FString>& Args)
+{
+	auto numNodes = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10000;
+	auto filePath = FPaths::ProjectSavedDir() / TEXT("QaDS") / TEXT("ImportBenchmark.xml");
+
+	{
+		TUniquePtr<FArchive> file(IFileManager::Get().CreateFileWriter(*filePath));
+		if (!file.IsValid())
+		{
+			UE_LOG(DialogModuleLog, Error, TEXT("Failed open %s"), *filePath);
+			return;
+		}
+
+		FXmlStreamWriter writer(file.Get());
+		writer.WriteHeader();
+		writer.BeginElement("nodes");
+
+		for (auto i = 0; i < numNodes; i++)
+			writer.WriteNode(MakeBenchmarkNode(i, numNodes));
+
+		writer.EndElement();
+	}
+
+	auto startTime = FPlatformTime::Seconds();
+	auto domLinks = 0;
+
+	{
+		FXmlFile dom(filePath);
+		TMap<FString, int32> nodesById;
+
+		for (auto node : dom.GetRootNode()->GetChildrenNodes())
+			nodesById.Add(node->FindChildNode("id")->GetContent(), nodesById.Num());
+
+		for (auto node : dom.GetRootNode()->GetChildrenNodes())
+		{
+			node->FindChildNode("text");
+			node->FindChildNode("give_keys");
+
+			auto links = node->FindChildNode("links");
+			for (auto link : links->GetChildrenNodes())
+				domLinks += nodesById.Contains(link->GetContent());
+		}
+	}
+
+	auto domTime = FPlatformTime::Seconds() - startTime;
+
+	startTime = FPlatformTime::Seconds();
+	auto importLinks = 0;
+
+	{
+		FXmlImportDocument document;
+		TArray<int32> nodes;
+		TMap<FGuid, int32> nodesById;
+
+		document.OnRootChild = [&](int32 Element)
+		{
+			FGuid id;
+			FGuid::Parse(FXmlReadNode(&document, Element).Get("id"), id);
+
+			nodesById.Add(id, nodes.Add(Element));
+		};
+
+		FText errorMessage;
+		int32 errorLine;
+		document.LoadFile(filePath, false, errorMessage, errorLine);
+
+		for (auto element : nodes)
+		{
+			FXmlReadNode reader(&document, element);
+			reader.Get("text");
+			reader.Get<TArray<FName>>("give_keys");
+
+			for (auto& link : reader.Get<TArray<FString>>("links"))
+			{
+				FGuid id;
+				importLinks += FGuid::Parse(link, id) && nodesById.Contains(id);
+			}
+		}
+	}
+
+	auto importTime = FPlatformTime::Seconds() - startTime;
+
+	UE_LOG(DialogModuleLog, Display, TEXT("Xml import of %d nodes: DOM %.1f ms (%d links), one pass %.1f ms (%d links)"),
+		numNodes, domTime * 1000, domLinks, importTime * 1000, importLinks);
+}
+
+static FAutoConsoleCommand BenchmarkXmlImportCommand(
+	TEXT("QaDS.BenchmarkXmlImport"),
+	TEXT("Import a generated graph (10k nodes or the given count) with the DOM reader and the one pass reader, and log the time"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkXmlImport));
+
+/* Graph order */
+
+// previous per call order, kept to compare against the cache
+static int32 GetOrderUncached(const UQaDSEdGraphNode* Node)
+{
+	auto inputPin = Node->Pins.FindByPredicate([](const UEdGraphPin* pin) { return pin->Direction == EGPD_Input; });
+
+	if (inputPin == NULL || (*inputPin)->LinkedTo.Num() == 0)
+		return 0;
+
+	auto bigOwner = (UQaDSEdGraphNode*)(*inputPin)->LinkedTo[0]->GetOwningNode();
+	for (auto ownerPin : (*inputPin)->LinkedTo)
+	{
+		auto owner = (UQaDSEdGraphNode*)ownerPin->GetOwningNode();
+
+		if (owner != NULL && owner->GetChildNodes().Num() > bigOwner->GetChildNodes().Num())
+			bigOwner = owner;
+	}
+
+	auto lessCount = 0;
+	for (auto node : bigOwner->GetChildNodes())
+	{
+		if (node->NodePosX < Node->NodePosX)
+			lessCount++;
+	}
+
+	return lessCount + 1;
+}
+
+// QaDS.BenchmarkGraphOrder [nodes] [children] - order of every node for one editor frame, per call against cached
+static void BenchmarkGraphOrder(const TArray<FString>& Args)
+{
+	auto numNodes = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 2000;
+	auto numChildren = FMath::Max(Args.Num() > 1 ? FCString::Atoi(*Args[1]) : 20, 1);
+
+	auto graph = NewObject<UEdGraph>(GetTransientPackage());
+	graph->Schema = UDialogGraphSchema::StaticClass();
+
+	TArray<UQaDSEdGraphNode*> nodes;
+	for (int i = 0; i < numNodes; i++)
+	{
+		auto node = NewObject<UDialogPhraseEdGraphNode>(graph);
+		node->CreateNewGuid();
+		node->AllocateDefaultPins();
+		node->NodePosX = (i % numChildren) * 300;
+		node->NodePosY = (i / numChildren) * 200;
+		graph->AddNode(node, false, false);
+		nodes.Add(node);
+
+		if (i == 0)
+			continue;
+
+		auto parent = nodes[(i - 1) / numChildren];
+		auto outputPin = parent->Pins.FindByPredicate([](UEdGraphPin* pin) { return pin->Direction == EGPD_Output; });
+		auto inputPin = node->Pins.FindByPredicate([](UEdGraphPin* pin) { return pin->Direction == EGPD_Input; });
+
+		if (outputPin != NULL && inputPin != NULL)
+			(*outputPin)->MakeLinkTo(*inputPin);
+	}
+
+	int64 uncachedSum = 0;
+	int64 rebuildSum = 0;
+	int64 cachedSum = 0;
+
+	auto startTime = FPlatformTime::Seconds();
+	for (auto node : nodes)
+		uncachedSum += GetOrderUncached(node);
+	auto uncachedTime = FPlatformTime::Seconds() - startTime;
+
+	auto& cache = FQaDSGraphOrderCache::Get(graph);
+
+	startTime = FPlatformTime::Seconds();
+	for (auto node : nodes)
+		rebuildSum += cache.GetOrder(node);
+	auto rebuildTime = FPlatformTime::Seconds() - startTime;
+
+	startTime = FPlatformTime::Seconds();
+	for (auto node : nodes)
+		cachedSum += cache.GetOrder(node);
+	auto cachedTime = FPlatformTime::Seconds() - startTime;
+
+	UE_LOG(DialogModuleLog, Log, TEXT("Graph order, %d nodes with %d children: per call %.3f ms, cache rebuild frame %.3f ms, cached frame %.3f ms"),
+		numNodes, numChildren, uncachedTime * 1000.0, rebuildTime * 1000.0, cachedTime * 1000.0);
+
+	if (uncachedSum != rebuildSum || rebuildSum != cachedSum)
+		UE_LOG(DialogModuleLog, Error, TEXT("Graph order cache does not match the per call order"));
+
+	graph->MarkPendingKill();
+}
+
+static FAutoConsoleCommand BenchmarkGraphOrderCommand(
+	TEXT("QaDS.BenchmarkGraphOrder"),
+	TEXT("Compute the sibling order of every node of a generated graph (2000 nodes, 20 children or the given counts) per call and through the graph cache, and log the time of one frame"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkGraphOrder));
+
+/* Wires */
+
+// QaDS.BenchmarkWires [links] [zoom] - one frame of generated links drawn as per segment splines without culling, culled and from cached geometry
+static void BenchmarkWires(const TArray<FString>& Args)
+{
+	auto numLinks = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 5000;
+	auto zoom = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 1.0f;
+
+	// links are spread over 4x4 screens, the view shows one of them
+	auto clip = FSlateRect(0.0f, 0.0f, 1920.0f, 1080.0f);
+	auto random = FRandomStream(numLinks);
+
+	FConnectionParams params;
+	params.WireColor = FLinearColor::White;
+	params.WireThickness = 2.0f;
+
+	TArray<FVector2D> starts;
+	TArray<FVector2D> ends;
+	TArray<FRectWire> wires;
+	wires.SetNum(numLinks);
+
+	auto numVisible = 0;
+	for (int32 i = 0; i < numLinks; i++)
+	{
+		auto start = FVector2D(random.FRandRange(0.0f, 4 * 1920.0f), random.FRandRange(0.0f, 4 * 1080.0f));
+		auto end = start + FVector2D(random.FRandRange(-300.0f, 300.0f), random.FRandRange(-200.0f, 400.0f)) * zoom;
+
+		starts.Add(start);
+		ends.Add(end);
+		FRectConnectionDrawingPolicy::BuildWire(start, end, params, zoom, wires[i]);
+
+		if (FSlateRect::DoRectanglesIntersect(FSlateRect(wires[i].Min, wires[i].Max), clip))
+			numVisible++;
+	}
+
+	double splineTime;
+	{
+		FSlateWindowElementList elements(TSharedPtr<SWindow>(NULL));
+		FRectConnectionDrawingPolicy policy(0, 1, zoom, clip, elements, NULL);
+		FRectWire wire;
+
+		auto startTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < numLinks; i++)
+		{
+			FRectConnectionDrawingPolicy::BuildWire(starts[i], ends[i], params, zoom, wire);
+			for (int32 j = 1; j < wire.Points.Num(); j++)
+				policy.DrawConnection(0, wire.Points[j - 1], wire.Points[j], params);
+		}
+		splineTime = FPlatformTime::Seconds() - startTime;
+	}
+
+	double culledTime;
+	{
+		FSlateWindowElementList elements(TSharedPtr<SWindow>(NULL));
+		FRectConnectionDrawingPolicy policy(0, 1, zoom, clip, elements, NULL);
+
+		auto startTime = FPlatformTime::Seconds();
+		for (int32 i = 0; i < numLinks; i++)
+			policy.DrawSplineWithArrow(starts[i], ends[i], params);
+		culledTime = FPlatformTime::Seconds() - startTime;
+	}
+
+	double cachedTime;
+	{
+		FSlateWindowElementList elements(TSharedPtr<SWindow>(NULL));
+		FRectConnectionDrawingPolicy policy(0, 1, zoom, clip, elements, NULL);
+
+		auto startTime = FPlatformTime::Seconds();
+		for (auto& wire : wires)
+			policy.DrawWire(wire, FVector2D::ZeroVector);
+		cachedTime = FPlatformTime::Seconds() - startTime;
+	}
+
+	UE_LOG(DialogModuleLog, Log, TEXT("Wires, %d links at zoom %.2f (%d on screen): per segment splines %.3f ms, culled %.3f ms, cached %.3f ms"),
+		numLinks, zoom, numVisible, splineTime * 1000.0, culledTime * 1000.0, cachedTime * 1000.0);
+}
+
+static FAutoConsoleCommand BenchmarkWiresCommand(
+	TEXT("QaDS.BenchmarkWires"),
+	TEXT("Draw the wires of generated links (5000 at zoom 1 or the given count and zoom) as per segment splines, culled and from cached geometry, and log the time of one frame"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkWires));
+
+/* Native calls */
+
+// QaDS.BenchmarkNativeCalls [calls] - event action bound through the native registry against a reflection call parsing its command
+static void BenchmarkNativeCalls(const TArray<FString>& Args)
+{
+	auto numCalls = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+
+	static const FName nativeName(TEXT("QaDSBenchmarkAdd"));
+	static int32 sum = 0;
+
+	auto& registry = FStoryNativeRegistry::Get();
+	registry.RegisterAction<int32, int32>(nativeName, [](UObject* Caller, int32 A, int32 B) { sum += A + B; });
+
+	// compiled as an event with the Native call type
+	TArray<FString> params = { TEXT("1"), TEXT("2") };
+	FString command, errorMessage;
+	auto call = registry.Compile(nativeName, false, params, command, errorMessage);
+	registry.Unregister(nativeName);
+
+	if (!call.IsValid())
+	{
+		UE_LOG(DialogModuleLog, Error, TEXT("Native calls: %s"), *errorMessage);
+		return;
+	}
+
+	auto target = GetMutableDefault<UKismetMathLibrary>();
+	auto startTime = FPlatformTime::Seconds();
+
+	for (auto i = 0; i < numCalls; i++)
+		call->Call(target);
+
+	auto nativeTime = FPlatformTime::Seconds() - startTime;
+
+	// as events with the other call types run
+	FOutputDeviceNull output;
+	startTime = FPlatformTime::Seconds();
+
+	for (auto i = 0; i < numCalls; i++)
+		target->CallFunctionByNameWithArguments(TEXT("Add_IntInt 1 2"), output, target, true);
+
+	auto reflectionTime = FPlatformTime::Seconds() - startTime;
+
+	UE_LOG(DialogModuleLog, Display, TEXT("Native calls, %d calls of %s: reflection %.1f ms (%.1f ns/call), native %.1f ms (%.1f ns/call)"),
+		numCalls, *command, reflectionTime * 1000, reflectionTime * 1e9 / numCalls, nativeTime * 1000, nativeTime * 1e9 / numCalls);
+}
+
+static FAutoConsoleCommand BenchmarkNativeCallsCommand(
+	TEXT("QaDS.BenchmarkNativeCalls"),
+	TEXT("Call a two int action 100000 times (or the given count) through the native registry and through CallFunctionByNameWithArguments"),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkNativeCalls));
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "DialogSystemEditor.h"
+#include "QaDSAssetCompiler.h"
+#include "QaDSEdGraphNode.h"
+#include "DialogAssetCompiler.h"
+#include "QuestAssetCompiler.h"
+#include "DialogAsset.h"
+#include "QuestAsset.h"
+
+FQaDSAssetCompiler::FQaDSAssetCompiler(UObject* InAsset, FCompilerResultsLog& InLog)
+	: Asset(InAsset), Graph(GetGraph(InAsset)), Log(InLog), bFullCompile(true), bindTime(0.0), expressionTime(0.0), finishTime(0.0)
+{
+}
+
+TSharedPtr<FQaDSAssetCompiler> FQaDSAssetCompiler::Create(UObject* Asset, FCompilerResultsLog& Log)
+{
+	if (auto dialog = Cast<UDialogAsset>(Asset))
+		return MakeShareable(new FDialogAssetCompiler(dialog, Log));
+
+	if (auto quest = Cast<UQuestAsset>(Asset))
+		return MakeShareable(new FQuestAssetCompiler(quest, Log));
+
+	return NULL;
+}
+
+UEdGraph* FQaDSAssetCompiler::GetGraph(UObject* Asset)
+{
+	if (auto dialog = Cast<UDialogAsset>(Asset))
+		return dialog->UpdateGraph;
+
+	if (auto quest = Cast<UQuestAsset>(Asset))
+		return quest->UpdateGraph;
+
+	return NULL;
+}
+
+void FQaDSAssetCompiler::Compile()
+{
+	Bind();
+	CompileExpressions();
+	Finish();
+}
+
+void FQaDSAssetCompiler::Bind()
+{
+	auto time = FPlatformTime::Seconds();
+
+	bFullCompile = true;
+	compiledNodes.Reset();
+	nodeMessages.Reset();
+	expressions.Reset();
+
+	TakeDirtyNodes();
+	BindGraph();
+
+	bindTime = FPlatformTime::Seconds() - time;
+}
+
+void FQaDSAssetCompiler::BindDirty()
+{
+	auto time = FPlatformTime::Seconds();
+
+	bFullCompile = false;
+	compiledNodes.Reset();
+	nodeMessages.Reset();
+	expressions.Reset();
+
+	if (!BindNodes(TakeDirtyNodes()))
+	{
+		Bind();
+		return;
+	}
+
+	bindTime = FPlatformTime::Seconds() - time;
+}
+
+void FQaDSAssetCompiler::CompileExpressions()
+{
+	auto time = FPlatformTime::Seconds();
+
+	for (auto& pending : expressions)
+		pending.bSuccess = pending.Expression->Compile(pending.NumPredicates, pending.ErrorMessage);
+
+	expressionTime = FPlatformTime::Seconds() - time;
+}
+
+void FQaDSAssetCompiler::Finish()
+{
+	auto time = FPlatformTime::Seconds();
+
+	for (int i = 0; i < expressions.Num(); i++)
+	{
+		auto& pending = expressions[i];
+		if (!pending.bSuccess)
+			Error(pending.Node, pending.ErrorMessage + pending.Context);
+
+		OnExpressionCompiled(i, pending.Expression->IsEmpty());
+	}
+
+	expressions.Empty();
+	UpdateUsage();
+
+	finishTime = FPlatformTime::Seconds() - time;
+}
+
+void FQaDSAssetCompiler::AddExpression(FStoryConditionExpression* Expression, UQaDSEdGraphNode* Node, int32 NumPredicates, const FString& Context)
+{
+	FPendingExpression pending;
+	pending.Expression = Expression;
+	pending.Node = Node;
+	pending.NumPredicates = NumPredicates;
+	pending.Context = Context;
+	pending.bSuccess = false;
+
+	expressions.Add(pending);
+}
+
+void FQaDSAssetCompiler::ResetCompile(UQaDSEdGraphNode* Node)
+{
+	if (!Node->IsCompile())
+		return;
+
+	Node->ResetCompile();
+
+	for (auto child : Node->GetCachedChildNodes())
+		ResetCompile(child);
+}
+
+void FQaDSAssetCompiler::OnNodeCompiled(UQaDSEdGraphNode* Node)
+{
+	Node->bIsCompileDirty = false;
+	compiledNodes.Add(Node);
+}
+
+void FQaDSAssetCompiler::Error(UQaDSEdGraphNode* Node, const FString& Message)
+{
+	if (Node == NULL)
+	{
+		Log.Error(*Message);
+		return;
+	}
+
+	nodeMessages.Add(Node, Log.Error(*(Message + TEXT(" @@")), (UEdGraphNode*)Node));
+}
+
+TArray<UQaDSEdGraphNode*> FQaDSAssetCompiler::TakeDirtyNodes()
+{
+	TArray<UQaDSEdGraphNode*> dirtyNodes;
+	if (Graph == NULL)
+		return dirtyNodes;
+
+	for (auto node : Graph->Nodes)
+	{
+		auto qadsNode = Cast<UQaDSEdGraphNode>(node);
+		if (qadsNode != NULL && qadsNode->bIsCompileDirty)
+		{
+			qadsNode->bIsCompileDirty = false;
+			dirtyNodes.Add(qadsNode);
+		}
+	}
+
+	return dirtyNodes;
+}
\ No newline at end of file
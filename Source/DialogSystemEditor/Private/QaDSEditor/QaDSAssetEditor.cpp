@@ -17,6 +17,8 @@
 #include "HAL/PlatformApplicationMisc.h"
 #include "QaDSSettings.h"
 #include "QaDSEdGraphNode.h"
+#include "QaDSAssetCompiler.h"
+#include "QaDSGraphOrderCache.h"
 #include "DialogGraphSchema.h"
 
 #include "Framework/Application/SlateApplication.h"
@@ -24,6 +26,8 @@
 #include "FileHelper.h"
 #include "DesktopPlatformModule.h"
 #include "XmlFile.h"
+#include "Misc/ScopedSlowTask.h"
+#include "Containers/Ticker.h"
 
 #define LOCTEXT_NAMESPACE "QaDSGraph"
 
@@ -223,6 +227,19 @@ void FQaDSAssetEditor::OnSelectedNodesChanged(const TSet<UObject*>& NewSelection
 
 void FQaDSAssetEditor::OpenFindWindow()
 {
+	FGlobalTabmanager::Get()->InvokeTab(FName("QaDSSearchWindow"));
+}
+
+void FQaDSAssetEditor::JumpToNode(const FGuid& NodeGuid)
+{
+	for (auto node : EdGraph->Nodes)
+	{
+		if (node->NodeGuid == NodeGuid)
+		{
+			GraphEditor->JumpToNode(node, false);
+			return;
+		}
+	}
 }
 
 void FQaDSAssetEditor::ExportExecute()
@@ -240,13 +257,24 @@ void FQaDSAssetEditor::ExportExecute()
 
 	if (isSaved)
 	{
-		FXmlWriteNode nodes("nodes");
+		TUniquePtr<FArchive> file(IFileManager::Get().CreateFileWriter(*Filenames[0]));
+		if (!file.IsValid())
+		{
+			UE_LOG(DialogModuleLog, Error, TEXT("Failed open %s for export"), *Filenames[0]);
+			return;
+		}
+
+		// nodes are written one by one, only one node tree is kept in memory
+		FXmlStreamWriter writer(file.Get());
+		writer.WriteHeader();
+		writer.BeginElement("nodes");
+
 		for (auto graphNode : GraphEditor->GetCurrentGraph()->Nodes)
 		{
-			nodes.Childrens.Add(Cast<UQaDSEdGraphNode>(graphNode)->SaveToXml());
+			writer.WriteNode(Cast<UQaDSEdGraphNode>(graphNode)->SaveToXml());
 		}
 
-		FFileHelper::SaveStringToFile(nodes.GetXml(), *Filenames[0]);
+		writer.EndElement();
 	}
 }
 
@@ -265,35 +293,76 @@ void FQaDSAssetEditor::ImportExecute()
 
 	if (isOpen)
 	{
-		FXmlFile xml(*Filenames[0]);
+		FXmlImportDocument xml;
+		TArray<int32> nodeElements;
 
-		TMap<UQaDSEdGraphNode*, FXmlReadNode> xmlByNode;
-		TMap<FString, UQaDSEdGraphNode*> nodesById;
+		// the graph is changed only after the whole file is parsed
+		xml.OnRootChild = [&](int32 Element)
+		{
+			nodeElements.Add(Element);
+		};
+
+		FText errorMessage;
+		int32 errorLine = 0;
 
-		for (auto nodeTag : xml.GetRootNode()->GetChildrenNodes())
+		if (!xml.LoadFile(Filenames[0], true, errorMessage, errorLine))
 		{
-			auto reader = FXmlReadNode(nodeTag);
+			UE_LOG(DialogModuleLog, Error, TEXT("Failed import %s (line %d): %s"), *Filenames[0], errorLine, *errorMessage.ToString());
+			return;
+		}
 
-			auto nodeClass = FindObject<UClass>(ANY_PACKAGE, *reader.Get("class"));
-			if (nodeClass == NULL)
-				continue;
+		TArray<TPair<UClass*, FXmlReadNode>> xmlByClass;
+		TMap<FString, UClass*> classByName;
 
-			auto nodeTemplate = NewObject<UQaDSEdGraphNode>(GraphEditor->GetCurrentGraph(), nodeClass);
-			auto node = FQaDSSchemaAction_NewNode::SpawnNodeFromTemplate<UQaDSEdGraphNode>(EdGraph, nodeTemplate, FVector2D::ZeroVector, false);
-			node->AllocateDefaultPins();
+		for (auto element : nodeElements)
+		{
+			auto reader = FXmlReadNode(&xml, element);
+			auto className = reader.Get("class");
+
+			auto nodeClass = classByName.FindRef(className);
+			if (nodeClass == NULL)
+			{
+				nodeClass = FindObject<UClass>(ANY_PACKAGE, *className);
+				classByName.Add(className, nodeClass);
+			}
 
-			nodesById.Add(reader.Get("id"), node);
-			xmlByNode.Add(node, reader);
+			if (nodeClass != NULL)
+				xmlByClass.Emplace(nodeClass, reader);
 		}
 
-		if (xmlByNode.Num() == 0)
+		if (xmlByClass.Num() == 0)
 			return;
 
+		const FScopedTransaction Transaction(LOCTEXT("ImportXml", "Import Xml"));
+
 		auto graph = GraphEditor->GetCurrentGraph();
+		graph->Modify();
+
+		TArray<TPair<UQaDSEdGraphNode*, FXmlReadNode>> xmlByNode;
+		TMap<FGuid, UQaDSEdGraphNode*> nodesById;
+
+		for (auto& kpv : xmlByClass)
+		{
+			auto nodeTemplate = NewObject<UQaDSEdGraphNode>(graph, kpv.Key);
+			auto node = FQaDSSchemaAction_NewNode::SpawnNodeFromTemplate<UQaDSEdGraphNode>(EdGraph, nodeTemplate, FVector2D::ZeroVector, false);
+			node->AllocateDefaultPins();
+
+			FGuid id;
+			FGuid::Parse(kpv.Value.Get("id"), id);
+
+			nodesById.Add(id, node);
+			xmlByNode.Emplace(node, kpv.Value);
+		}
+
 		graph->Nodes.Reset();
 
-		for (auto kpv : xmlByNode)
+		FScopedSlowTask linkTask(xmlByNode.Num(), LOCTEXT("ImportLinkNodes", "Linking imported nodes"));
+		linkTask.MakeDialogDelayed(1.0f);
+
+		for (auto& kpv : xmlByNode)
 		{
+			linkTask.EnterProgressFrame();
+
 			kpv.Key->LoadInXml(&kpv.Value, nodesById);
 			graph->Nodes.Add(kpv.Key);
 		}
@@ -304,43 +373,126 @@ void FQaDSAssetEditor::CompileExecute()
 {
 	UE_LOG(DialogModuleLog, Log, TEXT("Compile dialog %s"), *EditedAsset->GetPathName());
 
-	CompileLogResults = FCompilerResultsLog();
-	CompileLogResults.BeginEvent(TEXT("Compile"));
-	CompileLogResults.SetSourcePath(EditedAsset->GetPathName());
+	bCompileRequested = false;
+	RunCompile(true);
 
-	CompileLogResults.Note(TEXT("Compile dialog"));
+	auto selected = GraphEditor->GetSelectedNodes();
+	GraphEditor->ClearSelectionSet();
 
-	if (!CompilerResultsTab.IsValid())
-		CompilerResultsTab = TabManager->InvokeTab(FQaDSAssetEditorTabs::CompilerResultsID);
+	for (auto n : selected.Array())
+		GraphEditor->SetNodeSelection(Cast<UEdGraphNode>(n), true);
+}
 
-	CompilerResultsListing->ClearMessages();
+void FQaDSAssetEditor::RequestCompile(bool bFullCompile)
+{
+	CompileRequestTime = FPlatformTime::Seconds();
+	bCompileRequested = true;
+	bFullCompileRequested |= bFullCompile;
 
-	Compile();
+	if (!CompileTickerHandle.IsValid())
+		CompileTickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(this, &FQaDSAssetEditor::TickCompile));
 
-	CompileLogResults.EndEvent();
-	CompilerResultsListing->AddMessages(CompileLogResults.Messages);
+	if (!BeginPIEDelegateHandle.IsValid())
+		BeginPIEDelegateHandle = FEditorDelegates::BeginPIE.AddSP(this, &FQaDSAssetEditor::OnBeginPIE);
+}
+
+void FQaDSAssetEditor::FlushCompile()
+{
+	if (bCompileRequested)
+	{
+		bCompileRequested = false;
+		RunCompile(bFullCompileRequested);
+	}
+}
 
+bool FQaDSAssetEditor::TickCompile(float DeltaTime)
+{
+	if (!bCompileRequested)
+	{
+		CompileTickerHandle.Reset();
+		return false;
+	}
 
-	auto selected = GraphEditor->GetSelectedNodes();
-	GraphEditor->ClearSelectionSet();
+	if (FPlatformTime::Seconds() - CompileRequestTime < GetDefault<UQaDSSettings>()->AutoCompileDelay)
+		return true;
 
-	for (auto n : selected.Array())
-		GraphEditor->SetNodeSelection(Cast<UEdGraphNode>(n), true);
+	bCompileRequested = false;
+	RunCompile(bFullCompileRequested);
+
+	return true;
 }
 
-void FQaDSAssetEditor::ResetCompilePhrase(UQaDSEdGraphNode* Node)
+void FQaDSAssetEditor::RunCompile(bool bFullCompile)
 {
-	if (!Node->IsCompile())
+	bFullCompileRequested = false;
+
+	CompileLogResults = FCompilerResultsLog();
+	CompileLogResults.BeginEvent(TEXT("Compile"));
+	CompileLogResults.SetSourcePath(EditedAsset->GetPathName());
+
+	auto compiler = FQaDSAssetCompiler::Create(EditedAsset, CompileLogResults);
+	if (!compiler.IsValid())
 		return;
 
-	Node->ResetCompile();
+	if (bFullCompile || !bIsCompiledOnce)
+		compiler->Bind();
+	else
+		compiler->BindDirty();
+
+	bIsCompiledOnce = true;
+
+	// conditions live in the runtime nodes of the asset, edits, undo and GC may change them at any time,
+	// so they are parsed here on the game thread
+	compiler->CompileExpressions();
+	compiler->Finish();
+
+	ReportCompile(*compiler);
+}
+
+void FQaDSAssetEditor::ReportCompile(const FQaDSAssetCompiler& Compiler)
+{
+	CompileLogResults.Note(*FString::Printf(TEXT("%s compile of %d nodes: bind %.2f ms, conditions %.2f ms, finish %.2f ms"),
+		Compiler.IsFullCompile() ? TEXT("Full") : TEXT("Incremental"), Compiler.GetCompiledNodes().Num(),
+		Compiler.GetBindTime() * 1000.0, Compiler.GetExpressionTime() * 1000.0, Compiler.GetFinishTime() * 1000.0));
+	CompileLogResults.EndEvent();
+
+	// keep the messages of nodes that were not compiled again
+	if (Compiler.IsFullCompile())
+		NodeMessages.Reset();
 
-	for (auto& child : Node->GetChildNodes())
+	for (auto node : Compiler.GetCompiledNodes())
+		NodeMessages.Remove(node);
+
+	TArray<TSharedRef<FTokenizedMessage>> messages;
+	for (auto it = NodeMessages.CreateIterator(); it; ++it)
 	{
-		auto childPhrase = Cast<UQaDSEdGraphNode>(child);
-		if (childPhrase)
-			ResetCompilePhrase(childPhrase);
+		if (!it.Key().IsValid() || !EdGraph->Nodes.Contains(it.Key().Get()))
+			it.RemoveCurrent();
+		else
+			messages.Append(it.Value());
 	}
+
+	for (auto& message : Compiler.GetNodeMessages())
+		NodeMessages.FindOrAdd(message.Key).Add(message.Value);
+
+	messages.Append(CompileLogResults.Messages);
+
+	if (!CompilerResultsTab.IsValid())
+		CompilerResultsTab = TabManager->InvokeTab(FQaDSAssetEditorTabs::CompilerResultsID);
+
+	CompilerResultsListing->ClearMessages();
+	CompilerResultsListing->AddMessages(messages);
+}
+
+void FQaDSAssetEditor::OnBeginPIE(const bool bIsSimulating)
+{
+	FlushCompile();
+}
+
+void FQaDSAssetEditor::SaveAsset_Execute()
+{
+	FlushCompile();
+	FAssetEditorToolkit::SaveAsset_Execute();
 }
 
 void FQaDSAssetEditor::OnNodeDoubleClicked(class UEdGraphNode* Node)
@@ -390,6 +542,15 @@ void FQaDSAssetEditor::DeleteNodes(const TArray<class UEdGraphNode*>& NodesToDel
 			if (!CanDeleteNode(NodesToDelete[Index]))
 				continue;
 
+			for (auto pin : NodesToDelete[Index]->Pins)
+			{
+				for (auto linkedPin : pin->LinkedTo)
+				{
+					if (auto linkedNode = Cast<UQaDSEdGraphNode>(linkedPin->GetOwningNode()))
+						linkedNode->MarkCompileDirty();
+				}
+			}
+
 			NodesToDelete[Index]->BreakAllNodeLinks();
 
 			FBlueprintEditorUtils::RemoveNode(NULL, NodesToDelete[Index], true);
@@ -477,6 +638,7 @@ void FQaDSAssetEditor::PasteNodesHere(const FVector2D& Location)
 		if (qadesNode != NULL)
 		{
 			qadesNode->ResetCompile();
+			qadesNode->MarkCompileDirty();
 		}
 	}
 
@@ -547,8 +709,19 @@ void FQaDSAssetEditor::OnGraphChanged(const FEdGraphEditAction& Action)
 {
 	bGraphStateChanged = true;
 
+	if (Action.Action == GRAPHACTION_SelectNode)
+		return;
+
+	FQaDSGraphOrderCache::Invalidate(EdGraph);
+
+	for (auto node : Action.Nodes)
+	{
+		if (auto qadsNode = Cast<UQaDSEdGraphNode>(const_cast<UEdGraphNode*>(node)))
+			qadsNode->MarkCompileDirty();
+	}
+
 	if (GetDefault<UQaDSSettings>()->AutoCompile)
-		CompileExecute();
+		RequestCompile();
 }
 
 void FQaDSAssetEditor::OnPropertyChanged(const FPropertyChangedEvent& Event)
@@ -559,8 +732,13 @@ void FQaDSAssetEditor::OnPropertyChanged(const FPropertyChangedEvent& Event)
 	if(Event.Property->GetCPPType().StartsWith("E")) // skip enum
 		return;
 
+	// edited nodes mark themselves dirty, asset properties like the script class affect every node
+	bool bIsAssetEdited = false;
+	for (auto& object : PropertyEditor->GetSelectedObjects())
+		bIsAssetEdited |= object.Get() == EditedAsset;
+
 	if (GetDefault<UQaDSSettings>()->AutoCompile)
-		CompileExecute();
+		RequestCompile(bIsAssetEdited);
 }
 
 FName FQaDSAssetEditor::GetToolkitFName() const
@@ -585,6 +763,11 @@ FLinearColor FQaDSAssetEditor::GetWorldCentricTabColorScale() const
 
 FQaDSAssetEditor::~FQaDSAssetEditor()
 {
+	if (CompileTickerHandle.IsValid())
+		FTicker::GetCoreTicker().RemoveTicker(CompileTickerHandle);
+
+	FEditorDelegates::BeginPIE.Remove(BeginPIEDelegateHandle);
+
 	if (GraphEditor->GetCurrentGraph())
 		GraphEditor->GetCurrentGraph()->RemoveOnGraphChangedHandler(OnGraphChangedDelegateHandle);
 }
@@ -0,0 +1,210 @@
+#include "DialogSystemEditor.h"
+#include "QaDSCompileCommandlet.h"
+#include "QaDSAssetCompiler.h"
+#include "DialogAsset.h"
+#include "QuestAsset.h"
+#include "AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "FileHelper.h"
+#include "Paths.h"
+#include "PackageName.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/PrettyJsonPrintPolicy.h"
+
+struct FQaDSCompileEntry
+{
+	FAssetData AssetData;
+	FCompilerResultsLog Log;
+	TSharedPtr<FQaDSAssetCompiler> Compiler;
+	double LoadTime = 0.0;
+	double BindTime = 0.0;
+	double ExpressionTime = 0.0;
+	double FinishTime = 0.0;
+	bool bSaved = false;
+};
+
+static const TCHAR* GetSeverityName(EMessageSeverity::Type Severity)
+{
+	switch (Severity)
+	{
+	case EMessageSeverity::CriticalError:
+	case EMessageSeverity::Error:
+		return TEXT("error");
+
+	case EMessageSeverity::PerformanceWarning:
+	case EMessageSeverity::Warning:
+		return TEXT("warning");
+
+	default:
+		return TEXT("info");
+	}
+}
+
+UQaDSCompileCommandlet::UQaDSCompileCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UQaDSCompileCommandlet::Main(const FString& Params)
+{
+	TArray<FString> tokens;
+	TArray<FString> switches;
+	TMap<FString, FString> params;
+	ParseCommandLine(*Params, tokens, switches, params);
+
+	bool bSave = switches.Contains(TEXT("save"));
+	FString reportPath = params.FindRef(TEXT("report"));
+	if (reportPath.IsEmpty())
+		reportPath = FPaths::ProjectSavedDir() / TEXT("QaDS") / TEXT("CompileReport.json");
+
+	double startTime = FPlatformTime::Seconds();
+
+	auto& assetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	assetRegistry.SearchAllAssets(true);
+
+	FARFilter filter;
+	filter.ClassNames.Add(UDialogAsset::StaticClass()->GetFName());
+	filter.ClassNames.Add(UQuestAsset::StaticClass()->GetFName());
+	filter.bRecursiveClasses = true;
+
+	FString path = params.FindRef(TEXT("path"));
+	if (!path.IsEmpty())
+	{
+		filter.PackagePaths.Add(*path);
+		filter.bRecursivePaths = true;
+	}
+
+	TArray<FAssetData> assets;
+	assetRegistry.GetAssets(filter, assets);
+
+	UE_LOG(DialogModuleLog, Display, TEXT("QaDSCompile: %d assets"), assets.Num());
+
+	TArray<FQaDSCompileEntry> entries;
+	entries.SetNum(assets.Num());
+
+	// load and bind on the game thread, events and conditions look up functions on blueprint classes
+	for (int i = 0; i < assets.Num(); i++)
+	{
+		auto& entry = entries[i];
+		entry.AssetData = assets[i];
+		entry.Log.SetSourcePath(assets[i].ObjectPath.ToString());
+
+		double time = FPlatformTime::Seconds();
+		auto asset = assets[i].GetAsset();
+		entry.LoadTime = FPlatformTime::Seconds() - time;
+
+		if (asset == NULL)
+		{
+			entry.Log.Error(TEXT("Failed to load asset"));
+			continue;
+		}
+
+		if (FQaDSAssetCompiler::GetGraph(asset) == NULL)
+		{
+			entry.Log.Error(TEXT("Asset has no graph, open and save it in the editor once"));
+			continue;
+		}
+
+		time = FPlatformTime::Seconds();
+		entry.Compiler = FQaDSAssetCompiler::Create(asset, entry.Log);
+		entry.Compiler->Bind();
+		entry.BindTime = FPlatformTime::Seconds() - time;
+	}
+
+	// condition expressions only touch the data of their own asset
+	ParallelFor(entries.Num(), [&entries](int32 Index)
+	{
+		auto& entry = entries[Index];
+		if (!entry.Compiler.IsValid())
+			return;
+
+		double time = FPlatformTime::Seconds();
+		entry.Compiler->CompileExpressions();
+		entry.ExpressionTime = FPlatformTime::Seconds() - time;
+	});
+
+	int32 numErrors = 0;
+	int32 numWarnings = 0;
+
+	for (auto& entry : entries)
+	{
+		if (entry.Compiler.IsValid())
+		{
+			double time = FPlatformTime::Seconds();
+			entry.Compiler->Finish();
+			entry.FinishTime = FPlatformTime::Seconds() - time;
+
+			auto asset = entry.Compiler->GetAsset();
+			if (bSave && entry.Log.NumErrors == 0)
+			{
+				auto package = asset->GetOutermost();
+				package->MarkPackageDirty();
+
+				auto fileName = FPackageName::LongPackageNameToFilename(package->GetName(), FPackageName::GetAssetPackageExtension());
+				entry.bSaved = UPackage::SavePackage(package, NULL, RF_Standalone, *fileName, GError, NULL, false, true, SAVE_NoError);
+				if (!entry.bSaved)
+					entry.Log.Error(TEXT("Failed to save package"));
+			}
+		}
+
+		numErrors += entry.Log.NumErrors;
+		numWarnings += entry.Log.NumWarnings;
+
+		for (auto& message : entry.Log.Messages)
+		{
+			if (message->GetSeverity() == EMessageSeverity::Error)
+				UE_LOG(DialogModuleLog, Error, TEXT("%s: %s"), *entry.AssetData.ObjectPath.ToString(), *message->ToText().ToString());
+		}
+	}
+
+	double totalTime = FPlatformTime::Seconds() - startTime;
+
+	FString report;
+	auto writer = TJsonWriterFactory<TCHAR, TPrettyJsonPrintPolicy<TCHAR>>::Create(&report);
+	writer->WriteObjectStart();
+	writer->WriteValue(TEXT("numAssets"), entries.Num());
+	writer->WriteValue(TEXT("numErrors"), numErrors);
+	writer->WriteValue(TEXT("numWarnings"), numWarnings);
+	writer->WriteValue(TEXT("totalMs"), totalTime * 1000.0);
+	writer->WriteArrayStart(TEXT("assets"));
+
+	for (auto& entry : entries)
+	{
+		writer->WriteObjectStart();
+		writer->WriteValue(TEXT("path"), entry.AssetData.ObjectPath.ToString());
+		writer->WriteValue(TEXT("class"), entry.AssetData.AssetClass.ToString());
+		writer->WriteValue(TEXT("errors"), entry.Log.NumErrors);
+		writer->WriteValue(TEXT("warnings"), entry.Log.NumWarnings);
+		writer->WriteValue(TEXT("saved"), entry.bSaved);
+		writer->WriteValue(TEXT("loadMs"), entry.LoadTime * 1000.0);
+		writer->WriteValue(TEXT("bindMs"), entry.BindTime * 1000.0);
+		writer->WriteValue(TEXT("expressionMs"), entry.ExpressionTime * 1000.0);
+		writer->WriteValue(TEXT("finishMs"), entry.FinishTime * 1000.0);
+		writer->WriteArrayStart(TEXT("messages"));
+
+		for (auto& message : entry.Log.Messages)
+		{
+			writer->WriteObjectStart();
+			writer->WriteValue(TEXT("severity"), GetSeverityName(message->GetSeverity()));
+			writer->WriteValue(TEXT("text"), message->ToText().ToString());
+			writer->WriteObjectEnd();
+		}
+
+		writer->WriteArrayEnd();
+		writer->WriteObjectEnd();
+	}
+
+	writer->WriteArrayEnd();
+	writer->WriteObjectEnd();
+	writer->Close();
+
+	if (!FFileHelper::SaveStringToFile(report, *reportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+		UE_LOG(DialogModuleLog, Error, TEXT("QaDSCompile: failed to write report %s"), *reportPath);
+
+	UE_LOG(DialogModuleLog, Display, TEXT("QaDSCompile: %d assets, %d errors, %d warnings in %.2f s, report %s"), entries.Num(), numErrors, numWarnings, totalTime, *reportPath);
+
+	return numErrors > 0 ? 1 : 0;
+}
\ No newline at end of file
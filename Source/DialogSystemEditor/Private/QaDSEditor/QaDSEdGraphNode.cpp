@@ -3,6 +3,7 @@
 #include "EdGraph/EdGraphPin.h"
 #include "XmlSerealizeHelper.h"
 #include "XmlFile.h"
+#include "QaDSGraphOrderCache.h"
 
 TArray<UQaDSEdGraphNode*> UQaDSEdGraphNode::GetChildNodes() const
 {
@@ -25,43 +26,74 @@ TArray<UQaDSEdGraphNode*> UQaDSEdGraphNode::GetChildNodes() const
 
 int UQaDSEdGraphNode::GetOrder() const
 {
-	auto inputPin = Pins.FindByPredicate([](const UEdGraphPin* pin) {return pin->Direction == EGPD_Input; });
-
-	if (inputPin == NULL || (*inputPin)->LinkedTo.Num() == 0)
-		return 0;
-
-	auto bigOwner = (UQaDSEdGraphNode*)(*inputPin)->LinkedTo[0]->GetOwningNode();
-	for (auto ownerPin : (*inputPin)->LinkedTo)
-	{
-		auto owner = (UQaDSEdGraphNode*)ownerPin->GetOwningNode();
-
-		if (owner != NULL && owner->GetChildNodes().Num() > bigOwner->GetChildNodes().Num())
-		{
-			bigOwner = owner;
-		}
-	}
+	return FQaDSGraphOrderCache::Get(GetGraph()).GetOrder(this);
+}
 
-	auto lessCount = 0;
-	for (auto node : bigOwner->GetChildNodes())
-	{
-		if (node->NodePosX < NodePosX)
-			lessCount++;
-	}
+const TArray<UQaDSEdGraphNode*>& UQaDSEdGraphNode::GetCachedChildNodes() const
+{
+	return FQaDSGraphOrderCache::Get(GetGraph()).GetChildren(this);
+}
 
-	return lessCount + 1;
+const TArray<UQaDSEdGraphNode*>& UQaDSEdGraphNode::GetOrderedChildNodes() const
+{
+	return FQaDSGraphOrderCache::Get(GetGraph()).GetOrderedChildren(this);
 }
 
 void UQaDSEdGraphNode::PostEditChangeProperty(struct FPropertyChangedEvent& e)
 {
 	if (PropertyObserver.IsValid())
 	{
-		FName PropertyName = (e.Property != NULL) ? e.Property->GetFName() : NAME_None;
+		FName PropertyName = !changedDataProperty.IsNone() ? changedDataProperty : (e.Property != NULL) ? e.Property->GetFName() : NAME_None;
 		PropertyObserver->OnPropertyChanged(this, PropertyName);
 	}
 
+	MarkCompileDirty();
+	FQaDSGraphOrderCache::Invalidate(GetGraph());
 	Super::PostEditChangeProperty(e);
 }
 
+void UQaDSEdGraphNode::PostEditChangeChainProperty(struct FPropertyChangedChainEvent& e)
+{
+	// for edits inside Data or Stage report the struct field, so widgets can refresh just its rows
+	auto member = e.PropertyChain.GetActiveMemberNode();
+	if (member != NULL && member->GetNextNode() != NULL && Cast<UStructProperty>(member->GetValue()) != NULL)
+		changedDataProperty = member->GetNextNode()->GetValue()->GetFName();
+
+	Super::PostEditChangeChainProperty(e);
+	changedDataProperty = NAME_None;
+}
+
+void UQaDSEdGraphNode::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// links may be restored on both sides
+	MarkCompileDirty();
+	FQaDSGraphOrderCache::Invalidate(GetGraph());
+	for (auto Pin : Pins)
+	{
+		for (auto LinkedPin : Pin->LinkedTo)
+		{
+			if (auto owner = Cast<UQaDSEdGraphNode>(LinkedPin->GetOwningNode()))
+				owner->MarkCompileDirty();
+		}
+	}
+}
+
+void UQaDSEdGraphNode::PinConnectionListChanged(UEdGraphPin* Pin)
+{
+	Super::PinConnectionListChanged(Pin);
+	MarkCompileDirty();
+	FQaDSGraphOrderCache::Invalidate(GetGraph());
+}
+
+void UQaDSEdGraphNode::NodeConnectionListChanged()
+{
+	Super::NodeConnectionListChanged();
+	MarkCompileDirty();
+	FQaDSGraphOrderCache::Invalidate(GetGraph());
+}
+
 FXmlWriteNode UQaDSEdGraphNode::SaveToXml() const
 {
 	auto node = FXmlWriteNode("node");
@@ -71,12 +103,12 @@ FXmlWriteNode UQaDSEdGraphNode::SaveToXml() const
 	node.Append("x", NodePosX);
 	node.Append("y", NodePosY);
 
-	node.Append("links", GetChildNodes());
+	node.Append("links", GetCachedChildNodes());
 
 	return node;
 }
 
-void UQaDSEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById)
+void UQaDSEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById)
 {
 	reader->TryGet("x", NodePosX);
 	reader->TryGet("y", NodePosY);
@@ -84,12 +116,16 @@ void UQaDSEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDS
 	FGuid::Parse(reader->Get<FString>("id"), NodeGuid);
 
 	auto links = reader->Get<TArray<FString>>("links");
-	for (auto id : links)
+	for (auto& link : links)
 	{
-		if (!nodeById.Contains(id))
+		FGuid id;
+		if (!FGuid::Parse(link, id))
+			continue;
+
+		auto node = nodeById.FindRef(id);
+		if (node == NULL)
 			continue;
 
-		auto node = nodeById[id];
 		auto inputPin = node->Pins.FindByPredicate([](UEdGraphPin* pin) { return pin->Direction == EEdGraphPinDirection::EGPD_Input; });
 		auto outputPin = Pins.FindByPredicate([](UEdGraphPin* pin) { return pin->Direction == EEdGraphPinDirection::EGPD_Output; });
 
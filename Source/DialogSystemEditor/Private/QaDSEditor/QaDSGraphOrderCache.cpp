@@ -0,0 +1,124 @@
+#include "DialogSystemEditor.h"
+#include "QaDSGraphOrderCache.h"
+#include "DialogSystemRuntime.h"
+#include "QaDSEdGraphNode.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphPin.h"
+
+DECLARE_CYCLE_STAT(TEXT("Graph order rebuild"), STAT_QaDS_GraphOrderRebuild, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Graph order rebuilds"), STAT_QaDS_GraphOrderRebuilds, STATGROUP_QaDS);
+
+TMap<TWeakObjectPtr<const UEdGraph>, TSharedPtr<FQaDSGraphOrderCache>> FQaDSGraphOrderCache::caches;
+
+FQaDSGraphOrderCache& FQaDSGraphOrderCache::Get(const UEdGraph* Graph)
+{
+	auto cache = caches.Find(Graph);
+	if (cache != NULL)
+		return **cache;
+
+	for (auto it = caches.CreateIterator(); it; ++it)
+	{
+		if (!it.Key().IsValid())
+			it.RemoveCurrent();
+	}
+
+	auto& newCache = caches.Add(Graph, MakeShareable(new FQaDSGraphOrderCache()));
+	newCache->graph = Graph;
+	return *newCache;
+}
+
+void FQaDSGraphOrderCache::Invalidate(const UEdGraph* Graph)
+{
+	auto cache = caches.Find(Graph);
+	if (cache != NULL)
+		(*cache)->Invalidate();
+}
+
+int32 FQaDSGraphOrderCache::GetOrder(const UQaDSEdGraphNode* Node)
+{
+	auto info = Find(Node);
+	return info ? info->Order : 0;
+}
+
+const TArray<UQaDSEdGraphNode*>& FQaDSGraphOrderCache::GetChildren(const UQaDSEdGraphNode* Node)
+{
+	static const TArray<UQaDSEdGraphNode*> empty;
+
+	auto info = Find(Node);
+	return info ? info->Children : empty;
+}
+
+const TArray<UQaDSEdGraphNode*>& FQaDSGraphOrderCache::GetOrderedChildren(const UQaDSEdGraphNode* Node)
+{
+	static const TArray<UQaDSEdGraphNode*> empty;
+
+	auto info = Find(Node);
+	return info ? info->OrderedChildren : empty;
+}
+
+const FQaDSGraphOrderCache::FNodeInfo* FQaDSGraphOrderCache::Find(const UQaDSEdGraphNode* Node)
+{
+	if (!graph.IsValid())
+		return NULL;
+
+	if (!bIsValid || numGraphNodes != graph->Nodes.Num())
+		Rebuild();
+
+	return nodes.Find(Node);
+}
+
+void FQaDSGraphOrderCache::Rebuild()
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_GraphOrderRebuild);
+	INC_DWORD_STAT(STAT_QaDS_GraphOrderRebuilds);
+
+	bIsValid = true;
+	numGraphNodes = graph->Nodes.Num();
+	nodes.Reset();
+
+	for (auto graphNode : graph->Nodes)
+	{
+		auto node = Cast<UQaDSEdGraphNode>(graphNode);
+		if (node != NULL)
+			nodes.Add(node).Children = node->GetChildNodes();
+	}
+
+	// a node with several parents is ordered among the children of the parent with the most children
+	for (auto& kpv : nodes)
+	{
+		auto inputPin = kpv.Key->Pins.FindByPredicate([](const UEdGraphPin* pin) { return pin->Direction == EGPD_Input; });
+		if (inputPin == NULL || (*inputPin)->LinkedTo.Num() == 0)
+			continue;
+
+		const FNodeInfo* bigOwner = NULL;
+		for (auto ownerPin : (*inputPin)->LinkedTo)
+		{
+			auto owner = nodes.Find((UQaDSEdGraphNode*)ownerPin->GetOwningNode());
+			if (owner != NULL && (bigOwner == NULL || owner->Children.Num() > bigOwner->Children.Num()))
+				bigOwner = owner;
+		}
+
+		if (bigOwner == NULL)
+			continue;
+
+		auto lessCount = 0;
+		for (auto sibling : bigOwner->Children)
+		{
+			if (sibling->NodePosX < kpv.Key->NodePosX)
+				lessCount++;
+		}
+
+		kpv.Value.Order = lessCount + 1;
+	}
+
+	for (auto& kpv : nodes)
+	{
+		kpv.Value.OrderedChildren = kpv.Value.Children;
+		kpv.Value.OrderedChildren.Sort([this](const UQaDSEdGraphNode& a, const UQaDSEdGraphNode& b)
+		{
+			auto infoA = nodes.Find(&a);
+			auto infoB = nodes.Find(&b);
+			return (infoA ? infoA->Order : 0) < (infoB ? infoB->Order : 0);
+		});
+	}
+}
\ No newline at end of file
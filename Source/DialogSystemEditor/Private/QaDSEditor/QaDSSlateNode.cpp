@@ -7,6 +7,13 @@
 #include "GraphEditorActions.h"
 #include "RectConnectionDrawingPolicy.h"
 #include "DialogGraphSchema.h"
+#include "QaDSGraphOrderCache.h"
+#include "QaDSSettings.h"
+#include "QaDSEdGraphNode.h"
+#include "QaDSAssetEditor.h"
+#include "Toolkits/AssetEditorManager.h"
+#include "BrushSet.h"
+#include "SGraphPanel.h"
 #include "Runtime/Slate/Public/Framework/MultiBox/MultiBoxBuilder.h"
 
 #define LOCTEXT_NAMESPACE "FQaDSSystemModule"
@@ -63,6 +70,11 @@ void SGraphNode_QaDSNodeBase::Construct(const FArguments& InArgs, UQaDSEdGraphNo
 BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
 void SGraphNode_QaDSNodeBase::UpdateGraphNode()
 {
+	DisplayedOrder = -1;
+	DetailGroups.Reset();
+	bIsDetailBuilt = false;
+	bIsDetailVisible = false;
+
 	InputPins.Empty();
 	OutputPins.Empty();
 
@@ -223,7 +235,9 @@ void SGraphNode_QaDSNodeBase::UpdateGraphNode()
 		];
 
 	CreateNodeWidget();
+	CreateDetailGroups();
 	CreatePinWidgets();
+	UpdateDetailVisibility();
 }
 
 FReply SGraphNode_QaDSNodeBase::OnClickedIcon()
@@ -334,21 +348,134 @@ void SGraphNode_QaDSNodeBase::AddTextToContent(TSharedPtr<SVerticalBox> Containe
 			]
 		];
 }
+
+void SGraphNode_QaDSNodeBase::AddDetailGroup(TSharedPtr<SVerticalBox> Container, const FName& Property, TFunction<void(TSharedPtr<SVerticalBox>)> Fill)
+{
+	FDetailGroup group;
+	group.Property = Property;
+	group.Container = Container;
+	group.Fill = MoveTemp(Fill);
+
+	Container->AddSlot()
+		.HAlign(HAlign_Fill)
+		.VAlign(VAlign_Bottom)
+		.AutoHeight()
+		[
+			SAssignNew(group.Box, SVerticalBox)
+		];
+
+	DetailGroups.Add(MoveTemp(group));
+}
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
+void SGraphNode_QaDSNodeBase::BuildDetailGroup(FDetailGroup& Group)
+{
+	Group.Box->ClearChildren();
+	Group.Fill(Group.Box);
+}
+
+void SGraphNode_QaDSNodeBase::UpdateDetailVisibility()
+{
+	TSet<SVerticalBox*> visibleContainers;
+
+	for (auto& group : DetailGroups)
+	{
+		auto bIsVisible = bIsDetailVisible && group.Box->NumSlots() > 0;
+		group.Box->SetVisibility(bIsVisible ? EVisibility::Visible : EVisibility::Collapsed);
+
+		if (bIsVisible)
+			visibleContainers.Add(group.Container.Get());
+	}
+
+	ConditionsBox->SetVisibility(visibleContainers.Contains(ConditionsBox.Get()) ? EVisibility::Visible : EVisibility::Collapsed);
+	EventsBox->SetVisibility(visibleContainers.Contains(EventsBox.Get()) ? EVisibility::Visible : EVisibility::Collapsed);
+}
+
+bool SGraphNode_QaDSNodeBase::IsDetailZoom() const
+{
+	auto panel = OwnerGraphPanelPtr.Pin();
+	return panel.IsValid() && panel->GetZoomAmount() >= GetDefault<UQaDSSettings>()->NodeDetailZoom;
+}
+
 void SGraphNode_QaDSNodeBase::OnPropertyChanged(UEdGraphNode* Sender, const FName& PropertyName)
 {
-	UpdateGraphNode();
+	NodeWiget->SetText(GraphNode->GetNodeTitle(ENodeTitleType::FullTitle));
+	NodeIcon->SetImage(FBrushSet::Get().GetBrush(GetIcon()));
+
+	if (!bIsDetailBuilt)
+		return;
+
+	auto bIsFound = DetailGroups.ContainsByPredicate([&](const FDetailGroup& group) { return group.Property == PropertyName; });
+
+	// the whole struct was edited, reset or pasted
+	for (auto& group : DetailGroups)
+	{
+		if (!bIsFound || group.Property == PropertyName)
+			BuildDetailGroup(group);
+	}
+
+	UpdateDetailVisibility();
 }
 
 void SGraphNode_QaDSNodeBase::Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float DeltaTime)
 {
 	SGraphNode::Tick(AllottedGeometry, InCurrentTime, DeltaTime);
 
+	// only drawn nodes tick, so detail rows of nodes that were never seen zoomed in are not created
+	auto bIsDetail = IsDetailZoom();
+	if (bIsDetail != bIsDetailVisible)
+	{
+		bIsDetailVisible = bIsDetail;
+
+		if (bIsDetailVisible && !bIsDetailBuilt)
+		{
+			bIsDetailBuilt = true;
+			for (auto& group : DetailGroups)
+				BuildDetailGroup(group);
+		}
+
+		UpdateDetailVisibility();
+	}
+
 	auto order = CastChecked<UQaDSEdGraphNode>(GraphNode)->GetOrder();
+	if (order == DisplayedOrder)
+		return;
 
+	DisplayedOrder = order;
 	OrderDisplayBorder->SetVisibility(order > 0 ? EVisibility::Visible : EVisibility::Hidden);
 	OrderDisplayText->SetText(FText::AsNumber(order));
 }
 
+void SGraphNode_QaDSNodeBase::MoveTo(const FVector2D& NewPosition, FNodeSet& NodeFilter)
+{
+	SGraphNode::MoveTo(NewPosition, NodeFilter);
+	FQaDSGraphOrderCache::Invalidate(GraphNode->GetGraph());
+
+	// parents order their children by position, they have to be bound again
+	auto bHasParents = false;
+	for (auto Pin : GraphNode->Pins)
+	{
+		if (Pin->Direction != EEdGraphPinDirection::EGPD_Input)
+			continue;
+
+		for (auto LinkedPin : Pin->LinkedTo)
+		{
+			if (auto owner = Cast<UQaDSEdGraphNode>(LinkedPin->GetOwningNode()))
+			{
+				owner->MarkCompileDirty();
+				bHasParents = true;
+			}
+		}
+	}
+
+	if (!bHasParents || !GetDefault<UQaDSSettings>()->AutoCompile)
+		return;
+
+	// called on every drag step, the compile request is debounced until the move ends
+	auto asset = GraphNode->GetGraph()->GetOuter();
+	auto editor = static_cast<FQaDSAssetEditor*>(FAssetEditorManager::Get().FindEditorForAsset(asset, false));
+	if (editor != NULL)
+		editor->RequestCompile();
+}
+
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -3,15 +3,96 @@
 #include "SGraphNode.h"
 #include "Runtime/SlateCore/Public/Rendering/DrawElements.h"
 #include "RectConnectionDrawingPolicy.h"
+#include "DialogSystemRuntime.h"
+#include "QaDSSettings.h"
+#include "EdGraph/EdGraph.h"
+
+DECLARE_CYCLE_STAT(TEXT("Wire draw"), STAT_QaDS_WireDraw, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wires drawn"), STAT_QaDS_WiresDrawn, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wires culled"), STAT_QaDS_WiresCulled, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Wire cache hits"), STAT_QaDS_WireCacheHits, STATGROUP_QaDS);
+
+TMap<TWeakObjectPtr<UEdGraph>, FRectConnectionDrawingPolicy::FWireCache> FRectConnectionDrawingPolicy::caches;
 
 FRectConnectionDrawingPolicy::FRectConnectionDrawingPolicy(int32 InBackLayerID, int32 InFrontLayerID, float ZoomFactor, const FSlateRect& InClippingRect, FSlateWindowElementList& InDrawElements, UEdGraph* InGraphObj)
 : FConnectionDrawingPolicy(InBackLayerID, InFrontLayerID, ZoomFactor, InClippingRect, InDrawElements)
 {
+	graph = InGraphObj;
+	bIsLowDetail = ZoomFactor < GetDefault<UQaDSSettings>()->NodeDetailZoom;
 }
 
 void FRectConnectionDrawingPolicy::Draw(TMap<TSharedRef<SWidget>, FArrangedWidget>& InPinGeometries, FArrangedChildren& ArrangedNodes)
 {
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_WireDraw);
+
+	// hovered wires fade over time, so nothing is cached while a pin is hovered
+	if (!graph.IsValid() || HoveredPins.Num() > 0 || ArrangedNodes.Num() == 0)
+	{
+		FConnectionDrawingPolicy::Draw(InPinGeometries, ArrangedNodes);
+		return;
+	}
+
+	auto signature = GetSignature(ArrangedNodes);
+	auto origin = ArrangedNodes[0].Geometry.AbsolutePosition;
+
+	auto cache = caches.Find(graph);
+	if (cache == NULL)
+	{
+		for (auto it = caches.CreateIterator(); it; ++it)
+		{
+			if (!it.Key().IsValid())
+				it.RemoveCurrent();
+		}
+
+		cache = &caches.Add(graph);
+	}
+
+	if (cache->bIsValid && cache->Signature == signature)
+	{
+		INC_DWORD_STAT(STAT_QaDS_WireCacheHits);
+
+		// panning only moves every wire by the same offset
+		auto offset = origin - cache->Origin;
+		for (auto& wire : cache->Wires)
+			DrawWire(wire, offset);
+
+		return;
+	}
+
+	cache->bIsValid = true;
+	cache->Signature = signature;
+	cache->Origin = origin;
+	cache->Wires.Reset();
+
+	activeCache = cache;
 	FConnectionDrawingPolicy::Draw(InPinGeometries, ArrangedNodes);
+	activeCache = NULL;
+}
+
+uint32 FRectConnectionDrawingPolicy::GetSignature(FArrangedChildren& ArrangedNodes) const
+{
+	auto signature = HashCombine(GetTypeHash(ZoomFactor), GetTypeHash(ArrangedNodes.Num()));
+
+	for (int32 i = 0; i < ArrangedNodes.Num(); i++)
+	{
+		auto& arranged = ArrangedNodes[i];
+		auto node = StaticCastSharedRef<SGraphNode>(arranged.Widget)->GetNodeObj();
+		auto size = arranged.Geometry.GetLocalSize();
+
+		signature = HashCombine(signature, PointerHash(node));
+		signature = HashCombine(signature, GetTypeHash(node->NodePosX));
+		signature = HashCombine(signature, GetTypeHash(node->NodePosY));
+		signature = HashCombine(signature, GetTypeHash(size.X));
+		signature = HashCombine(signature, GetTypeHash(size.Y));
+
+		for (auto pin : node->Pins)
+		{
+			for (auto linked : pin->LinkedTo)
+				signature = HashCombine(signature, PointerHash(linked));
+		}
+	}
+
+	return signature;
 }
 
 void FRectConnectionDrawingPolicy::DrawPreviewConnector(const FGeometry& PinGeometry, const FVector2D& StartPoint, const FVector2D& EndPoint, UEdGraphPin* Pin)
@@ -42,7 +123,7 @@ void FRectConnectionDrawingPolicy::DrawSplineWithArrow(const FGeometry& StartGeo
 	auto StartPC = StartGeom.AbsolutePosition + FVector2D(StartSize.X * 0.5f, StartSize.Y * 0.5f);
 	auto StartPE = StartGeom.AbsolutePosition + FVector2D(StartSize.X - padding, StartSize.Y);
 
-	auto EndSize = StartGeom.GetDrawSize();
+	auto EndSize = EndGeom.GetDrawSize();
 	auto EndPS = EndGeom.AbsolutePosition + FVector2D(padding, 0);
 	auto EndPC = EndGeom.AbsolutePosition + FVector2D(EndSize.X * 0.5f, EndSize.Y * 0.5f);
 	auto EndPE = EndGeom.AbsolutePosition + FVector2D(EndSize.X - padding, EndSize.Y);
@@ -57,36 +138,103 @@ void FRectConnectionDrawingPolicy::DrawSplineWithArrow(const FGeometry& StartGeo
 
 void FRectConnectionDrawingPolicy::DrawSplineWithArrow(const FVector2D& StartPoint, const FVector2D& EndPoint, const FConnectionParams& Params)
 {
+	if (activeCache != NULL)
+	{
+		auto& wire = activeCache->Wires[activeCache->Wires.AddDefaulted()];
+		BuildWire(StartPoint, EndPoint, Params, ZoomFactor, wire);
+		DrawWire(wire, FVector2D::ZeroVector);
+		return;
+	}
+
+	FRectWire wire;
+	BuildWire(StartPoint, EndPoint, Params, ZoomFactor, wire);
+	DrawWire(wire, FVector2D::ZeroVector);
+}
+
+void FRectConnectionDrawingPolicy::BuildWire(const FVector2D& StartPoint, const FVector2D& EndPoint, const FConnectionParams& Params, float Zoom, FRectWire& OutWire)
+{
+	OutWire.Points.Reset();
+	OutWire.Color = Params.WireColor;
+	OutWire.Thickness = Params.WireThickness;
+
 	if (StartPoint.Y < EndPoint.Y)
 	{
-		auto CenterLeft = FVector2D(StartPoint.X, StartPoint.Y + (EndPoint.Y - StartPoint.Y) / 2);
-		auto CenterRight = FVector2D(EndPoint.X, StartPoint.Y + (EndPoint.Y - StartPoint.Y) / 2);
+		auto centerY = StartPoint.Y + (EndPoint.Y - StartPoint.Y) / 2;
 
-		DrawConnection(WireLayerID, StartPoint, CenterLeft, Params);
-		DrawConnection(WireLayerID, CenterRight, CenterLeft, Params);
-		DrawConnection(WireLayerID, CenterRight, EndPoint, Params);
+		OutWire.Points.Add(StartPoint);
+		OutWire.Points.Add(FVector2D(StartPoint.X, centerY));
+		OutWire.Points.Add(FVector2D(EndPoint.X, centerY));
+		OutWire.Points.Add(EndPoint);
 	}
 	else if (StartPoint.Y > EndPoint.Y)
 	{
-		auto newParams = FConnectionParams(Params);
-		newParams.WireColor *= 0.3f;
+		OutWire.Color *= 0.3f;
 
-		auto d = 25.0f * ZoomFactor;
+		auto d = 25.0f * Zoom;
 		auto p1 = FVector2D(StartPoint.X, StartPoint.Y + d);
 		auto p2 = FVector2D(EndPoint.X + (StartPoint.X - EndPoint.X) * 0.5f, p1.Y);
 		auto p3 = FVector2D(p2.X, EndPoint.Y - d);
 		auto p4 = FVector2D(EndPoint.X, p3.Y);
 
-		DrawConnection(WireLayerID, StartPoint, p1, newParams);
-		DrawConnection(WireLayerID, p1, p2, newParams);
-		DrawConnection(WireLayerID, p2, p3, newParams);
-		DrawConnection(WireLayerID, p3, p4, newParams);
-		DrawConnection(WireLayerID, p4, EndPoint, newParams);
+		OutWire.Points.Add(StartPoint);
+		OutWire.Points.Add(p1);
+		OutWire.Points.Add(p2);
+		OutWire.Points.Add(p3);
+		OutWire.Points.Add(p4);
+		OutWire.Points.Add(EndPoint);
 	}
 	else
 	{
-		DrawConnection(WireLayerID, StartPoint, EndPoint, Params);
+		OutWire.Points.Add(StartPoint);
+		OutWire.Points.Add(EndPoint);
+	}
+
+	OutWire.Min = StartPoint;
+	OutWire.Max = StartPoint;
+
+	for (auto& point : OutWire.Points)
+	{
+		OutWire.Min = OutWire.Min.ComponentMin(point);
+		OutWire.Max = OutWire.Max.ComponentMax(point);
 	}
+
+	OutWire.Min -= FVector2D(OutWire.Thickness, OutWire.Thickness);
+	OutWire.Max += FVector2D(OutWire.Thickness, OutWire.Thickness);
+}
+
+void FRectConnectionDrawingPolicy::DrawWire(const FRectWire& Wire, const FVector2D& Offset)
+{
+	if (!FSlateRect::DoRectanglesIntersect(FSlateRect(Wire.Min + Offset, Wire.Max + Offset), ClippingRect))
+	{
+		INC_DWORD_STAT(STAT_QaDS_WiresCulled);
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_QaDS_WiresDrawn);
+
+	if (bIsLowDetail)
+	{
+		// segments shorter than a pixel are dropped, unfiltered lines of one layer end up in a single batch
+		linePoints.Reset();
+		for (int32 i = 0; i < Wire.Points.Num(); i++)
+		{
+			auto point = Wire.Points[i] + Offset;
+			if (linePoints.Num() > 1 && FVector2D::DistSquared(linePoints.Last(), point) < 1.0f)
+				linePoints.Last() = point;
+			else
+				linePoints.Add(point);
+		}
+
+		FSlateDrawElement::MakeLines(DrawElementsList, WireLayerID, FPaintGeometry(), linePoints, ESlateDrawEffect::None, Wire.Color, false, Wire.Thickness);
+		return;
+	}
+
+	FConnectionParams params;
+	params.WireColor = Wire.Color;
+	params.WireThickness = Wire.Thickness;
+
+	for (int32 i = 1; i < Wire.Points.Num(); i++)
+		DrawConnection(WireLayerID, Wire.Points[i - 1] + Offset, Wire.Points[i] + Offset, params);
 }
 
 void FRectConnectionDrawingPolicy::DrawConnection(int32 LayerId, const FVector2D& Start, const FVector2D& End, const FConnectionParams& Params)
@@ -2,62 +2,165 @@
 #include "XmlSerealizeHelper.h"
 #include "QaDSEdGraphNode.h"
 #include "XmlFile.h"
+#include "FastXml.h"
 
 FString FXmlWriteNode::GetXml() const
 {
-	auto header = "<?xml version=\"1.0\" encoding=\"UTF - 8\"?>\n";
-	return header + GetXml("");
+	FXmlStreamWriter writer;
+	writer.WriteHeader();
+	writer.WriteNode(*this);
+
+	return writer.GetBuffer();
 }
 
 FString FXmlWriteNode::GetXml(const FString& tab) const
 {
-	FString xml;
+	FXmlStreamWriter writer;
+	writer.SetDepth(tab.Len());
+	writer.WriteNode(*this);
+
+	return writer.GetBuffer();
+}
 
-	if (Childrens.Num() > 0)
+static const TCHAR* GetXmlEntity(TCHAR c)
+{
+	switch (c)
 	{
-		xml = tab + "<" + Tag + ">\n";
+	case '&':  return TEXT("&amp;");
+	case '\"': return TEXT("&quot;");
+	case '\'': return TEXT("&apos;");
+	case '<':  return TEXT("&lt;");
+	case '>':  return TEXT("&gt;");
+	default:   return NULL;
+	}
+}
 
-		for (auto child : Childrens)
-		{
-			xml += child.GetXml(tab + '\t');
-		}
+FString FXmlWriteNode::EncodeString(const FString& input)
+{
+	FString result;
+	result.Reserve(input.Len());
+	AppendEncoded(result, input);
 
-		xml += tab + "</" + Tag + ">\n";
-	}
-	else if (!Content.IsEmpty())
+	return result;
+}
+
+void FXmlWriteNode::AppendEncoded(FString& output, const FString& input)
+{
+	auto data = *input;
+	auto start = 0;
+
+	// plain runs are appended at once
+	for (auto pos = 0; pos < input.Len(); pos++)
 	{
-		auto content = EncodeString(Content);
-		xml += tab + "<" + Tag + ">" + content + "</" + Tag + ">\n";
+		auto entity = GetXmlEntity(data[pos]);
+		if (entity == NULL)
+			continue;
+
+		output.AppendChars(data + start, pos - start);
+		output += entity;
+		start = pos + 1;
 	}
-	else
+
+	output.AppendChars(data + start, input.Len() - start);
+}
+
+/* Stream writer */
+
+FXmlStreamWriter::FXmlStreamWriter(FArchive* InArchive, int32 InFlushSize)
+	: archive(InArchive)
+	, flushSize(InFlushSize)
+{
+	buffer.Reserve(archive ? flushSize + 1024 : flushSize);
+}
+
+FXmlStreamWriter::~FXmlStreamWriter()
+{
+	Flush();
+}
+
+void FXmlStreamWriter::WriteHeader()
+{
+	buffer += TEXT("<?xml version=\"1.0\" encoding=\"UTF - 8\"?>\n");
+}
+
+void FXmlStreamWriter::SetDepth(int32 Depth)
+{
+	openTags.SetNum(Depth);
+}
+
+void FXmlStreamWriter::WriteIndent()
+{
+	for (auto i = 0; i < openTags.Num(); i++)
+		buffer += TEXT('\t');
+}
+
+void FXmlStreamWriter::BeginElement(const FString& Tag)
+{
+	WriteIndent();
+	buffer += TEXT('<');
+	buffer += Tag;
+	buffer += TEXT(">\n");
+
+	openTags.Add(Tag);
+}
+
+void FXmlStreamWriter::EndElement()
+{
+	auto tag = openTags.Pop(false);
+
+	WriteIndent();
+	buffer += TEXT("</");
+	buffer += tag;
+	buffer += TEXT(">\n");
+
+	if (archive != NULL && buffer.Len() >= flushSize)
+		Flush();
+}
+
+void FXmlStreamWriter::WriteElement(const FString& Tag, const FString& Content)
+{
+	WriteIndent();
+	buffer += TEXT('<');
+	buffer += Tag;
+
+	if (Content.IsEmpty())
 	{
-		xml += tab + "<" + Tag + "/>\n";
+		buffer += TEXT("/>\n");
+		return;
 	}
 
-	return xml;
+	buffer += TEXT('>');
+	FXmlWriteNode::AppendEncoded(buffer, Content);
+	buffer += TEXT("</");
+	buffer += Tag;
+	buffer += TEXT(">\n");
 }
 
-FString FXmlWriteNode::EncodeString(const FString& input)
+void FXmlStreamWriter::WriteNode(const FXmlWriteNode& Node)
 {
-	FString result;
-	result = input; // it work? 
-	result.Reset();
-
-	for (auto pos = 0; pos < input.Len(); ++pos)
+	if (Node.Childrens.Num() == 0)
 	{
-		auto c = input[pos];
-		switch (c)
-		{
-		case '&':  result += "&amp;";       break;
-		case '\"': result += "&quot;";      break;
-		case '\'': result += "&apos;";      break;
-		case '<':  result += "&lt;";        break;
-		case '>':  result += "&gt;";        break;
-		default:   result += c; break;
-		}
+		WriteElement(Node.Tag, Node.Content);
+		return;
 	}
 
-	return result;
+	BeginElement(Node.Tag);
+
+	for (auto& child : Node.Childrens)
+		WriteNode(child);
+
+	EndElement();
+}
+
+void FXmlStreamWriter::Flush()
+{
+	if (archive == NULL || buffer.Len() == 0)
+		return;
+
+	FTCHARToUTF8 utf8(*buffer, buffer.Len());
+	archive->Serialize((void*)utf8.Get(), utf8.Length());
+
+	buffer.Reset();
 }
 
 /* Serealize */
@@ -92,39 +195,128 @@ void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<bool>& tuple)
 	node.Childrens.Add(FXmlWriteNode(tuple.Tag, tuple.Value ? "true" : "false"));
 }
 
+/* Import document */
+
+static FString DecodeXmlString(const TCHAR* Input)
+{
+	FString result(Input);
+
+	if (!result.Contains(TEXT("&")))
+		return result;
+
+	result.ReplaceInline(TEXT("&lt;"), TEXT("<"));
+	result.ReplaceInline(TEXT("&gt;"), TEXT(">"));
+	result.ReplaceInline(TEXT("&quot;"), TEXT("\""));
+	result.ReplaceInline(TEXT("&apos;"), TEXT("'"));
+	result.ReplaceInline(TEXT("&amp;"), TEXT("&"));
+
+	return result;
+}
+
+bool FXmlImportDocument::LoadFile(const FString& Path, bool bShowProgress, FText& OutErrorMessage, int32& OutErrorLine)
+{
+	Elements.Reset();
+	openElements.Reset();
+	lastChildren.Reset();
+
+	return FFastXml::ParseXmlFile(this, *Path, NULL, GWarn, bShowProgress, bShowProgress, OutErrorMessage, OutErrorLine);
+}
+
+int32 FXmlImportDocument::FindChild(int32 Parent, FName Tag) const
+{
+	for (auto child = Elements[Parent].FirstChild; child != INDEX_NONE; child = Elements[child].NextSibling)
+	{
+		if (Elements[child].Tag == Tag)
+			return child;
+	}
+
+	return INDEX_NONE;
+}
+
+bool FXmlImportDocument::ProcessXmlDeclaration(const TCHAR* ElementData, int32 XmlFileLineNumber)
+{
+	return true;
+}
+
+bool FXmlImportDocument::ProcessElement(const TCHAR* ElementName, const TCHAR* ElementData, int32 XmlFileLineNumber)
+{
+	auto index = Elements.AddDefaulted();
+	Elements[index].Tag = ElementName;
+	Elements[index].Content = DecodeXmlString(ElementData);
+
+	if (openElements.Num() > 0)
+	{
+		auto parent = openElements.Last();
+		auto& lastChild = lastChildren.Last();
+
+		if (lastChild == INDEX_NONE)
+			Elements[parent].FirstChild = index;
+		else
+			Elements[lastChild].NextSibling = index;
+
+		lastChild = index;
+	}
+
+	openElements.Add(index);
+	lastChildren.Add(INDEX_NONE);
+
+	return true;
+}
+
+bool FXmlImportDocument::ProcessAttribute(const TCHAR* AttributeName, const TCHAR* AttributeValue)
+{
+	return true;
+}
+
+bool FXmlImportDocument::ProcessClose(const TCHAR* Element)
+{
+	auto index = openElements.Pop(false);
+	lastChildren.Pop(false);
+
+	if (openElements.Num() == 1 && OnRootChild)
+		OnRootChild(index);
+
+	return true;
+}
+
+bool FXmlImportDocument::ProcessComment(const TCHAR* Comment)
+{
+	return true;
+}
+
 /* Deserealize */
 
 void operator>>(const FXmlReadNode& node, FString& value)
 {
-	value = node.XmlNode->GetContent();
+	value = node.GetContent();
 }
 
 void operator>>(const FXmlReadNode& node, FName& value)
 {
-	value = *node.XmlNode->GetContent();
+	value = *node.GetContent();
 }
 
 void operator>>(const FXmlReadNode& node, FText& value)
 {
-	value = FText::FromString(node.XmlNode->GetContent());
+	value = FText::FromString(node.GetContent());
 }
 
 void operator>>(const FXmlReadNode& node, int& value)
 {
-	value = FCString::Atoi(*node.XmlNode->GetContent());
+	value = FCString::Atoi(*node.GetContent());
 }
 
 void operator>>(const FXmlReadNode& node, float& value)
 {
-	value = FCString::Atof(*node.XmlNode->GetContent());
+	value = FCString::Atof(*node.GetContent());
 }
 
 void operator>>(const FXmlReadNode& node, bool& value)
 {
-	value = node.XmlNode->GetContent().ToLower() == "true";
+	value = node.GetContent().ToLower() == "true";
 }
 
 void operator>>(const FXmlReadNode& node, UClass*& value)
 {
-	value = FindObject<UClass>(ANY_PACKAGE, *node.XmlNode->GetContent());
+	value = FindObject<UClass>(ANY_PACKAGE, *node.GetContent());
 }
@@ -0,0 +1,178 @@
+#include "DialogSystemEditor.h"
+#include "QuestAssetCompiler.h"
+#include "QuestAsset.h"
+#include "QuestNode.h"
+#include "QuestEditorNodes.h"
+#include "QaDSSettings.h"
+#include "StoryPredicateProfiler.h"
+
+FQuestAssetCompiler::FQuestAssetCompiler(UQuestAsset* InAsset, FCompilerResultsLog& InLog)
+	: FQaDSAssetCompiler(InAsset, InLog), QuestAsset(InAsset)
+{
+}
+
+void FQuestAssetCompiler::BindGraph()
+{
+	auto rootNode = FindRootNode<UQuestRootEdGraphNode>();
+	if (rootNode == NULL)
+	{
+		Log.Error(TEXT("Root node not found"));
+		return;
+	}
+
+	ResetCompile(rootNode);
+	stages.Reset();
+
+	QuestAsset->Nodes.Reset();
+	QuestAsset->RootNode = Compile(rootNode);
+
+	AddStageExpressions();
+}
+
+bool FQuestAssetCompiler::BindNodes(const TArray<UQaDSEdGraphNode*>& DirtyNodes)
+{
+	auto rootNode = FindRootNode<UQuestRootEdGraphNode>();
+	if (rootNode == NULL || !rootNode->IsCompile() || QuestAsset->RootNode != rootNode->NodeGuid)
+		return false;
+
+	stages.Reset();
+
+	for (auto node : DirtyNodes)
+	{
+		node->ResetCompile();
+		Compile(node);
+	}
+
+	// drop stages of deleted nodes
+	TSet<FGuid> compiled;
+	for (auto node : Graph->Nodes)
+	{
+		auto qadsNode = Cast<UQaDSEdGraphNode>(node);
+		if (qadsNode != NULL && qadsNode->IsCompile())
+			compiled.Add(qadsNode->NodeGuid);
+	}
+
+	for (auto it = QuestAsset->Nodes.CreateIterator(); it; ++it)
+	{
+		if (!compiled.Contains(it.Key()))
+		{
+			QuestAsset->Joins.Remove(it.Key());
+			it.RemoveCurrent();
+		}
+	}
+
+	AddStageExpressions();
+	return true;
+}
+
+void FQuestAssetCompiler::AddStageExpressions()
+{
+	// the node map is complete, so pointers into it stay valid until Finish
+	for (auto node : stages)
+	{
+		auto& stage = QuestAsset->Nodes[node->NodeGuid];
+		AddExpression(&stage.Condition, node, stage.Predicate.Num(), "\tIn stage \"" + stage.Caption.ToString() + "\"");
+	}
+}
+
+FGuid FQuestAssetCompiler::Compile(UQaDSEdGraphNode* node)
+{
+	if (node->IsCompile())
+		return node->NodeGuid;
+
+	node->SetCompile();
+	OnNodeCompiled(node);
+
+	FQuestStageInfo stage;
+	stage.UID = node->NodeGuid;
+
+	auto stageNode = Cast<UQuestStageEdGraphNode>(node);
+	if (stageNode != NULL)
+	{
+		stageNode->Stage.UID = node->NodeGuid;
+		stage = stageNode->Stage;
+
+		FString ErrorMessage;
+		for (auto& Event : stage.Action)
+		{
+			if (!Event.Compile(QuestAsset, ErrorMessage))
+			{
+				Error(node, ErrorMessage);
+			}
+		}
+
+		for (auto& Condition : stage.FailedPredicate)
+		{
+			if (!Condition.Compile(QuestAsset, ErrorMessage))
+			{
+				Error(node, ErrorMessage);
+			}
+		}
+
+		for (auto& Condition : stage.WaitPredicate)
+		{
+			if (!Condition.Compile(QuestAsset, ErrorMessage))
+			{
+				Error(node, ErrorMessage);
+			}
+		}
+
+		for (auto& Condition : stage.Predicate)
+		{
+			if (!Condition.Compile(QuestAsset, ErrorMessage))
+			{
+				Error(node, ErrorMessage);
+			}
+		}
+
+		stages.Add(node);
+	}
+
+	auto childs = node->GetOrderedChildNodes();
+
+	FQuestStageJoin joins;
+	for (auto& child : childs)
+	{
+		joins.UIDs.Add(Compile(child));
+	}
+
+	QuestAsset->Nodes.Add(node->NodeGuid, stage);
+	QuestAsset->Joins.Add(node->NodeGuid, joins);
+
+	return node->NodeGuid;
+}
+
+void FQuestAssetCompiler::OnExpressionCompiled(int32 Index, bool bIsEmpty)
+{
+	auto& stage = QuestAsset->Nodes[stages[Index]->NodeGuid];
+	if (GetDefault<UQaDSSettings>()->bReorderPredicatesByProfile && bIsEmpty)
+		FStoryPredicateProfiler::SortPredicates(stage.Predicate, QuestAsset, stage.UID.ToString());
+}
+
+void FQuestAssetCompiler::UpdateUsage()
+{
+	auto& usage = QuestAsset->Usage;
+	usage.Reset();
+
+	for (auto& kpv : QuestAsset->Nodes)
+	{
+		auto& stage = kpv.Value;
+		usage.GiveKeys.Append(stage.GiveKeys);
+		usage.RemoveKeys.Append(stage.RemoveKeys);
+		usage.CheckKeys.Append(stage.CheckHasKeys);
+		usage.CheckKeys.Append(stage.CheckDontHasKeys);
+		usage.CheckKeys.Append(stage.Condition.Keys);
+		usage.CheckKeys.Append(stage.WaitHasKeys);
+		usage.CheckKeys.Append(stage.WaitDontHasKeys);
+		usage.CheckKeys.Append(stage.FailedIfGiveKeys);
+		usage.CheckKeys.Append(stage.FailedIfRemoveKeys);
+
+		for (auto& trigger : stage.WaitTriggers)
+			usage.WaitTriggers.Add(trigger.TriggerName);
+
+		for (auto& trigger : stage.FailedTriggers)
+			usage.WaitTriggers.Add(trigger.TriggerName);
+	}
+
+	usage.Normalize();
+}
\ No newline at end of file
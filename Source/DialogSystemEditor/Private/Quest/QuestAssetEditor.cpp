@@ -18,6 +18,7 @@
 #include "ScopedTransaction.h"
 #include "BrushSet.h"
 #include "QaDSGraphSchema.h"
+#include "QaDSSettings.h"
 
 #define LOCTEXT_NAMESPACE "QuestGraph"
 
@@ -73,8 +74,8 @@ void FQuestAssetEditor::BuildToolbar(FToolBarBuilder &builder)
 
 	builder.AddSeparator();
 	builder.AddToolBarButton(FQuestCommands::Get().Compile, NAME_None, FText::FromString("Compile"), FText::FromString("Compile this Quest"), iconCompile, NAME_None);
-	//builder.AddSeparator(); 
-	//builder.AddToolBarButton(FQuestCommands::Get().Find, NAME_None, FText::FromString("Find"), FText::FromString("Open find Quest"), iconFind, NAME_None);
+	builder.AddSeparator(); 
+	builder.AddToolBarButton(FQuestCommands::Get().Find, NAME_None, FText::FromString("Find"), FText::FromString("Open find Quest"), iconFind, NAME_None);
 	builder.AddSeparator(); 
 	builder.AddToolBarButton(FQuestCommands::Get().Export, NAME_None, FText::FromString("Export"), FText::FromString("Export graph to file"), iconImport, NAME_None);
 	builder.AddToolBarButton(FQuestCommands::Get().Import, NAME_None, FText::FromString("Import"), FText::FromString("Imoprt graph from file"), iconExport, NAME_None);
@@ -83,17 +84,6 @@ void FQuestAssetEditor::BuildToolbar(FToolBarBuilder &builder)
 	FPlayWorldCommands::BuildToolbar(builder);
 }
 
-UQuestRootEdGraphNode* FQuestAssetEditor::GetRootNode()
-{
-	for (auto node : GraphEditor->GetCurrentGraph()->Nodes)
-	{
-		if (auto root = Cast<UQuestRootEdGraphNode>(node))
-			return root;
-	}
-
-	return NULL;
-}
-
 UEdGraph* FQuestAssetEditor::CreateGraphFromAsset()
 {
 	auto CustGraph = NewObject<UEdGraph>(EditedAsset, UEdGraph::StaticClass(), NAME_None, RF_Transactional);
@@ -105,88 +95,4 @@ UEdGraph* FQuestAssetEditor::CreateGraphFromAsset()
 	return CustGraph;
 }
 
-void FQuestAssetEditor::Compile()
-{
-	auto rootNode = GetRootNode();
-	if (rootNode == NULL)
-	{
-		CompileLogResults.Error(TEXT("Root node not found"));
-		return;
-	}
-
-	ResetCompilePhrase(rootNode);
-
-	EditedAsset->Nodes.Reset();
-	EditedAsset->RootNode = Compile(rootNode);
-}
-
-FGuid FQuestAssetEditor::Compile(UQaDSEdGraphNode* node)
-{
-	if (node->IsCompile())
-		return node->NodeGuid;
-
-	node->SetCompile();
-
-	FQuestStageInfo stage;
-	stage.UID = node->NodeGuid;
-
-	auto stageNode = Cast<UQuestStageEdGraphNode>(node);
-	if (stageNode != NULL)
-	{
-		stageNode->Stage.UID = node->NodeGuid;
-		stage = stageNode->Stage;
-
-		FString ErrorMessage;
-		for (auto& Event : stage.Action)
-		{
-			if (!Event.Compile(EditedAsset, ErrorMessage))
-			{
-				CompileLogResults.Error(*(ErrorMessage));
-			}
-		}
-
-		for (auto& Condition : stage.FailedPredicate)
-		{
-			if (!Condition.Compile(EditedAsset, ErrorMessage))
-			{
-				CompileLogResults.Error(*(ErrorMessage));
-			}
-		}
-
-		for (auto& Condition : stage.WaitPredicate)
-		{
-			if (!Condition.Compile(EditedAsset, ErrorMessage))
-			{
-				CompileLogResults.Error(*(ErrorMessage));
-			}
-		}
-
-		for (auto& Condition : stage.Predicate)
-		{
-			if (!Condition.Compile(EditedAsset, ErrorMessage))
-			{
-				CompileLogResults.Error(*(ErrorMessage));
-			}
-		}
-	}
-
-	auto childs = node->GetChildNodes();
-	childs.Sort([](auto& a, auto& b)
-	{
-		return a.GetOrder() < b.GetOrder();
-	});
-
-	FQuestStageJoin joins;
-	for (auto& child : childs)
-	{
-		joins.UIDs.Add(Compile(child));
-	}
-
-	EditedAsset->Nodes.Add(node->NodeGuid, stage);
-	EditedAsset->Joins.Add(node->NodeGuid, joins);
-
-	return node->NodeGuid;
-}
-
-
 #undef LOCTEXT_NAMESPACEw
\ No newline at end of file
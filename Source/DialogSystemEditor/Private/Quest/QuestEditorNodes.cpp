@@ -34,6 +34,7 @@ FXmlWriteNode UQuestStageEdGraphNode::SaveToXml() const
 	node.Append("check_has_keys", Stage.CheckHasKeys);
 	node.Append("check_dont_has_keys", Stage.CheckDontHasKeys);
 	node.Append("predicate", Stage.Predicate);
+	node.Append("condition", Stage.Condition.Expression);
 	node.Append("wait_has_keys", Stage.WaitHasKeys);
 	node.Append("wait_dont_has_keys", Stage.WaitDontHasKeys);
 	node.Append("wait_triggers", Stage.WaitTriggers);
@@ -52,7 +53,7 @@ FXmlWriteNode UQuestStageEdGraphNode::SaveToXml() const
 	return node;
 }
 
-void UQuestStageEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById)
+void UQuestStageEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById)
 {
 	Super::LoadInXml(reader, nodeById);
 
@@ -63,6 +64,7 @@ void UQuestStageEdGraphNode::LoadInXml(FXmlReadNode* reader, const TMap<FString,
 	reader->TryGet("check_has_keys", Stage.CheckHasKeys);
 	reader->TryGet("check_dont_has_keys", Stage.CheckDontHasKeys);
 	reader->TryGet("predicate", Stage.Predicate);
+	reader->TryGet("condition", Stage.Condition.Expression);
 	reader->TryGet("wait_has_keys", Stage.WaitHasKeys);
 	reader->TryGet("wait_dont_has_keys", Stage.WaitDontHasKeys);
 	reader->TryGet("wait_triggers", Stage.WaitTriggers);
@@ -145,10 +147,12 @@ void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<FQuestStageCondition>&
 {
 	node << FXmlWriteTuple<FQuestStageEvent>(tuple.Tag, tuple.Value);
 	node.Childrens.Last().Append("invert", tuple.Value.InvertCondition);
+	node.Childrens.Last().Append("pure", tuple.Value.bIsPure);
 }
 
 void operator>>(const FXmlReadNode& node, FQuestStageCondition& value)
 {
 	node >> (FQuestStageEvent&)value;
 	node.TryGet("invert", value.InvertCondition);
+	node.TryGet("pure", value.bIsPure);
 }
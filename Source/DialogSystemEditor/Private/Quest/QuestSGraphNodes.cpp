@@ -32,7 +32,7 @@ FName SGraphNode_QuestNode::GetIcon() const
 		return "DialogSystem.Feiled";
 	}
 
-	if (node->GetChildNodes().Num() > 1)
+	if (node->GetCachedChildNodes().Num() > 1)
 	{
 		if(node->Stage.ChangeOderActiveStagesState == EQuestCompleteStatus::Skiped)
 			return "DialogSystem.HasOne";
@@ -43,63 +43,109 @@ FName SGraphNode_QuestNode::GetIcon() const
 	return "DialogSystem.Stage";
 }
 
-void SGraphNode_QuestNode::CreateNodeWidget()
+void SGraphNode_QuestNode::CreateDetailGroups()
 {
-	SGraphNode_QaDSNodeBase::CreateNodeWidget();
+	auto stageNode = CastChecked<UQuestStageEdGraphNode>(GraphNode);
 
-	auto& stage = CastChecked<UQuestStageEdGraphNode>(GraphNode)->Stage;
-
-	for (auto key : stage.CheckHasKeys)
-		AddTextToContent(ConditionsBox, TEXT(""), key.ToString(), FColor(170, 255, 0));
-
-	for (auto key : stage.CheckDontHasKeys)
-		AddTextToContent(ConditionsBox, TEXT("!"), key.ToString(), FColor(255, 150, 0));
-
-	for (auto key : stage.Predicate)
-		AddTextToContent(ConditionsBox, TEXT("IF"), key.ToString(), FColor(255, 255, 0));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, CheckHasKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.CheckHasKeys)
+			AddTextToContent(Box, TEXT(""), key.ToString(), FColor(170, 255, 0));
+	});
 
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, CheckDontHasKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.CheckDontHasKeys)
+			AddTextToContent(Box, TEXT("!"), key.ToString(), FColor(255, 150, 0));
+	});
 
-	for (auto key : stage.WaitHasKeys)
-		AddTextToContent(BodyBox, TEXT("Wait give key"), key.ToString(), FColor(170, 255, 0));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, Predicate), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.Predicate)
+			AddTextToContent(Box, TEXT("IF"), key.ToString(), FColor(255, 255, 0));
+	});
 
-	for (auto key : stage.WaitDontHasKeys)
-		AddTextToContent(BodyBox, TEXT("Wait remove key"), key.ToString(), FColor(255, 150, 0));
+	AddDetailGroup(ConditionsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, Condition), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		if (!stageNode->Stage.Condition.Expression.IsEmpty())
+			AddTextToContent(Box, TEXT("IF"), stageNode->Stage.Condition.Expression, FColor(255, 255, 0));
+	});
 
-	for (auto key : stage.WaitPredicate)
-		AddTextToContent(BodyBox, TEXT("Wait"), key.ToString(), FColor(255, 255, 0));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, WaitHasKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.WaitHasKeys)
+			AddTextToContent(Box, TEXT("Wait give key"), key.ToString(), FColor(170, 255, 0));
+	});
 
-	for (auto key : stage.WaitTriggers)
-		AddTextToContent(BodyBox, TEXT("Wait on"), key.ToString(), FColor(255, 255, 0));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, WaitDontHasKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.WaitDontHasKeys)
+			AddTextToContent(Box, TEXT("Wait remove key"), key.ToString(), FColor(255, 150, 0));
+	});
 
-	
-	for (auto key : stage.FailedIfGiveKeys)
-		AddTextToContent(BodyBox, TEXT("Failed if give key"), key.ToString(), FColor(255, 32, 32));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, WaitPredicate), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.WaitPredicate)
+			AddTextToContent(Box, TEXT("Wait"), key.ToString(), FColor(255, 255, 0));
+	});
 
-	for (auto key : stage.FailedIfRemoveKeys)
-		AddTextToContent(BodyBox, TEXT("Failed if remove key"), key.ToString(), FColor(255, 32, 32));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, WaitTriggers), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.WaitTriggers)
+			AddTextToContent(Box, TEXT("Wait on"), key.ToString(), FColor(255, 255, 0));
+	});
 
-	for (auto key : stage.FailedPredicate)
-		AddTextToContent(BodyBox, TEXT("Failed if"), key.ToString(), FColor(255, 32, 32));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, FailedIfGiveKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.FailedIfGiveKeys)
+			AddTextToContent(Box, TEXT("Failed if give key"), key.ToString(), FColor(255, 32, 32));
+	});
 
-	for (auto key : stage.FailedTriggers)
-		AddTextToContent(BodyBox, TEXT("Failed on"), key.ToString(), FColor(255, 32, 32));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, FailedIfRemoveKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.FailedIfRemoveKeys)
+			AddTextToContent(Box, TEXT("Failed if remove key"), key.ToString(), FColor(255, 32, 32));
+	});
 
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, FailedPredicate), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.FailedPredicate)
+			AddTextToContent(Box, TEXT("Failed if"), key.ToString(), FColor(255, 32, 32));
+	});
 
-	if (stage.ChangeQuestState != EQuestCompleteStatus::None)
-		AddTextToContent(EventsBox, TEXT("Change quest state"), "", FColor(0, 170, 255));
+	AddDetailGroup(BodyBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, FailedTriggers), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.FailedTriggers)
+			AddTextToContent(Box, TEXT("Failed on"), key.ToString(), FColor(255, 32, 32));
+	});
 
-	if (stage.ChangeOderActiveStagesState != EQuestCompleteStatus::None)
-		AddTextToContent(EventsBox, TEXT("Change oder stages state"), "", FColor(0, 170, 255));
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, ChangeQuestState), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		if (stageNode->Stage.ChangeQuestState != EQuestCompleteStatus::None)
+			AddTextToContent(Box, TEXT("Change quest state"), "", FColor(0, 170, 255));
+	});
 
-	for (auto key : stage.Action)
-		AddTextToContent(EventsBox, TEXT(""), key.ToString(), FColor(0, 170, 255));
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, ChangeOderActiveStagesState), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		if (stageNode->Stage.ChangeOderActiveStagesState != EQuestCompleteStatus::None)
+			AddTextToContent(Box, TEXT("Change oder stages state"), "", FColor(0, 170, 255));
+	});
 
-	for (auto key : stage.GiveKeys)
-		AddTextToContent(EventsBox, TEXT("+"), key.ToString(), FColor(32, 255, 32));
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, Action), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.Action)
+			AddTextToContent(Box, TEXT(""), key.ToString(), FColor(0, 170, 255));
+	});
 
-	for (auto key : stage.RemoveKeys)
-		AddTextToContent(EventsBox, TEXT("-"), key.ToString(), FColor(255, 32, 32));
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, GiveKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.GiveKeys)
+			AddTextToContent(Box, TEXT("+"), key.ToString(), FColor(32, 255, 32));
+	});
 
-	ConditionsBox->SetVisibility(ConditionsBox->NumSlots() > 0 ? EVisibility::Visible : EVisibility::Collapsed);
-	EventsBox->SetVisibility(EventsBox->NumSlots() > 0 ? EVisibility::Visible : EVisibility::Collapsed);
+	AddDetailGroup(EventsBox, GET_MEMBER_NAME_CHECKED(FQuestStageInfo, RemoveKeys), [this, stageNode](TSharedPtr<SVerticalBox> Box)
+	{
+		for (auto key : stageNode->Stage.RemoveKeys)
+			AddTextToContent(Box, TEXT("-"), key.ToString(), FColor(255, 32, 32));
+	});
 }
\ No newline at end of file
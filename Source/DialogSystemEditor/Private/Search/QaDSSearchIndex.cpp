@@ -0,0 +1,447 @@
+#include "DialogSystemEditor.h"
+#include "QaDSSearchIndex.h"
+#include "DialogSystemRuntime.h"
+#include "AssetRegistryModule.h"
+#include "Containers/Ticker.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectHash.h"
+#include "EdGraph/EdGraph.h"
+#include "DialogAsset.h"
+#include "QuestAsset.h"
+#include "DialogEditorNodes.h"
+#include "QuestEditorNodes.h"
+
+DECLARE_CYCLE_STAT(TEXT("Search index asset"), STAT_QaDS_SearchIndexAsset, STATGROUP_QaDS);
+DECLARE_CYCLE_STAT(TEXT("Search"), STAT_QaDS_Search, STATGROUP_QaDS);
+
+FQaDSSearchIndex* FQaDSSearchIndex::instance = NULL;
+
+FQaDSSearchIndex& FQaDSSearchIndex::Get()
+{
+	if (instance == NULL)
+		instance = new FQaDSSearchIndex();
+
+	return *instance;
+}
+
+void FQaDSSearchIndex::Shutdown()
+{
+	delete instance;
+	instance = NULL;
+}
+
+FQaDSSearchIndex::~FQaDSSearchIndex()
+{
+	if (tickerHandle.IsValid())
+		FTicker::GetCoreTicker().RemoveTicker(tickerHandle);
+
+	if (packageSavedHandle.IsValid())
+		UPackage::PackageSavedEvent.Remove(packageSavedHandle);
+
+	if (bIsStarted && FModuleManager::Get().IsModuleLoaded("AssetRegistry"))
+	{
+		auto& registry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+		registry.OnFilesLoaded().RemoveAll(this);
+		registry.OnAssetAdded().RemoveAll(this);
+		registry.OnAssetRemoved().RemoveAll(this);
+		registry.OnAssetRenamed().RemoveAll(this);
+	}
+}
+
+void FQaDSSearchIndex::Start()
+{
+	if (bIsStarted)
+		return;
+
+	bIsStarted = true;
+
+	auto& registry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	registry.OnAssetAdded().AddRaw(this, &FQaDSSearchIndex::OnAssetAdded);
+	registry.OnAssetRemoved().AddRaw(this, &FQaDSSearchIndex::OnAssetRemoved);
+	registry.OnAssetRenamed().AddRaw(this, &FQaDSSearchIndex::OnAssetRenamed);
+	packageSavedHandle = UPackage::PackageSavedEvent.AddRaw(this, &FQaDSSearchIndex::OnPackageSaved);
+
+	if (registry.IsLoadingAssets())
+		registry.OnFilesLoaded().AddRaw(this, &FQaDSSearchIndex::OnFilesLoaded);
+	else
+		QueueAllAssets();
+}
+
+void FQaDSSearchIndex::QueueAllAssets()
+{
+	auto& registry = FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter filter;
+	filter.ClassNames.Add(UDialogAsset::StaticClass()->GetFName());
+	filter.ClassNames.Add(UQuestAsset::StaticClass()->GetFName());
+
+	TArray<FAssetData> assets;
+	registry.GetAssets(filter, assets);
+
+	for (auto& data : assets)
+		QueueAsset(data);
+}
+
+void FQaDSSearchIndex::QueueAsset(const FAssetData& Data)
+{
+	if (Data.AssetClass != UDialogAsset::StaticClass()->GetFName() && Data.AssetClass != UQuestAsset::StaticClass()->GetFName())
+		return;
+
+	pendingAssets.Add(Data.ObjectPath);
+
+	if (!tickerHandle.IsValid())
+		tickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FQaDSSearchIndex::Tick));
+}
+
+bool FQaDSSearchIndex::Tick(float DeltaTime)
+{
+	// assets can only be loaded on the game thread, so only a few are indexed per frame
+	auto endTime = FPlatformTime::Seconds() + 0.005;
+	auto numIndexed = 0;
+
+	while (pendingAssets.Num() > 0 && FPlatformTime::Seconds() < endTime)
+	{
+		auto it = pendingAssets.CreateIterator();
+		auto path = *it;
+		it.RemoveCurrent();
+
+		auto asset = FSoftObjectPath(path).TryLoad();
+		if (asset != NULL)
+		{
+			IndexAsset(asset);
+			numIndexed++;
+		}
+	}
+
+	if (numIndexed > 0)
+		OnUpdated.Broadcast();
+
+	if (pendingAssets.Num() > 0)
+		return true;
+
+	UE_LOG(DialogModuleLog, Log, TEXT("Search index: %d assets, %d entries, %d words"), assetEntries.Num(), entries.Num() - freeEntries.Num(), tokens.Num());
+
+	tickerHandle.Reset();
+	return false;
+}
+
+void FQaDSSearchIndex::IndexAsset(UObject* Asset)
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_SearchIndexAsset);
+
+	auto path = FName(*Asset->GetPathName());
+	RemoveAsset(path);
+	pendingAssets.Remove(path);
+	assetEntries.Add(path);
+
+	auto dialogAsset = Cast<UDialogAsset>(Asset);
+	if (dialogAsset != NULL)
+	{
+		AddEntry(path, FGuid(), "Name", dialogAsset->Name.ToString());
+		AddGraph(path, dialogAsset->UpdateGraph);
+	}
+
+	auto questAsset = Cast<UQuestAsset>(Asset);
+	if (questAsset != NULL)
+	{
+		AddEntry(path, FGuid(), "Title", questAsset->Title.ToString());
+		AddEntry(path, FGuid(), "Description", questAsset->Description.ToString());
+		AddGraph(path, questAsset->UpdateGraph);
+	}
+}
+
+void FQaDSSearchIndex::AddGraph(const FName& Asset, const UEdGraph* Graph)
+{
+	if (Graph == NULL)
+		return;
+
+	for (auto node : Graph->Nodes)
+	{
+		auto guid = node->NodeGuid;
+
+		auto addKeys = [&](const TArray<FName>& Keys)
+		{
+			for (auto& key : Keys)
+				AddEntry(Asset, guid, "Key", key.ToString());
+		};
+
+		auto phraseNode = Cast<UDialogPhraseEdGraphNode>(node);
+		if (phraseNode != NULL)
+		{
+			auto& data = phraseNode->Data;
+
+			AddEntry(Asset, guid, "Text", data.Text.ToString());
+			AddEntry(Asset, guid, "UID", data.UID.ToString());
+			AddEntry(Asset, guid, "Condition", data.Condition.Expression);
+
+			addKeys(data.CheckHasKeys);
+			addKeys(data.CheckDontHasKeys);
+			addKeys(data.GiveKeys);
+			addKeys(data.RemoveKeys);
+
+			for (auto& predicate : data.Predicate)
+				AddEntry(Asset, guid, "Event", predicate.EventName.ToString());
+
+			for (auto& action : data.Action)
+				AddEntry(Asset, guid, "Event", action.EventName.ToString());
+		}
+
+		auto stageNode = Cast<UQuestStageEdGraphNode>(node);
+		if (stageNode != NULL)
+		{
+			auto& stage = stageNode->Stage;
+
+			AddEntry(Asset, guid, "Caption", stage.Caption.ToString());
+			AddEntry(Asset, guid, "Description", stage.Description.ToString());
+			AddEntry(Asset, guid, "UID", stage.UID.ToString());
+			AddEntry(Asset, guid, "Condition", stage.Condition.Expression);
+
+			addKeys(stage.CheckHasKeys);
+			addKeys(stage.CheckDontHasKeys);
+			addKeys(stage.WaitHasKeys);
+			addKeys(stage.WaitDontHasKeys);
+			addKeys(stage.FailedIfGiveKeys);
+			addKeys(stage.FailedIfRemoveKeys);
+			addKeys(stage.GiveKeys);
+			addKeys(stage.RemoveKeys);
+
+			for (auto predicates : { &stage.Predicate, &stage.WaitPredicate, &stage.FailedPredicate })
+			{
+				for (auto& predicate : *predicates)
+					AddEntry(Asset, guid, "Event", predicate.EventName.ToString());
+			}
+
+			for (auto& action : stage.Action)
+				AddEntry(Asset, guid, "Event", action.EventName.ToString());
+
+			for (auto& trigger : stage.WaitTriggers)
+				AddEntry(Asset, guid, "Trigger", trigger.TriggerName.ToString());
+
+			for (auto& trigger : stage.FailedTriggers)
+				AddEntry(Asset, guid, "Trigger", trigger.TriggerName.ToString());
+		}
+	}
+}
+
+void FQaDSSearchIndex::AddEntry(const FName& Asset, const FGuid& NodeGuid, const FName& Field, const FString& Text)
+{
+	if (Text.IsEmpty() || Text == TEXT("None"))
+		return;
+
+	TArray<FString> words;
+	Tokenize(Text, words);
+
+	if (words.Num() == 0)
+		return;
+
+	auto index = freeEntries.Num() > 0 ? freeEntries.Pop(false) : entries.AddDefaulted();
+	auto& entry = entries[index];
+	entry.Result.Asset = Asset;
+	entry.Result.NodeGuid = NodeGuid;
+	entry.Result.Field = Field;
+	entry.Result.Text = Text;
+	entry.Tokens.Reset();
+	entry.bIsValid = true;
+
+	for (auto& word : words)
+	{
+		auto tokenId = tokenIds.Find(word);
+		if (tokenId == NULL)
+		{
+			tokenId = &tokenIds.Add(word, tokens.Add(word));
+			postings.AddDefaulted();
+			bIsSortDirty = true;
+		}
+
+		entry.Tokens.AddUnique(*tokenId);
+	}
+
+	for (auto tokenId : entry.Tokens)
+		postings[tokenId].Add(index);
+
+	assetEntries.FindOrAdd(Asset).Add(index);
+}
+
+void FQaDSSearchIndex::RemoveAsset(const FName& ObjectPath)
+{
+	auto assetEntry = assetEntries.Find(ObjectPath);
+	if (assetEntry == NULL)
+		return;
+
+	for (auto index : *assetEntry)
+	{
+		auto& entry = entries[index];
+		for (auto tokenId : entry.Tokens)
+			postings[tokenId].Remove(index);
+
+		entry.Tokens.Reset();
+		entry.Result.Text.Empty();
+		entry.bIsValid = false;
+		freeEntries.Add(index);
+	}
+
+	assetEntries.Remove(ObjectPath);
+}
+
+void FQaDSSearchIndex::Search(const FString& Query, TArray<FQaDSSearchResult>& OutResults, int32 MaxResults) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_Search);
+
+	OutResults.Reset();
+
+	TArray<FString> words;
+	Tokenize(Query, words);
+
+	if (words.Num() == 0)
+		return;
+
+	if (bIsSortDirty)
+	{
+		sortedTokens.Reset(tokens.Num());
+		for (int32 i = 0; i < tokens.Num(); i++)
+			sortedTokens.Add(i);
+
+		sortedTokens.Sort([this](int32 a, int32 b) { return tokens[a] < tokens[b]; });
+		bIsSortDirty = false;
+	}
+
+	TSet<int32> matches;
+	for (int32 i = 0; i < words.Num(); i++)
+	{
+		TSet<int32> wordMatches;
+		FindPrefix(words[i], wordMatches);
+
+		matches = i == 0 ? MoveTemp(wordMatches) : matches.Intersect(wordMatches);
+		if (matches.Num() == 0)
+			return;
+	}
+
+	auto found = matches.Array();
+	found.Sort([this](int32 a, int32 b)
+	{
+		auto& resultA = entries[a].Result;
+		auto& resultB = entries[b].Result;
+
+		if (resultA.Asset != resultB.Asset)
+			return resultA.Asset.Compare(resultB.Asset) < 0;
+
+		return resultA.Text < resultB.Text;
+	});
+
+	if (found.Num() > MaxResults)
+		found.SetNum(MaxResults);
+
+	for (auto index : found)
+		OutResults.Add(entries[index].Result);
+}
+
+void FQaDSSearchIndex::FindPrefix(const FString& Prefix, TSet<int32>& OutEntries) const
+{
+	// first token not less than the prefix, tokens starting with it follow
+	auto low = 0;
+	auto high = sortedTokens.Num();
+
+	while (low < high)
+	{
+		auto middle = (low + high) / 2;
+		if (tokens[sortedTokens[middle]] < Prefix)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	for (auto i = low; i < sortedTokens.Num() && tokens[sortedTokens[i]].StartsWith(Prefix); i++)
+		OutEntries.Append(postings[sortedTokens[i]]);
+}
+
+void FQaDSSearchIndex::Tokenize(const FString& Text, TArray<FString>& OutTokens)
+{
+	FString word;
+
+	auto addWord = [&]()
+	{
+		if (word.IsEmpty())
+			return;
+
+		OutTokens.Add(word);
+
+		// story keys are joined with underscores, each part is searchable too
+		if (word.Contains(TEXT("_")))
+		{
+			TArray<FString> parts;
+			word.ParseIntoArray(parts, TEXT("_"));
+			OutTokens.Append(parts);
+		}
+
+		word.Reset();
+	};
+
+	for (auto c : Text)
+	{
+		if (FChar::IsAlnum(c) || c == '_')
+			word.AppendChar(FChar::ToLower(c));
+		else
+			addWord();
+	}
+
+	addWord();
+}
+
+void FQaDSSearchIndex::OnFilesLoaded()
+{
+	QueueAllAssets();
+}
+
+void FQaDSSearchIndex::OnAssetAdded(const FAssetData& Data)
+{
+	// the initial scan is queued at once when it finishes
+	if (FModuleManager::GetModuleChecked<FAssetRegistryModule>("AssetRegistry").Get().IsLoadingAssets())
+		return;
+
+	QueueAsset(Data);
+}
+
+void FQaDSSearchIndex::OnAssetRemoved(const FAssetData& Data)
+{
+	pendingAssets.Remove(Data.ObjectPath);
+
+	if (assetEntries.Contains(Data.ObjectPath))
+	{
+		RemoveAsset(Data.ObjectPath);
+		OnUpdated.Broadcast();
+	}
+}
+
+void FQaDSSearchIndex::OnAssetRenamed(const FAssetData& Data, const FString& OldObjectPath)
+{
+	auto oldPath = FName(*OldObjectPath);
+	pendingAssets.Remove(oldPath);
+
+	if (assetEntries.Contains(oldPath))
+	{
+		RemoveAsset(oldPath);
+		OnUpdated.Broadcast();
+	}
+
+	QueueAsset(Data);
+}
+
+void FQaDSSearchIndex::OnPackageSaved(const FString& PackageFileName, UObject* Outer)
+{
+	auto package = Cast<UPackage>(Outer);
+	if (package == NULL)
+		return;
+
+	auto bIsIndexed = false;
+	ForEachObjectWithOuter(package, [&](UObject* Object)
+	{
+		if (Object->IsA<UDialogAsset>() || Object->IsA<UQuestAsset>())
+		{
+			IndexAsset(Object);
+			bIsIndexed = true;
+		}
+	}, false);
+
+	if (bIsIndexed)
+		OnUpdated.Broadcast();
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+#include "DialogSystemEditor.h"
+#include "QaDSSearchWindow.h"
+#include "QaDSAssetEditor.h"
+
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SOverlay.h"
+#include "Styling/CoreStyle.h"
+#include "SlateOptMacros.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "Widgets/Views/STableRow.h"
+#include "Toolkits/AssetEditorManager.h"
+
+class SQaDSSearchRow : public SMultiColumnTableRow<FQaDSSearchResultPtr>
+{
+	FQaDSSearchResultPtr item;
+
+public:
+	SLATE_BEGIN_ARGS(SQaDSSearchRow){}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, FQaDSSearchResultPtr Item)
+	{
+		item = Item;
+		SMultiColumnTableRow<FQaDSSearchResultPtr>::Construct(FSuperRowType::FArguments(), OwnerTable);
+	}
+
+	virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnName) override
+	{
+		FString text;
+
+		if (ColumnName == "Asset")
+			text = FPackageName::ObjectPathToObjectName(item->Asset.ToString());
+		else if (ColumnName == "Field")
+			text = item->Field.ToString();
+		else if (ColumnName == "Text")
+			text = item->Text;
+
+		return SNew(STextBlock).Text(FText::FromString(text)).ToolTipText(FText::FromString(item->Asset.ToString()));
+	}
+};
+
+SQaDSSearchWindow::~SQaDSSearchWindow()
+{
+	FQaDSSearchIndex::Get().OnUpdated.Remove(indexUpdatedHandle);
+}
+
+BEGIN_SLATE_FUNCTION_BUILD_OPTIMIZATION
+void SQaDSSearchWindow::Construct(const FArguments& InArgs)
+{
+	ChildSlot
+	[
+		SNew(SBorder)
+		.BorderImage(FCoreStyle::Get().GetBrush("ToolPanel.GroupBorder"))
+		[
+			SNew(SOverlay)
+
+			+ SOverlay::Slot()
+			.Padding(4.0f, 2.0f, 4.0f, 2.0f)
+			[
+				SNew(SVerticalBox)
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SAssignNew(searchBox, SSearchBox)
+					.HintText(FText::FromString("Phrase text, UID, key, event or quest caption"))
+					.OnTextChanged(this, &SQaDSSearchWindow::HandleSearch)
+				]
+				+ SVerticalBox::Slot()
+				.Padding(0.0f, 4.0f, 0.0f, 4.0f)
+				[
+					SAssignNew(itemListView, SListView<FQaDSSearchResultPtr>)
+					.ItemHeight(16.0f)
+					.ListItemsSource(&items)
+					.OnGenerateRow(this, &SQaDSSearchWindow::HandleGenerateRow)
+					.OnMouseButtonDoubleClick(this, &SQaDSSearchWindow::HandleDoubleClick)
+					.SelectionMode(ESelectionMode::Single)
+					.HeaderRow
+					(
+						SNew(SHeaderRow)
+						+ SHeaderRow::Column("Asset").DefaultLabel(FText::FromString("Asset")).FillWidth(2.0f)
+						+ SHeaderRow::Column("Field").DefaultLabel(FText::FromString("Field")).FillWidth(1.0f)
+						+ SHeaderRow::Column("Text").DefaultLabel(FText::FromString("Text")).FillWidth(6.0f)
+					)
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+					.Text(this, &SQaDSSearchWindow::GetStatusText)
+				]
+			]
+		]
+	];
+
+	indexUpdatedHandle = FQaDSSearchIndex::Get().OnUpdated.AddSP(this, &SQaDSSearchWindow::UpdateItems);
+	FQaDSSearchIndex::Get().Start();
+}
+END_SLATE_FUNCTION_BUILD_OPTIMIZATION
+
+TSharedRef<ITableRow> SQaDSSearchWindow::HandleGenerateRow(FQaDSSearchResultPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SQaDSSearchRow, OwnerTable, Item);
+}
+
+void SQaDSSearchWindow::UpdateItems()
+{
+	auto startTime = FPlatformTime::Seconds();
+
+	TArray<FQaDSSearchResult> results;
+	FQaDSSearchIndex::Get().Search(searchBox->GetText().ToString(), results);
+
+	searchTime = FPlatformTime::Seconds() - startTime;
+
+	items.Reset();
+	for (auto& result : results)
+		items.Add(MakeShared<FQaDSSearchResult>(result));
+
+	itemListView->RequestListRefresh();
+}
+
+void SQaDSSearchWindow::HandleSearch(const FText& Text)
+{
+	UpdateItems();
+}
+
+void SQaDSSearchWindow::HandleDoubleClick(FQaDSSearchResultPtr Item)
+{
+	auto asset = FSoftObjectPath(Item->Asset).TryLoad();
+	if (asset == NULL)
+		return;
+
+	FAssetEditorManager::Get().OpenEditorForAsset(asset);
+
+	if (!Item->NodeGuid.IsValid())
+		return;
+
+	// dialog and quest assets are always edited by a FQaDSAssetEditor
+	auto editor = static_cast<FQaDSAssetEditor*>(FAssetEditorManager::Get().FindEditorForAsset(asset, true));
+	if (editor != NULL)
+		editor->JumpToNode(Item->NodeGuid);
+}
+
+FText SQaDSSearchWindow::GetStatusText() const
+{
+	auto& index = FQaDSSearchIndex::Get();
+	auto status = FString::Printf(TEXT("%d assets indexed"), index.GetNumIndexed());
+
+	if (index.GetNumPending() > 0)
+		status += FString::Printf(TEXT(", %d pending"), index.GetNumPending());
+
+	if (!searchBox->GetText().IsEmpty())
+		status += FString::Printf(TEXT(", %d results in %.2f ms"), items.Num(), searchTime * 1000.0);
+
+	return FText::FromString(status);
+}
\ No newline at end of file
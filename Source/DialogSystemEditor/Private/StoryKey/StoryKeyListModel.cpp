@@ -0,0 +1,167 @@
+#include "DialogSystemEditor.h"
+#include "StoryKeyListModel.h"
+
+void FStoryKeyListModel::Reset(const TArray<FName>& Keys)
+{
+	keys.Reset(Keys.Num());
+	parts.Reset();
+
+	for (auto& key : Keys)
+		keys.Add(MakeShareable(new FString(key.ToString())));
+
+	keys.Sort([](const TSharedPtr<FString>& a, const TSharedPtr<FString>& b) { return *a < *b; });
+
+	TArray<FString> keyParts;
+	for (auto& key : keys)
+	{
+		keyParts.Reset();
+		GetParts(*key, keyParts);
+
+		for (auto& part : keyParts)
+		{
+			FPart item;
+			item.Text = part;
+			item.Key = key;
+			parts.Add(item);
+		}
+	}
+
+	parts.Sort([](const FPart& a, const FPart& b) { return a.Text < b.Text; });
+}
+
+bool FStoryKeyListModel::Add(const FName& Key)
+{
+	auto text = Key.ToString();
+	auto index = LowerBoundKey(text);
+
+	if (keys.IsValidIndex(index) && *keys[index] == text)
+		return false;
+
+	auto key = MakeShareable(new FString(text));
+	keys.Insert(key, index);
+	AddParts(key);
+
+	return true;
+}
+
+bool FStoryKeyListModel::Remove(const FName& Key)
+{
+	auto text = Key.ToString();
+	auto index = LowerBoundKey(text);
+
+	if (!keys.IsValidIndex(index) || *keys[index] != text)
+		return false;
+
+	RemoveParts(keys[index]);
+	keys.RemoveAt(index);
+
+	return true;
+}
+
+void FStoryKeyListModel::Filter(const FString& Text, TArray<TSharedPtr<FString>>& OutKeys) const
+{
+	OutKeys.Reset();
+
+	if (Text.IsEmpty())
+	{
+		OutKeys = keys;
+		return;
+	}
+
+	for (auto i = LowerBoundKey(Text); i < keys.Num() && keys[i]->StartsWith(Text); i++)
+		OutKeys.Add(keys[i]);
+
+	auto numPrefixed = OutKeys.Num();
+	TSet<FString*> found;
+
+	for (auto& key : OutKeys)
+		found.Add(key.Get());
+
+	for (auto i = LowerBoundPart(Text); i < parts.Num() && parts[i].Text.StartsWith(Text); i++)
+	{
+		if (!found.Contains(parts[i].Key.Get()))
+		{
+			found.Add(parts[i].Key.Get());
+			OutKeys.Add(parts[i].Key);
+		}
+	}
+
+	if (OutKeys.Num() > numPrefixed)
+		OutKeys.Sort([](const TSharedPtr<FString>& a, const TSharedPtr<FString>& b) { return *a < *b; });
+}
+
+int32 FStoryKeyListModel::LowerBoundKey(const FString& Text) const
+{
+	auto low = 0;
+	auto high = keys.Num();
+
+	while (low < high)
+	{
+		auto middle = (low + high) / 2;
+		if (*keys[middle] < Text)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+int32 FStoryKeyListModel::LowerBoundPart(const FString& Text) const
+{
+	auto low = 0;
+	auto high = parts.Num();
+
+	while (low < high)
+	{
+		auto middle = (low + high) / 2;
+		if (parts[middle].Text < Text)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return low;
+}
+
+void FStoryKeyListModel::AddParts(const TSharedPtr<FString>& Key)
+{
+	TArray<FString> keyParts;
+	GetParts(*Key, keyParts);
+
+	for (auto& part : keyParts)
+	{
+		FPart item;
+		item.Text = part;
+		item.Key = Key;
+		parts.Insert(item, LowerBoundPart(part));
+	}
+}
+
+void FStoryKeyListModel::RemoveParts(const TSharedPtr<FString>& Key)
+{
+	TArray<FString> keyParts;
+	GetParts(*Key, keyParts);
+
+	for (auto& part : keyParts)
+	{
+		for (auto i = LowerBoundPart(part); i < parts.Num() && parts[i].Text == part; i++)
+		{
+			if (parts[i].Key == Key)
+			{
+				parts.RemoveAt(i);
+				break;
+			}
+		}
+	}
+}
+
+void FStoryKeyListModel::GetParts(const FString& Key, TArray<FString>& OutParts)
+{
+	// the first part is the key itself, already found by the key prefix
+	TArray<FString> split;
+	Key.ParseIntoArray(split, TEXT("_"));
+
+	for (auto i = 1; i < split.Num(); i++)
+		OutParts.Add(split[i]);
+}
\ No newline at end of file
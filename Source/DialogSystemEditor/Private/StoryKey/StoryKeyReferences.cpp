@@ -0,0 +1,71 @@
+#include "DialogSystemEditor.h"
+#include "StoryKeyReferences.h"
+#include "StoryAssetUsage.h"
+#include "AssetRegistryModule.h"
+#include "DialogAsset.h"
+#include "QuestAsset.h"
+
+void FStoryKeyReferences::Find(const FName& Name, TArray<FStoryKeyReference>& OutReferences)
+{
+	OutReferences.Reset();
+
+	if (Name.IsNone())
+		return;
+
+	auto& registry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	FARFilter filter;
+	filter.ClassNames.Add(UDialogAsset::StaticClass()->GetFName());
+	filter.ClassNames.Add(UQuestAsset::StaticClass()->GetFName());
+
+	TArray<FAssetData> assets;
+	registry.GetAssets(filter, assets);
+
+	FName tags[] =
+	{
+		FStoryAssetUsage::GiveKeysTag,
+		FStoryAssetUsage::CheckKeysTag,
+		FStoryAssetUsage::RemoveKeysTag,
+		FStoryAssetUsage::WaitTriggersTag,
+	};
+
+	for (auto& asset : assets)
+	{
+		for (auto& tag : tags)
+		{
+			FString value;
+			if (!asset.GetTagValue(tag, value) || !FStoryAssetUsage::TagContains(value, Name))
+				continue;
+
+			FStoryKeyReference reference;
+			reference.Asset = asset;
+			reference.Tag = tag;
+			OutReferences.Add(reference);
+		}
+	}
+
+	OutReferences.Sort([](const FStoryKeyReference& a, const FStoryKeyReference& b)
+	{
+		return a.Asset.AssetName.Compare(b.Asset.AssetName) < 0;
+	});
+}
+
+FString FStoryKeyReferences::GetTagDisplayName(const FName& Tag)
+{
+	if (Tag == FStoryAssetUsage::GiveKeysTag)
+		return "Gives";
+
+	if (Tag == FStoryAssetUsage::CheckKeysTag)
+		return "Checks";
+
+	if (Tag == FStoryAssetUsage::RemoveKeysTag)
+		return "Removes";
+
+	if (Tag == FStoryAssetUsage::WaitTriggersTag)
+		return "Waits trigger";
+
+	if (Tag == FStoryAssetUsage::StartQuestsTag)
+		return "Starts quest";
+
+	return Tag.ToString();
+}
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "DialogSystemEditor.h"
 #include "StoryKeyWindow.h"
 #include "StoryInformationManager.h"
+#include "Engine/Engine.h"
 
 #include "FileManager.h"
 #include "FileHelper.h"
@@ -19,6 +20,8 @@
 #include "Widgets/Input/SSearchBox.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Views/SListView.h"
+#include "Toolkits/AssetEditorManager.h"
+#include "Algo/Reverse.h"
 
 #include "Framework/Notifications/NotificationManager.h"
 #include "Widgets/Notifications/SNotificationList.h"
@@ -75,6 +78,13 @@ void SStoryKeyWindow::Construct(const FArguments& InArgs)
 				]
 				+ SVerticalBox::Slot()
 				.AutoHeight()
+				.Padding(0.0f, 0.0f, 0.0f, 4.0f)
+				[
+					SNew(STextBlock)
+					.Text(this, &SStoryKeyWindow::GetCountText)
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
 				[
 					SNew(SHorizontalBox)
 					+ SHorizontalBox::Slot()
@@ -82,6 +92,7 @@ void SStoryKeyWindow::Construct(const FArguments& InArgs)
 					[
 					  	SAssignNew(editKeyTextBox, SEditableTextBox)
 						.HintText(FText::FromString("Enter key name"))
+						.OnTextChanged(this, &SStoryKeyWindow::HandleKeyTextChanged)
 					]
 					+ SHorizontalBox::Slot()
 					.Padding(4.0f, 0.0f, 0.0f, 0.0f)
@@ -99,6 +110,41 @@ void SStoryKeyWindow::Construct(const FArguments& InArgs)
 						.OnClicked(this, &SStoryKeyWindow::HandleRemoveKeyButton)
 					]
 				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.0f, 8.0f, 0.0f, 0.0f)
+				[
+					SNew(STextBlock)
+					.Text(this, &SStoryKeyWindow::GetReferencesText)
+				]
+				+ SVerticalBox::Slot()
+				.FillHeight(0.5f)
+				.Padding(0.0f, 4.0f, 0.0f, 4.0f)
+				[
+					SAssignNew(referenceListView, SListView<FStoryKeyReferencePtr>)
+					.ItemHeight(16.0f)
+					.ListItemsSource(&references)
+					.OnGenerateRow(this, &SStoryKeyWindow::HandleGenerateReferenceRow)
+					.OnMouseButtonDoubleClick(this, &SStoryKeyWindow::HandleReferenceDoubleClick)
+					.SelectionMode(ESelectionMode::Single)
+				]
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(0.0f, 8.0f, 0.0f, 0.0f)
+				[
+					SNew(STextBlock)
+					.Text(FText::FromString("History"))
+				]
+				+ SVerticalBox::Slot()
+				.FillHeight(0.5f)
+				.Padding(0.0f, 4.0f, 0.0f, 4.0f)
+				[
+					SAssignNew(historyListView, SListView<FStoryKeyHistoryItemPtr>)
+					.ItemHeight(16.0f)
+					.ListItemsSource(&history)
+					.OnGenerateRow(this, &SStoryKeyWindow::HandleGenerateHistoryRow)
+					.SelectionMode(ESelectionMode::None)
+				]
 			]
 		]
 	];
@@ -112,13 +158,79 @@ TSharedRef<ITableRow> SStoryKeyWindow::HandleGenerateRow(TSharedPtr<FString> Ite
 	];
 }
 
+TSharedRef<ITableRow> SStoryKeyWindow::HandleGenerateHistoryRow(FStoryKeyHistoryItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<FStoryKeyHistoryItemPtr>, OwnerTable)
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Item->Time.ToString(TEXT("%H:%M:%S"))))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		.Padding(0.0f, 0.0f, 8.0f, 0.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Item->Change))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Item->Key))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(Item->Source))
+		]
+	];
+}
+
+TSharedRef<ITableRow> SStoryKeyWindow::HandleGenerateReferenceRow(FStoryKeyReferencePtr Item, const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(STableRow<FStoryKeyReferencePtr>, OwnerTable)
+	[
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.FillWidth(1.0f)
+		[
+			SNew(STextBlock)
+			.Text(FText::FromName(Item->Asset.AssetName))
+			.ToolTipText(FText::FromName(Item->Asset.ObjectPath))
+		]
+		+ SHorizontalBox::Slot()
+		.AutoWidth()
+		[
+			SNew(STextBlock)
+			.Text(FText::FromString(FStoryKeyReferences::GetTagDisplayName(Item->Tag)))
+		]
+	];
+}
+
 END_SLATE_FUNCTION_BUILD_OPTIMIZATION
 
+static UObject* GetStoryWorldContext()
+{
+	for (auto& context : GEngine->GetWorldContexts())
+	{
+		if (context.WorldType == EWorldType::PIE && context.World() != NULL)
+			return context.World();
+	}
+
+	return NULL;
+}
+
 void SStoryKeyWindow::Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float DeltaTime)
 {
 	SCompoundWidget::Tick(AllottedGeometry, InCurrentTime, DeltaTime);
 
-	auto newKeyManager = UStoryKeyManager::GetStoryKeyManager(NULL);
+	auto newKeyManager = UStoryKeyManager::GetStoryKeyManager(GetStoryWorldContext());
 	if (newKeyManager != NULL && newKeyManager != keyManager)
 	{
 		keyManager = newKeyManager;
@@ -126,8 +238,44 @@ void SStoryKeyWindow::Tick(const FGeometry& AllottedGeometry, double InCurrentTi
 		keyManager->OnKeyRemove.AddSP(this, &SStoryKeyWindow::OnStorageKeyRemove);
 		keyManager->OnKeysLoaded.AddSP(this, &SStoryKeyWindow::OnStorageKeysLoaded);
 
+		bIsReloadPending = true;
+	}
+
+	if (bIsReloadPending)
+	{
+		bIsReloadPending = false;
+		pendingKeys.Reset();
 		UpdateKeys();
 	}
+	else if (pendingKeys.Num() > 0)
+	{
+		for (auto& pending : pendingKeys)
+		{
+			if (pending.bAdd)
+				keyModel.Add(pending.Key);
+			else
+				keyModel.Remove(pending.Key);
+		}
+
+		pendingKeys.Reset();
+		UpdateFilter();
+	}
+
+	if (pendingHistory.Num() > 0)
+	{
+		// newest first
+		const int32 maxHistory = 1000;
+
+		Algo::Reverse(pendingHistory);
+		pendingHistory.Append(history);
+
+		if (pendingHistory.Num() > maxHistory)
+			pendingHistory.SetNum(maxHistory);
+
+		history = MoveTemp(pendingHistory);
+		pendingHistory.Reset();
+		historyListView->RequestListRefresh();
+	}
 }
 
 void SStoryKeyWindow::HandleSelectKey(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo)
@@ -140,27 +288,22 @@ void SStoryKeyWindow::HandleSelectKey(TSharedPtr<FString> NewSelection, ESelectI
 
 void SStoryKeyWindow::UpdateKeys()
 {
-	keys.Reset();
-
-	auto filter = searchBox->GetText().ToString();
-	auto keysRaw = keyManager->GetKeys();
+	if (keyManager == NULL)
+		return;
 
-	keysRaw.Sort([](const FName& a, const FName& b)
-	{
-		return a.Compare(b);
-	});
+	keyModel.Reset(keyManager->GetKeys());
+	UpdateFilter();
+}
 
-	for (auto key : keysRaw)
-	{
-		auto keyStr = key.ToString();
+void SStoryKeyWindow::UpdateFilter()
+{
+	keyModel.Filter(searchBox->GetText().ToString(), keys);
+	keyListView->RequestListRefresh();
+}
 
-		if (filter.IsEmpty() || keyStr.Contains(filter))
-		{
-			keys.Add(MakeShareable(new FString(keyStr)));
-		}
-	}
-	
-	keyListView->RebuildList();
+FText SStoryKeyWindow::GetCountText() const
+{
+	return FText::FromString(FString::Printf(TEXT("%d keys, %d shown, +%d / -%d this session"), keyModel.Num(), keys.Num(), numAdded, numRemoved));
 }
 
 FReply SStoryKeyWindow::HandleExportButton()
@@ -264,25 +407,73 @@ FReply SStoryKeyWindow::HandleRemoveKeyButton()
 
 void SStoryKeyWindow::HandleSearch(const FText& Text)
 {
-	UpdateKeys();
+	UpdateFilter();
+}
+
+void SStoryKeyWindow::HandleKeyTextChanged(const FText& Text)
+{
+	UpdateReferences();
+}
+
+void SStoryKeyWindow::UpdateReferences()
+{
+	referenceKey = *editKeyTextBox->GetText().ToString();
+
+	TArray<FStoryKeyReference> found;
+	FStoryKeyReferences::Find(referenceKey, found);
+
+	references.Reset();
+	for (auto& reference : found)
+		references.Add(MakeShareable(new FStoryKeyReference(reference)));
+
+	referenceListView->RequestListRefresh();
+}
+
+FText SStoryKeyWindow::GetReferencesText() const
+{
+	if (referenceKey.IsNone())
+		return FText::FromString("Enter or select a key to see the dialogs and quests using it");
+
+	return FText::FromString(FString::Printf(TEXT("Used by %d dialogs and quests (compiled assets only)"), references.Num()));
+}
+
+void SStoryKeyWindow::HandleReferenceDoubleClick(FStoryKeyReferencePtr Item)
+{
+	auto asset = Item->Asset.GetAsset();
+	if (asset != NULL)
+		FAssetEditorManager::Get().OpenEditorForAsset(asset);
 }
 
 void SStoryKeyWindow::OnStorageKeyAdd(const FName& StoreKey)
 {
-	LogInfo("Add key: " + StoreKey.ToString());
-	UpdateKeys();
+	pendingKeys.Add({ StoreKey, true });
+	numAdded++;
+	AddHistory("+", StoreKey.ToString());
 }
 
 void SStoryKeyWindow::OnStorageKeyRemove(const FName& StoreKey)
 {
-	LogInfo("Remove key: " + StoreKey.ToString());
-	UpdateKeys();
+	pendingKeys.Add({ StoreKey, false });
+	numRemoved++;
+	AddHistory("-", StoreKey.ToString());
 }
 
 void SStoryKeyWindow::OnStorageKeysLoaded(const TArray<FName>& StoreKeys)
 {
-	LogInfo("Loaded keys");
-	UpdateKeys();
+	bIsReloadPending = true;
+	AddHistory("Load", FString::Printf(TEXT("%d keys"), StoreKeys.Num()));
+}
+
+void SStoryKeyWindow::AddHistory(const FString& Change, const FString& Key)
+{
+	auto item = MakeShareable(new FStoryKeyHistoryItem());
+	item->Time = FDateTime::Now();
+	item->Change = Change;
+	item->Key = Key;
+	// the source is only known while the key manager broadcasts
+	item->Source = FStoryKeyChangeScope::GetSource();
+
+	pendingHistory.Add(item);
 }
 
 void SStoryKeyWindow::LogInfo(const FString& message)
@@ -0,0 +1,108 @@
+#include "DialogSystemEditor.h"
+#include "StoryKeyListModel.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FString JoinKeys(const TArray<TSharedPtr<FString>>& Keys)
+	{
+		FString result;
+		for (auto& key : Keys)
+			result += (result.IsEmpty() ? TEXT("") : TEXT(",")) + *key;
+
+		return result;
+	}
+
+	FString FilterKeys(const FStoryKeyListModel& Model, const FString& Text)
+	{
+		TArray<TSharedPtr<FString>> keys;
+		Model.Filter(Text, keys);
+
+		return JoinKeys(keys);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryKeyListModelAddRemoveTest, "QaDS.Editor.StoryKeyListModel.AddRemove", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStoryKeyListModelAddRemoveTest::RunTest(const FString& Parameters)
+{
+	FStoryKeyListModel model;
+	model.Reset({ TEXT("Key_B"), TEXT("Key_A") });
+
+	TestEqual(TEXT("Reset sorts keys"), JoinKeys(model.GetKeys()), FString(TEXT("Key_A,Key_B")));
+
+	TestTrue(TEXT("Add new key"), model.Add(TEXT("Key_C")));
+	TestFalse(TEXT("Add existing key"), model.Add(TEXT("Key_A")));
+	TestTrue(TEXT("Add first key"), model.Add(TEXT("Door")));
+	TestEqual(TEXT("Added keys stay sorted"), JoinKeys(model.GetKeys()), FString(TEXT("Door,Key_A,Key_B,Key_C")));
+
+	TestFalse(TEXT("Remove missing key"), model.Remove(TEXT("Key_X")));
+	TestTrue(TEXT("Remove key"), model.Remove(TEXT("Key_B")));
+	TestFalse(TEXT("Remove key twice"), model.Remove(TEXT("Key_B")));
+	TestEqual(TEXT("Keys after remove"), JoinKeys(model.GetKeys()), FString(TEXT("Door,Key_A,Key_C")));
+	TestEqual(TEXT("Num"), model.Num(), 3);
+
+	// incremental changes give the same list and index as a full reset
+	FRandomStream random(1234);
+	TSet<FName> names;
+
+	for (auto i = 0; i < 500; i++)
+	{
+		FName name = *FString::Printf(TEXT("Quest_%d_Stage_%d"), random.RandRange(0, 20), random.RandRange(0, 10));
+
+		if (random.FRand() < 0.3f)
+		{
+			auto isRemoved = names.Remove(name) > 0;
+			TestTrue(TEXT("Remove matches the key set"), model.Remove(name) == isRemoved);
+		}
+		else
+		{
+			auto isNew = !names.Contains(name);
+			names.Add(name);
+			TestTrue(TEXT("Add matches the key set"), model.Add(name) == isNew);
+		}
+	}
+
+	names.Add(TEXT("Door"));
+	names.Add(TEXT("Key_A"));
+	names.Add(TEXT("Key_C"));
+
+	FStoryKeyListModel reset;
+	reset.Reset(names.Array());
+
+	TestEqual(TEXT("Incremental keys match reset"), JoinKeys(model.GetKeys()), JoinKeys(reset.GetKeys()));
+
+	for (auto text : { TEXT("Quest_1"), TEXT("Stage"), TEXT("5"), TEXT("1"), TEXT("Key") })
+		TestEqual(FString::Printf(TEXT("Incremental filter '%s' matches reset"), text), FilterKeys(model, text), FilterKeys(reset, text));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryKeyListModelFilterTest, "QaDS.Editor.StoryKeyListModel.Filter", EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FStoryKeyListModelFilterTest::RunTest(const FString& Parameters)
+{
+	FStoryKeyListModel model;
+	model.Reset({ TEXT("Quest_Main_Start"), TEXT("Quest_Side_End"), TEXT("Main_Door"), TEXT("Other") });
+
+	TestEqual(TEXT("Empty filter"), FilterKeys(model, TEXT("")), FString(TEXT("Main_Door,Other,Quest_Main_Start,Quest_Side_End")));
+	TestEqual(TEXT("Key prefix"), FilterKeys(model, TEXT("Quest")), FString(TEXT("Quest_Main_Start,Quest_Side_End")));
+	TestEqual(TEXT("Key and part prefix in key order"), FilterKeys(model, TEXT("Main")), FString(TEXT("Main_Door,Quest_Main_Start")));
+	TestEqual(TEXT("Case insensitive"), FilterKeys(model, TEXT("qu")), FString(TEXT("Quest_Main_Start,Quest_Side_End")));
+	TestEqual(TEXT("Part prefix"), FilterKeys(model, TEXT("En")), FString(TEXT("Quest_Side_End")));
+	TestEqual(TEXT("Part infix does not match"), FilterKeys(model, TEXT("ain")), FString());
+	TestEqual(TEXT("Key found once"), FilterKeys(model, TEXT("S")), FString(TEXT("Quest_Main_Start,Quest_Side_End")));
+
+	model.Remove(TEXT("Quest_Side_End"));
+	TestEqual(TEXT("Removed key parts"), FilterKeys(model, TEXT("End")), FString());
+
+	model.Add(TEXT("Door_End"));
+	TestEqual(TEXT("Added key parts"), FilterKeys(model, TEXT("End")), FString(TEXT("Door_End")));
+	TestEqual(TEXT("Added key prefix"), FilterKeys(model, TEXT("Door")), FString(TEXT("Door_End,Main_Door")));
+
+	return true;
+}
+
+#endif
\ No newline at end of file
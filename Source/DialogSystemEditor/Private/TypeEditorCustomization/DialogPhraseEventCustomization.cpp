@@ -21,6 +21,7 @@
 #include "ScopedTransaction.h"
 #include "Slate/SlateTextureAtlasInterface.h"
 #include "DialogPhraseEventCustomization.h"
+#include "StoryNativeRegistry.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Editor/UnrealEd/Public/Toolkits/AssetEditorManager.h"
 
@@ -58,7 +59,40 @@ void FDialogPhraseEventCustomization::CustomizeHeader(TSharedRef<IPropertyHandle
 void FDialogPhraseEventCustomization::CustomizeChildren(TSharedRef<IPropertyHandle> StructPropertyHandle, IDetailChildrenBuilder& StructBuilder, IPropertyTypeCustomizationUtils& StructCustomizationUtils)
 {
 	StructBuilder.AddProperty(GET_PROPERTY(CallType).ToSharedRef());
-	StructBuilder.AddProperty(GET_PROPERTY(EventName).ToSharedRef());
+	StructBuilder.AddProperty(GET_PROPERTY(EventName).ToSharedRef())
+		.Visibility(TAttribute<EVisibility>(this, &FDialogPhraseEventCustomization::GetEventNameVisibility));
+
+	TArray<FName> names;
+	FStoryNativeRegistry::Get().GetNames(GET_PROPERTY_IN_TYPE(FDialogPhraseCondition, InvertCondition).IsValid(), names);
+
+	nativeNames.Empty();
+	for (auto name : names)
+		nativeNames.Add(MakeShared<FName>(name));
+
+	StructBuilder.AddCustomRow(GET_PROPERTY(EventName)->GetPropertyDisplayName())
+		.Visibility(TAttribute<EVisibility>(this, &FDialogPhraseEventCustomization::GetNativeNameVisibility))
+		.NameContent()
+		[
+			GET_PROPERTY(EventName)->CreatePropertyNameWidget()
+		]
+		.ValueContent()
+		.MinDesiredWidth(250)
+		[
+			SNew(SComboBox<TSharedPtr<FName>>)
+			.OptionsSource(&nativeNames)
+			.OnSelectionChanged(this, &FDialogPhraseEventCustomization::OnNativeNameSelected)
+			.OnGenerateWidget_Lambda([](TSharedPtr<FName> Item)
+			{
+				return SNew(STextBlock)
+					.Text(FText::FromName(*Item))
+					.Font(IDetailLayoutBuilder::GetDetailFont());
+			})
+			[
+				SNew(STextBlock)
+				.Text(this, &FDialogPhraseEventCustomization::GetNativeNameText)
+				.Font(IDetailLayoutBuilder::GetDetailFont())
+			]
+		];
 
 	StructBuilder.AddProperty(GET_PROPERTY(ObjectClass).ToSharedRef())
 		.Visibility(TAttribute<EVisibility>(this, &FDialogPhraseEventCustomization::GetObjectClassVisibility));
@@ -69,33 +103,53 @@ void FDialogPhraseEventCustomization::CustomizeChildren(TSharedRef<IPropertyHand
 	if (GET_PROPERTY_IN_TYPE(FDialogPhraseCondition, InvertCondition).IsValid())
 		StructBuilder.AddProperty(GET_PROPERTY_IN_TYPE(FDialogPhraseCondition, InvertCondition).ToSharedRef());
 
+	if (GET_PROPERTY_IN_TYPE(FDialogPhraseCondition, bIsPure).IsValid())
+		StructBuilder.AddProperty(GET_PROPERTY_IN_TYPE(FDialogPhraseCondition, bIsPure).ToSharedRef());
+
 	UObject* Property_ObjectClass;
 	FName Property_EventName;
 
 	GET_PROPERTY(EventName)->GetValue(Property_EventName);
 	GET_PROPERTY(ObjectClass)->GetValue(Property_ObjectClass);
 
-	if (Property_ObjectClass == NULL)
+	auto array = GET_PROPERTY(Parameters)->AsArray();
+	if (!array.IsValid())
 		return;
 
-	auto func = Cast<UClass>(Property_ObjectClass)->ClassDefaultObject->FindFunction(Property_EventName);
-	auto array = GET_PROPERTY(Parameters)->AsArray();
+	// name and type of each parameter
+	TArray<TPair<FString, FString>> params;
 
-	if (func == NULL || !array.IsValid())
-		return;
+	if (IsNative())
+	{
+		auto native = FStoryNativeRegistry::Get().Find(Property_EventName);
+		if (native == NULL)
+			return;
 
-	uint32 i = 0;
-	for (TFieldIterator<UProperty> PropIt(func); PropIt && (PropIt->PropertyFlags & CPF_Parm); ++PropIt, ++i)
+		for (int32 i = 0; i < native->ParamTypes.Num(); i++)
+			params.Emplace(FString::Printf(TEXT("Param %d"), i), native->ParamTypes[i]);
+	}
+	else
 	{
-		UProperty *Prop = *PropIt;
+		if (Property_ObjectClass == NULL)
+			return;
+
+		auto func = Cast<UClass>(Property_ObjectClass)->ClassDefaultObject->FindFunction(Property_EventName);
+		if (func == NULL)
+			return;
 
-		FText name = FText::FromString(Prop->GetName());
+		for (TFieldIterator<UProperty> PropIt(func); PropIt && (PropIt->PropertyFlags & CPF_Parm); ++PropIt)
+			params.Emplace(PropIt->GetName(), PropIt->GetCPPType());
+	}
+
+	for (int32 i = 0; i < params.Num(); i++)
+	{
+		FText name = FText::FromString(params[i].Key);
 		FString value;
 
 		uint32 arrayLenght;
 		array->GetNumElements(arrayLenght);
 
-		if (i >= arrayLenght)
+		if ((uint32)i >= arrayLenght)
 			break;
 			
 		auto param = array->GetElement(i);
@@ -130,7 +184,7 @@ void FDialogPhraseEventCustomization::CustomizeChildren(TSharedRef<IPropertyHand
 				.FillWidth(1)
 				[
 					SNew(STextBlock)
-					.Text(FText::FromString(Prop->GetCPPType()))
+					.Text(FText::FromString(params[i].Value))
 					.Font(IDetailLayoutBuilder::GetDetailFont())
 				]
 			];
@@ -192,5 +246,52 @@ EVisibility FDialogPhraseEventCustomization::GetObjectClassVisibility() const
 	return Property_CallType != EDialogPhraseEventCallType::DialogScript ? EVisibility::Visible : EVisibility::Collapsed;
 }
 
+EVisibility FDialogPhraseEventCustomization::GetEventNameVisibility() const
+{
+	return IsNative() ? EVisibility::Collapsed : EVisibility::Visible;
+}
+
+EVisibility FDialogPhraseEventCustomization::GetNativeNameVisibility() const
+{
+	return IsNative() ? EVisibility::Visible : EVisibility::Collapsed;
+}
+
+bool FDialogPhraseEventCustomization::IsNative() const
+{
+	EDialogPhraseEventCallType Property_CallType;
+	GET_PROPERTY(CallType)->GetValue((uint8&)Property_CallType);
+
+	return Property_CallType == EDialogPhraseEventCallType::Native;
+}
+
+FText FDialogPhraseEventCustomization::GetNativeNameText() const
+{
+	FName Property_EventName;
+	GET_PROPERTY(EventName)->GetValue(Property_EventName);
+
+	return FText::FromName(Property_EventName);
+}
+
+void FDialogPhraseEventCustomization::OnNativeNameSelected(TSharedPtr<FName> Item, ESelectInfo::Type SelectInfo)
+{
+	if (!Item.IsValid())
+		return;
+
+	auto native = FStoryNativeRegistry::Get().Find(*Item);
+	auto array = GET_PROPERTY(Parameters)->AsArray();
+
+	GET_PROPERTY(EventName)->SetValue(*Item);
+
+	if (native == NULL || !array.IsValid())
+		return;
+
+	array->EmptyArray();
+	for (int32 i = 0; i < native->ParamTypes.Num(); i++)
+	{
+		array->AddItem();
+		array->GetElement(i)->SetValue(FString("0"));
+	}
+}
+
 #undef GET_PROPERTY
 #undef GET_PROPERTY_IN_TYPE
\ No newline at end of file
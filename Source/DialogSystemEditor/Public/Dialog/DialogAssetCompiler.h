@@ -0,0 +1,29 @@
+#pragma once
+
+#include "QaDSAssetCompiler.h"
+
+class UDialogAsset;
+class UDialogNode;
+class UDialogPhraseNode;
+class UDialogEdGraphNode;
+
+class DIALOGSYSTEMEDITOR_API FDialogAssetCompiler : public FQaDSAssetCompiler
+{
+	UDialogAsset* DialogAsset;
+	TArray<UDialogPhraseNode*> phrases;
+
+public:
+	FDialogAssetCompiler(UDialogAsset* InAsset, FCompilerResultsLog& InLog);
+
+protected:
+	virtual void BindGraph() override;
+	virtual bool BindNodes(const TArray<UQaDSEdGraphNode*>& DirtyNodes) override;
+
+	UDialogNode* Compile(UDialogEdGraphNode* Node);
+
+	template<class TNode>
+	TNode* GetCompileNode(UDialogEdGraphNode* Node);
+
+	virtual void OnExpressionCompiled(int32 Index, bool bIsEmpty) override;
+	virtual void UpdateUsage() override;
+};
\ No newline at end of file
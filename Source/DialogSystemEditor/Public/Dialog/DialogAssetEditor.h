@@ -20,10 +20,6 @@ protected:
 	FName GetEditorName() const override;
 
 	UEdGraph* CreateGraphFromAsset();
-	UDialogRootEdGraphNode* GetRootNode();
-
-	void Compile() override;
-	UDialogNode* Compile(UDialogEdGraphNode* Node);
 };
 
 struct DIALOGSYSTEMEDITOR_API FDialogCommands : public TCommands<FDialogCommands>
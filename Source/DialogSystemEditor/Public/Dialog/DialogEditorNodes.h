@@ -38,7 +38,7 @@ public:
 	virtual void AllocateDefaultPins() override;
 	virtual FXmlWriteNode SaveToXml() const override;
 	virtual bool CanUserDeleteNode() const override;
-	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById) override;
+	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById) override;
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 };
 
@@ -55,7 +55,7 @@ public:
 	virtual void AllocateDefaultPins() override;
 	virtual FXmlWriteNode SaveToXml() const override;
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
-	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById) override;
+	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById) override;
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& e) override;
 };
 
@@ -79,7 +79,7 @@ public:
 
 	virtual void AllocateDefaultPins() override;
 	virtual FXmlWriteNode SaveToXml() const override;
-	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById) override;
+	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById) override;
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 };
 
@@ -94,6 +94,6 @@ public:
 
 	virtual void AllocateDefaultPins() override;
 	virtual FXmlWriteNode SaveToXml() const override;
-	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById) override;
+	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById) override;
 	virtual FText GetNodeTitle(ENodeTitleType::Type TitleType) const override;
 };
\ No newline at end of file
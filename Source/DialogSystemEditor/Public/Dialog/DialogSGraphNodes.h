@@ -18,7 +18,7 @@ public:
 	SLATE_END_ARGS()
 
 	virtual void Construct(const FArguments& InArgs, UDialogPhraseEdGraphNode* InNode);
-	virtual void CreateNodeWidget() override;
+	virtual void CreateDetailGroups() override;
 	virtual FName GetIcon() const override;
 	virtual FReply OnClickedIcon() override;
 };
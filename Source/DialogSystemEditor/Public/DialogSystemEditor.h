@@ -16,4 +16,6 @@ public:
 
 private:
 	TSharedRef<class SDockTab> SpawnStoryKeyTab(const class FSpawnTabArgs&);
+	TSharedRef<class SDockTab> SpawnPredicateProfileTab(const class FSpawnTabArgs&);
+	TSharedRef<class SDockTab> SpawnSearchTab(const class FSpawnTabArgs&);
 };
\ No newline at end of file
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "StoryPredicateProfiler.h"
+
+struct FPredicateProfileItem
+{
+	FString Id;
+	FStoryPredicateStats Stats;
+};
+
+typedef TSharedPtr<FPredicateProfileItem> FPredicateProfileItemPtr;
+
+// Shows data recorded with QaDS.ProfilePredicates
+class SPredicateProfileWindow : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SPredicateProfileWindow){}
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+	void UpdateItems();
+
+	FReply HandleReloadButton();
+	FReply HandleResetButton();
+	void HandleSearch(const FText& Text);
+	TSharedRef<ITableRow> HandleGenerateRow(FPredicateProfileItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+private:
+	TArray<FPredicateProfileItemPtr> items;
+
+	TSharedPtr<SSearchBox> searchBox;
+	TSharedPtr<SListView<FPredicateProfileItemPtr>> itemListView;
+};
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "EdGraph/EdGraph.h"
+#include "Editor/UnrealEd/Public/Kismet2/CompilerResultsLog.h"
+#include "StoryConditionExpression.h"
+
+class UEdGraph;
+class UQaDSEdGraphNode;
+
+/*
+	Compiles the edited graph of a dialog or quest asset into its runtime data, without an open editor.
+	Bind creates runtime nodes and resolves events and conditions, it touches UObjects and must run on the game thread.
+	BindDirty does the same only for nodes marked dirty and the nodes linked from them, reusing the compiled objects.
+	CompileExpressions only parses condition strings of one asset, it may run on a worker thread only while nothing else
+	touches the asset (the compile commandlet), the asset editor runs it on the game thread.
+	Finish reports expression errors, reorders predicates by profile and updates the story usage tags, back on the game thread.
+*/
+class DIALOGSYSTEMEDITOR_API FQaDSAssetCompiler
+{
+public:
+	virtual ~FQaDSAssetCompiler() {}
+
+	// runs all steps on the calling thread
+	void Compile();
+
+	void Bind();
+	// falls back to Bind when the graph was not compiled in this session
+	void BindDirty();
+	void CompileExpressions();
+	void Finish();
+
+	UObject* GetAsset() const { return Asset; }
+	FCompilerResultsLog& GetLog() const { return Log; }
+	bool IsFullCompile() const { return bFullCompile; }
+	const TArray<UQaDSEdGraphNode*>& GetCompiledNodes() const { return compiledNodes; }
+	const TMultiMap<UQaDSEdGraphNode*, TSharedRef<FTokenizedMessage>>& GetNodeMessages() const { return nodeMessages; }
+
+	double GetBindTime() const { return bindTime; }
+	double GetExpressionTime() const { return expressionTime; }
+	double GetFinishTime() const { return finishTime; }
+
+	static TSharedPtr<FQaDSAssetCompiler> Create(UObject* Asset, FCompilerResultsLog& Log);
+	static UEdGraph* GetGraph(UObject* Asset);
+
+protected:
+	struct FPendingExpression
+	{
+		FStoryConditionExpression* Expression;
+		UQaDSEdGraphNode* Node;
+		int32 NumPredicates;
+		FString Context;
+		FString ErrorMessage;
+		bool bSuccess;
+	};
+
+	UObject* Asset;
+	UEdGraph* Graph;
+	FCompilerResultsLog& Log;
+	TArray<FPendingExpression> expressions;
+	TArray<UQaDSEdGraphNode*> compiledNodes;
+	TMultiMap<UQaDSEdGraphNode*, TSharedRef<FTokenizedMessage>> nodeMessages;
+	bool bFullCompile;
+	double bindTime;
+	double expressionTime;
+	double finishTime;
+
+	FQaDSAssetCompiler(UObject* InAsset, FCompilerResultsLog& InLog);
+
+	template<class TRootNode>
+	TRootNode* FindRootNode() const
+	{
+		if (Graph == NULL)
+			return NULL;
+
+		for (auto node : Graph->Nodes)
+		{
+			if (auto root = Cast<TRootNode>(node))
+				return root;
+		}
+
+		return NULL;
+	}
+
+	virtual void BindGraph() = 0;
+	// returns false if the previous result can not be patched and the whole graph must be compiled
+	virtual bool BindNodes(const TArray<UQaDSEdGraphNode*>& DirtyNodes) = 0;
+
+	void AddExpression(FStoryConditionExpression* Expression, UQaDSEdGraphNode* Node, int32 NumPredicates, const FString& Context);
+	void ResetCompile(UQaDSEdGraphNode* Node);
+	void OnNodeCompiled(UQaDSEdGraphNode* Node);
+	void Error(UQaDSEdGraphNode* Node, const FString& Message);
+	TArray<UQaDSEdGraphNode*> TakeDirtyNodes();
+
+	// called from Finish for every expression in the order they were added
+	virtual void OnExpressionCompiled(int32 Index, bool bIsEmpty) {}
+	// fills the FStoryAssetUsage of the asset from the compiled data
+	virtual void UpdateUsage() {}
+};
\ No newline at end of file
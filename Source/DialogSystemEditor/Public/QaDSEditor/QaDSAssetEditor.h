@@ -19,6 +19,7 @@ class UEdGraphNode;
 class SGraphEditor;
 class UQaDSEdGraphNode;
 class FXmlFile;
+class FQaDSAssetCompiler;
 
 struct DIALOGSYSTEMEDITOR_API FQaDSAssetEditorTabs
 {
@@ -44,9 +45,14 @@ public:
 	virtual FLinearColor GetWorldCentricTabColorScale() const override;
 	virtual FString GetWorldCentricTabPrefix() const override;
 	void OpenFindWindow();
+	void JumpToNode(const FGuid& NodeGuid);
 	void ImportExecute();
 	void ExportExecute();
 	void CompileExecute();
+	// debounced compile of the changed nodes, used by the auto compile
+	void RequestCompile(bool bFullCompile = false);
+	// runs a requested compile now
+	void FlushCompile();
 
 protected:
 	TSharedPtr<class IMessageLogListing> CompilerResultsListing;
@@ -64,6 +70,14 @@ protected:
 	bool bGraphStateChanged;
 	UEdGraph* EdGraph;
 
+	TMap<TWeakObjectPtr<UEdGraphNode>, TArray<TSharedRef<FTokenizedMessage>>> NodeMessages;
+	FDelegateHandle CompileTickerHandle;
+	FDelegateHandle BeginPIEDelegateHandle;
+	double CompileRequestTime = 0.0;
+	bool bCompileRequested = false;
+	bool bFullCompileRequested = false;
+	bool bIsCompiledOnce = false;
+
 	TSharedRef<SGraphEditor> CreateGraphEditorWidget(UEdGraph* InGraph);
 	TSharedRef<SDockTab> SpawnTab_Viewport(const FSpawnTabArgs& Args);
 	TSharedRef<SDockTab> SpawnTab_CompilerResults(const FSpawnTabArgs& Args);
@@ -90,7 +104,10 @@ protected:
 	void DeleteSelectedDuplicatableNodes();
 	void OnSelectedNodesChanged(const TSet<UObject*>& NewSelection);
 	void OnNodeDoubleClicked(UEdGraphNode* Node); 
-	void ResetCompilePhrase(UQaDSEdGraphNode* Node);
 
-	virtual void Compile() = 0;
+	bool TickCompile(float DeltaTime);
+	void RunCompile(bool bFullCompile);
+	void ReportCompile(const FQaDSAssetCompiler& Compiler);
+	void OnBeginPIE(const bool bIsSimulating);
+	virtual void SaveAsset_Execute() override;
 };
\ No newline at end of file
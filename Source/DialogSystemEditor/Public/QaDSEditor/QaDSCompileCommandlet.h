@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "QaDSCompileCommandlet.generated.h"
+
+/*
+	Recompiles every dialog and quest asset found by the asset registry.
+	UE4Editor-Cmd.exe Project.uproject -run=QaDSCompile [-path=/Game/Story] [-report=File.json] [-save]
+	Without -save assets are only validated. Returns 1 if any asset has compile errors.
+*/
+UCLASS()
+class DIALOGSYSTEMEDITOR_API UQaDSCompileCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UQaDSCompileCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
\ No newline at end of file
@@ -18,22 +18,35 @@ class DIALOGSYSTEMEDITOR_API UQaDSEdGraphNode : public UEdGraphNode
 {
 	GENERATED_BODY()
 
+	// field of the node data struct being edited, passed to the property observer
+	FName changedDataProperty;
+
 public:
 	TSharedPtr<FNodePropertyObserver> PropertyObserver;
 	bool bIsCompile;
+	// set by edits and link changes, the auto compile rebuilds only these nodes
+	bool bIsCompileDirty;
 
 	virtual bool IsCompile() { return bIsCompile; }
 	virtual void ResetCompile() { bIsCompile = false; }
 	virtual void SetCompile() { bIsCompile = true; }
+	void MarkCompileDirty() { bIsCompileDirty = true; }
 
 	//virtual UQaDSEdGraphNode* Compile(UQaDSEdGraphNode* owner) {} //todo:: compile in virtual methods
 	virtual int GetOrder() const;
 	TArray<UQaDSEdGraphNode*> GetChildNodes() const;
+	// cached per graph, see FQaDSGraphOrderCache
+	const TArray<UQaDSEdGraphNode*>& GetCachedChildNodes() const;
+	const TArray<UQaDSEdGraphNode*>& GetOrderedChildNodes() const;
 
 	virtual FXmlWriteNode SaveToXml() const;
-	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FString, UQaDSEdGraphNode*>& nodeById);
+	virtual void LoadInXml(FXmlReadNode* reader, const TMap<FGuid, UQaDSEdGraphNode*>& nodeById);
 
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& e) override;
+	virtual void PostEditChangeChainProperty(struct FPropertyChangedChainEvent& e) override;
+	virtual void PostEditUndo() override;
+	virtual void PinConnectionListChanged(UEdGraphPin* Pin) override;
+	virtual void NodeConnectionListChanged() override;
 };
 
 FORCEINLINE FXmlWriteNode& operator<<(FXmlWriteNode& node, const FXmlWriteTuple<UQaDSEdGraphNode*>& tuple)
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UEdGraph;
+class UQaDSEdGraphNode;
+
+/*
+	Children and sibling order of every node of one graph, rebuilt in a single pass when something changed.
+	Invalidated by pin link changes, node moves, undo and graph add/remove notifications.
+*/
+class DIALOGSYSTEMEDITOR_API FQaDSGraphOrderCache
+{
+public:
+	static FQaDSGraphOrderCache& Get(const UEdGraph* Graph);
+	static void Invalidate(const UEdGraph* Graph);
+
+	int32 GetOrder(const UQaDSEdGraphNode* Node);
+	// children in pin link order
+	const TArray<UQaDSEdGraphNode*>& GetChildren(const UQaDSEdGraphNode* Node);
+	// children sorted by their order
+	const TArray<UQaDSEdGraphNode*>& GetOrderedChildren(const UQaDSEdGraphNode* Node);
+
+	void Invalidate() { bIsValid = false; }
+
+private:
+	struct FNodeInfo
+	{
+		int32 Order = 0;
+		TArray<UQaDSEdGraphNode*> Children;
+		TArray<UQaDSEdGraphNode*> OrderedChildren;
+	};
+
+	TWeakObjectPtr<const UEdGraph> graph;
+	TMap<const UQaDSEdGraphNode*, FNodeInfo> nodes;
+	int32 numGraphNodes = 0;
+	bool bIsValid = false;
+
+	static TMap<TWeakObjectPtr<const UEdGraph>, TSharedPtr<FQaDSGraphOrderCache>> caches;
+
+	const FNodeInfo* Find(const UQaDSEdGraphNode* Node);
+	void Rebuild();
+};
\ No newline at end of file
@@ -32,6 +32,7 @@ class SGraphNode_QaDSNodeBase : public SGraphNode, public FNodePropertyObserver
 	virtual void CreateNodeWidget();
 	virtual void OnPropertyChanged(UEdGraphNode* Sender, const FName& PropertyName) override;
 	virtual void Tick(const FGeometry& AllottedGeometry, double InCurrentTime, float DeltaTime) override;
+	virtual void MoveTo(const FVector2D& NewPosition, FNodeSet& NodeFilter) override;
 
 	TSharedPtr<SHorizontalBox> OutputPinBox;
 	TSharedPtr<SHorizontalBox> InputPinBox;
@@ -42,8 +43,30 @@ class SGraphNode_QaDSNodeBase : public SGraphNode, public FNodePropertyObserver
 	TSharedPtr<SImage> NodeIcon;
 	TSharedPtr<SBorder> OrderDisplayBorder;
 	TSharedPtr<STextBlock> OrderDisplayText;
+	int32 DisplayedOrder = -1;
 	
 	virtual FName GetIcon() const { return ""; }
 	virtual FReply OnClickedIcon();
 	void AddTextToContent(TSharedPtr<SVerticalBox> Container, const FString& Prefix, const FString& Text, const FColor& Color);
+
+protected:
+	// rows showing one property of the node, rebuilt alone when that property changes
+	struct FDetailGroup
+	{
+		FName Property;
+		TSharedPtr<SVerticalBox> Container;
+		TSharedPtr<SVerticalBox> Box;
+		TFunction<void(TSharedPtr<SVerticalBox>)> Fill;
+	};
+
+	TArray<FDetailGroup> DetailGroups;
+	bool bIsDetailBuilt = false;
+	bool bIsDetailVisible = false;
+
+	// declares the detail groups in display order, rows are created when the node is first drawn zoomed in
+	virtual void CreateDetailGroups() {}
+	void AddDetailGroup(TSharedPtr<SVerticalBox> Container, const FName& Property, TFunction<void(TSharedPtr<SVerticalBox>)> Fill);
+	void BuildDetailGroup(FDetailGroup& Group);
+	void UpdateDetailVisibility();
+	bool IsDetailZoom() const;
 };
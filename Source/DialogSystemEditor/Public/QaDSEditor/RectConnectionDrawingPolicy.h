@@ -1,6 +1,17 @@
 #pragma once
 
 #include "ConnectionDrawingPolicy.h"
+#include "UObject/WeakObjectPtr.h"
+
+// one link routed as a polyline in absolute space
+struct FRectWire
+{
+	TArray<FVector2D, TInlineAllocator<6>> Points;
+	FVector2D Min;
+	FVector2D Max;
+	FLinearColor Color;
+	float Thickness;
+};
 
 class FRectConnectionDrawingPolicy : public FConnectionDrawingPolicy
 {
@@ -15,4 +26,27 @@ public:
 	virtual void DrawPreviewConnector(const FGeometry& PinGeometry, const FVector2D& StartPoint, const FVector2D& EndPoint, UEdGraphPin* Pin) override;
 	virtual void DrawConnection(int32 LayerId, const FVector2D& Start, const FVector2D& End, const FConnectionParams& Params) override;
 	// End of FConnectionDrawingPolicy interface
+
+	static void BuildWire(const FVector2D& StartPoint, const FVector2D& EndPoint, const FConnectionParams& Params, float Zoom, FRectWire& OutWire);
+	// skipped when outside of the clipping rect, drawn as one unfiltered line strip when zoomed out
+	void DrawWire(const FRectWire& Wire, const FVector2D& Offset);
+
+private:
+	// wire geometry of the last drawn frame of a graph, reused while no node moved, resized or relinked
+	struct FWireCache
+	{
+		bool bIsValid = false;
+		uint32 Signature = 0;
+		FVector2D Origin;
+		TArray<FRectWire> Wires;
+	};
+
+	static TMap<TWeakObjectPtr<UEdGraph>, FWireCache> caches;
+
+	TWeakObjectPtr<UEdGraph> graph;
+	FWireCache* activeCache = NULL;
+	bool bIsLowDetail = false;
+	TArray<FVector2D> linePoints;
+
+	uint32 GetSignature(FArrangedChildren& ArrangedNodes) const;
 };
@@ -1,15 +1,13 @@
 #pragma once
 
-#include "XmlFile.h"
+#include "FastXml.h"
 #include "DialogNodes.h"
 
-class FXmlNode;
-
 template<typename T>
 struct FXmlWriteTuple
 {
-	FString Tag;
-	T Value;
+	const FString& Tag;
+	const T& Value;
 
 	FXmlWriteTuple(const FString& tag, const T& value) : Tag(tag), Value(value) {}
 };
@@ -29,46 +27,73 @@ public:
 	FString GetXml(const FString& tab) const;
 
 	static FString EncodeString(const FString& input);
+	static void AppendEncoded(FString& output, const FString& input);
 
 	template<typename T>
-	FORCEINLINE void Append(FString tag, T value)
+	FORCEINLINE void Append(const FString& tag, const T& value)
 	{
 		*this << FXmlWriteTuple<T>(tag, value);
 	}
 
 	template<typename T>
-	FORCEINLINE void Append(FString tag, TArray<T> values)
+	FORCEINLINE void Append(const FString& tag, const TArray<T>& values)
 	{
 		if (values.Num() == 0)
 			return;
 
 		auto itemTag = tag.Left(tag.Len() - 1);
 
-		auto node = FXmlWriteNode(tag);
+		auto& node = Childrens[Childrens.Add(FXmlWriteNode(tag))];
+		node.Childrens.Reserve(values.Num());
+
 		for (auto& value : values)
 		{
 			node.Append(itemTag, value);
 		}
-
-		Childrens.Add(node);
 	}
 
 	template<typename T>
-	FORCEINLINE void Append(FString tag, TMap<FName, T> values)
+	FORCEINLINE void Append(const FString& tag, const TMap<FName, T>& values)
 	{
 		if (values.Num() == 0)
 			return;
 
-		auto node = FXmlWriteNode(tag);
+		auto& node = Childrens[Childrens.Add(FXmlWriteNode(tag))];
+		node.Childrens.Reserve(values.Num());
+
 		for (auto& kpv : values)
 		{
 			node.Append(kpv.Key.ToString(), kpv.Value);
 		}
-
-		Childrens.Add(node);
 	}
 };
 
+// Writes xml into a reused buffer, flushed as UTF-8 to the archive when the buffer is full
+class DIALOGSYSTEMEDITOR_API FXmlStreamWriter
+{
+	FArchive* archive;
+	FString buffer;
+	TArray<FString> openTags;
+	int32 flushSize;
+
+	void WriteIndent();
+
+public:
+	// without archive the whole document stays in GetBuffer()
+	FXmlStreamWriter(FArchive* InArchive = NULL, int32 InFlushSize = 64 * 1024);
+	~FXmlStreamWriter();
+
+	void WriteHeader();
+	void BeginElement(const FString& Tag);
+	void EndElement();
+	void WriteElement(const FString& Tag, const FString& Content);
+	void WriteNode(const FXmlWriteNode& Node);
+	void Flush();
+
+	void SetDepth(int32 Depth);
+	const FString& GetBuffer() const { return buffer; }
+};
+
 FORCEINLINE void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<FString>& tuple);
 FORCEINLINE void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<FName>& tuple);
 FORCEINLINE void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<FText>& tuple);
@@ -76,20 +101,63 @@ FORCEINLINE void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<int>& tupl
 FORCEINLINE void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<float>& tuple);
 FORCEINLINE void operator<<(FXmlWriteNode& node, const FXmlWriteTuple<bool>& tuple);
 
+struct FXmlImportElement
+{
+	FName Tag;
+	FString Content;
+	int32 FirstChild = INDEX_NONE;
+	int32 NextSibling = INDEX_NONE;
+};
+
+// Element tree read in one pass with FFastXml, tags are names so child lookup compares ints
+class DIALOGSYSTEMEDITOR_API FXmlImportDocument : public IFastXmlCallback
+{
+	TArray<int32> openElements;
+	TArray<int32> lastChildren;
+
+public:
+	TArray<FXmlImportElement> Elements;
+
+	// called when an element directly under the root element is closed
+	TFunction<void(int32)> OnRootChild;
+
+	// shows a progress dialog for large files
+	bool LoadFile(const FString& Path, bool bShowProgress, FText& OutErrorMessage, int32& OutErrorLine);
+
+	int32 FindChild(int32 Parent, FName Tag) const;
+
+	virtual bool ProcessXmlDeclaration(const TCHAR* ElementData, int32 XmlFileLineNumber) override;
+	virtual bool ProcessElement(const TCHAR* ElementName, const TCHAR* ElementData, int32 XmlFileLineNumber) override;
+	virtual bool ProcessAttribute(const TCHAR* AttributeName, const TCHAR* AttributeValue) override;
+	virtual bool ProcessClose(const TCHAR* Element) override;
+	virtual bool ProcessComment(const TCHAR* Comment) override;
+};
+
 class DIALOGSYSTEMEDITOR_API FXmlReadNode
 {
 public:
-	FXmlNode* XmlNode;
+	const FXmlImportDocument* Document;
+	int32 Element;
+
+	FXmlReadNode() : Document(NULL), Element(INDEX_NONE) {}
+	FXmlReadNode(const FXmlImportDocument* document, int32 element) : Document(document), Element(element) {}
 
-	FXmlReadNode() {}
-	FXmlReadNode(FXmlNode* xmlNode) : XmlNode(xmlNode) {}
+	FORCEINLINE const FString& GetContent() const { return Document->Elements[Element].Content; }
+	FORCEINLINE FName GetTag() const { return Document->Elements[Element].Tag; }
+
+	FORCEINLINE int32 FindChild(const FString& tag) const
+	{
+		// tag that was never parsed can not be in the document
+		FName name(*tag, FNAME_Find);
+		return name.IsNone() ? INDEX_NONE : Document->FindChild(Element, name);
+	}
 
 	FORCEINLINE FString Get(const FString& tag) const
 	{
-		auto xml = XmlNode->FindChildNode(tag);
+		auto xml = FindChild(tag);
 
-		if (xml != NULL)
-			return xml->GetContent();
+		if (xml != INDEX_NONE)
+			return Document->Elements[xml].Content;
 
 		return "";
 	}
@@ -106,25 +174,25 @@ public:
 	template<typename T>
 	FORCEINLINE void TryGet(const FString& tag, T& outValue) const
 	{
-		auto xml = XmlNode->FindChildNode(tag);
+		auto xml = FindChild(tag);
 
-		if (xml != NULL)
-			FXmlReadNode(xml) >> outValue;
+		if (xml != INDEX_NONE)
+			FXmlReadNode(Document, xml) >> outValue;
 	}
 
 	template<typename T>
 	FORCEINLINE void TryGet(const FString& tag, TArray<T>& outValue) const
 	{
-		auto xml = XmlNode->FindChildNode(tag);
+		auto xml = FindChild(tag);
 		outValue.Reset();
 
-		if (xml == NULL)
+		if (xml == INDEX_NONE)
 			return;
 
-		for (auto subXml : xml->GetChildrenNodes())
+		for (auto sub = Document->Elements[xml].FirstChild; sub != INDEX_NONE; sub = Document->Elements[sub].NextSibling)
 		{
 			T item;
-			FXmlReadNode(subXml) >> item;
+			FXmlReadNode(Document, sub) >> item;
 
 			outValue.Add(item);
 		}
@@ -133,18 +201,18 @@ public:
 	template<typename T>
 	FORCEINLINE void TryGet(const FString& tag, TMap<FName, T>& outValue) const
 	{
-		auto xml = XmlNode->FindChildNode(tag);
+		auto xml = FindChild(tag);
 		outValue.Reset();
 
-		if (xml == NULL)
+		if (xml == INDEX_NONE)
 			return;
 
-		for (auto subXml : xml->GetChildrenNodes())
+		for (auto sub = Document->Elements[xml].FirstChild; sub != INDEX_NONE; sub = Document->Elements[sub].NextSibling)
 		{
 			T item;
-			FXmlReadNode(subXml) >> item;
+			FXmlReadNode(Document, sub) >> item;
 
-			outValue.Add(*subXml->GetTag(), item);
+			outValue.Add(Document->Elements[sub].Tag, item);
 		}
 	}
 };
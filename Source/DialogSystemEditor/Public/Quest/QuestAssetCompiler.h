@@ -0,0 +1,24 @@
+#pragma once
+
+#include "QaDSAssetCompiler.h"
+
+class UQuestAsset;
+
+class DIALOGSYSTEMEDITOR_API FQuestAssetCompiler : public FQaDSAssetCompiler
+{
+	UQuestAsset* QuestAsset;
+	TArray<UQaDSEdGraphNode*> stages;
+
+public:
+	FQuestAssetCompiler(UQuestAsset* InAsset, FCompilerResultsLog& InLog);
+
+protected:
+	virtual void BindGraph() override;
+	virtual bool BindNodes(const TArray<UQaDSEdGraphNode*>& DirtyNodes) override;
+	void AddStageExpressions();
+
+	FGuid Compile(UQaDSEdGraphNode* Node);
+
+	virtual void OnExpressionCompiled(int32 Index, bool bIsEmpty) override;
+	virtual void UpdateUsage() override;
+};
\ No newline at end of file
@@ -16,10 +16,6 @@ protected:
 	FName GetEditorName() const override;
 
 	UEdGraph* CreateGraphFromAsset();
-	UQuestRootEdGraphNode* GetRootNode();
-
-	void Compile() override;
-	FGuid Compile(UQaDSEdGraphNode* Node);
 };
 
 struct DIALOGSYSTEMEDITOR_API FQuestCommands : public TCommands<FQuestCommands>
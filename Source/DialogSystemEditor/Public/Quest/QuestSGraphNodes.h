@@ -6,7 +6,7 @@
 class SGraphNode_QuestNode : public SGraphNode_QaDSNodeBase
 {
 public:
-	virtual void CreateNodeWidget() override;
+	virtual void CreateDetailGroups() override;
 	virtual FName GetIcon() const override;
 };
 
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+class UEdGraph;
+
+struct DIALOGSYSTEMEDITOR_API FQaDSSearchResult
+{
+	// object path of the dialog or quest asset
+	FName Asset;
+	// graph node, invalid for asset properties
+	FGuid NodeGuid;
+	FName Field;
+	FString Text;
+};
+
+/*
+	Inverted index of phrase text, UIDs, story keys, events and quest captions of every dialog and quest asset.
+	Assets are loaded and indexed a few at a time on the editor ticker, saved, renamed and removed assets are updated.
+*/
+class DIALOGSYSTEMEDITOR_API FQaDSSearchIndex
+{
+public:
+	static FQaDSSearchIndex& Get();
+	static void Shutdown();
+
+	// queues every dialog and quest asset of the project, only the first call does anything
+	void Start();
+
+	// entries containing a word starting with each word of the query
+	void Search(const FString& Query, TArray<FQaDSSearchResult>& OutResults, int32 MaxResults = 1000) const;
+
+	void IndexAsset(UObject* Asset);
+	void RemoveAsset(const FName& ObjectPath);
+
+	int32 GetNumIndexed() const { return assetEntries.Num(); }
+	int32 GetNumPending() const { return pendingAssets.Num(); }
+
+	// broadcast after assets were indexed or removed
+	FSimpleMulticastDelegate OnUpdated;
+
+	~FQaDSSearchIndex();
+
+private:
+	struct FEntry
+	{
+		FQaDSSearchResult Result;
+		TArray<int32> Tokens;
+		bool bIsValid = false;
+	};
+
+	TArray<FEntry> entries;
+	TArray<int32> freeEntries;
+	TMap<FName, TArray<int32>> assetEntries;
+
+	TMap<FString, int32> tokenIds;
+	TArray<FString> tokens;
+	TArray<TArray<int32>> postings;
+	// token ids sorted by token, for prefix lookups
+	mutable TArray<int32> sortedTokens;
+	mutable bool bIsSortDirty = false;
+
+	TSet<FName> pendingAssets;
+	FDelegateHandle tickerHandle;
+	FDelegateHandle packageSavedHandle;
+	bool bIsStarted = false;
+	bool bIsChanged = false;
+
+	static FQaDSSearchIndex* instance;
+
+	void QueueAsset(const FAssetData& Data);
+	void QueueAllAssets();
+	bool Tick(float DeltaTime);
+	void AddGraph(const FName& Asset, const UEdGraph* Graph);
+	void AddEntry(const FName& Asset, const FGuid& NodeGuid, const FName& Field, const FString& Text);
+	void FindPrefix(const FString& Prefix, TSet<int32>& OutEntries) const;
+
+	void OnFilesLoaded();
+	void OnAssetAdded(const FAssetData& Data);
+	void OnAssetRemoved(const FAssetData& Data);
+	void OnAssetRenamed(const FAssetData& Data, const FString& OldObjectPath);
+	void OnPackageSaved(const FString& PackageFileName, UObject* Outer);
+
+	static void Tokenize(const FString& Text, TArray<FString>& OutTokens);
+};
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/DeclarativeSyntaxSupport.h"
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Text/STextBlock.h"
+#include "QaDSSearchIndex.h"
+
+typedef TSharedPtr<FQaDSSearchResult> FQaDSSearchResultPtr;
+
+// Project wide search over FQaDSSearchIndex, double click opens the asset at the node
+class SQaDSSearchWindow : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SQaDSSearchWindow){}
+	SLATE_END_ARGS()
+
+	~SQaDSSearchWindow();
+
+	void Construct(const FArguments& InArgs);
+	void UpdateItems();
+
+	void HandleSearch(const FText& Text);
+	void HandleDoubleClick(FQaDSSearchResultPtr Item);
+	FText GetStatusText() const;
+	TSharedRef<ITableRow> HandleGenerateRow(FQaDSSearchResultPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+
+private:
+	TArray<FQaDSSearchResultPtr> items;
+	double searchTime = 0.0;
+	FDelegateHandle indexUpdatedHandle;
+
+	TSharedPtr<SSearchBox> searchBox;
+	TSharedPtr<SListView<FQaDSSearchResultPtr>> itemListView;
+};
\ No newline at end of file
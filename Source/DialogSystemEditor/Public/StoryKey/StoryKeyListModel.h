@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Story keys kept sorted between changes, with a prefix index over whole keys and their underscore separated parts
+class FStoryKeyListModel
+{
+public:
+	void Reset(const TArray<FName>& Keys);
+	bool Add(const FName& Key);
+	bool Remove(const FName& Key);
+
+	int32 Num() const { return keys.Num(); }
+	const TArray<TSharedPtr<FString>>& GetKeys() const { return keys; }
+
+	// keys starting with the text, or with a part starting with it, in key order
+	void Filter(const FString& Text, TArray<TSharedPtr<FString>>& OutKeys) const;
+
+private:
+	struct FPart
+	{
+		FString Text;
+		TSharedPtr<FString> Key;
+	};
+
+	TArray<TSharedPtr<FString>> keys;
+	TArray<FPart> parts;
+
+	int32 LowerBoundKey(const FString& Text) const;
+	int32 LowerBoundPart(const FString& Text) const;
+	void AddParts(const TSharedPtr<FString>& Key);
+	void RemoveParts(const TSharedPtr<FString>& Key);
+
+	static void GetParts(const FString& Key, TArray<FString>& OutParts);
+};
\ No newline at end of file
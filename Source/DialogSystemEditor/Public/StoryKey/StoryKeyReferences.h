@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetData.h"
+
+struct FStoryKeyReference
+{
+	FAssetData Asset;
+	// one of the FStoryAssetUsage tags
+	FName Tag;
+};
+
+typedef TSharedPtr<FStoryKeyReference> FStoryKeyReferencePtr;
+
+// Dialogs and quests using a story key or trigger, read from asset registry tags without loading any asset
+class DIALOGSYSTEMEDITOR_API FStoryKeyReferences
+{
+public:
+	static void Find(const FName& Name, TArray<FStoryKeyReference>& OutReferences);
+	static FString GetTagDisplayName(const FName& Tag);
+};
\ No newline at end of file
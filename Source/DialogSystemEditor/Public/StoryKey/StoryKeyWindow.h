@@ -3,6 +3,20 @@
 #include "CoreMinimal.h"
 #include "Widgets/DeclarativeSyntaxSupport.h"
 #include "Widgets/SCompoundWidget.h"
+#include "StoryKeyReferences.h"
+#include "StoryKeyListModel.h"
+
+struct FStoryKeyHistoryItem
+{
+	FDateTime Time;
+	// "+", "-" or "Load"
+	FString Change;
+	FString Key;
+	// FStoryKeyChangeScope active when the key changed
+	FString Source;
+};
+
+typedef TSharedPtr<FStoryKeyHistoryItem> FStoryKeyHistoryItemPtr;
 
 class SStoryKeyWindow : public SCompoundWidget
 {
@@ -11,7 +25,9 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+	// rebuilds the key model from the key manager
 	void UpdateKeys();
+	void UpdateFilter();
 
 	FReply HandleImportButton();
 	FReply HandleExportButton();
@@ -20,6 +36,13 @@ public:
 	void HandleSearch(const FText& Text);
 	void HandleSelectKey(TSharedPtr<FString> NewSelection, ESelectInfo::Type SelectInfo);
 	TSharedRef<ITableRow> HandleGenerateRow(TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void HandleKeyTextChanged(const FText& Text);
+	void UpdateReferences();
+	FText GetReferencesText() const;
+	TSharedRef<ITableRow> HandleGenerateReferenceRow(FStoryKeyReferencePtr Item, const TSharedRef<STableViewBase>& OwnerTable);
+	void HandleReferenceDoubleClick(FStoryKeyReferencePtr Item);
+	FText GetCountText() const;
+	TSharedRef<ITableRow> HandleGenerateHistoryRow(FStoryKeyHistoryItemPtr Item, const TSharedRef<STableViewBase>& OwnerTable);
 
 	void OnStorageKeyAdd(const FName& StoreKey);
 	void OnStorageKeyRemove(const FName& StoreKey);
@@ -30,9 +53,31 @@ private:
 	class UStoryKeyManager* keyManager;
 	TArray<TSharedPtr<FString>> keys;
 
+	// key changes are collected from the key manager events and applied once per frame
+	struct FPendingKey
+	{
+		FName Key;
+		bool bAdd;
+	};
+
+	FStoryKeyListModel keyModel;
+	TArray<FPendingKey> pendingKeys;
+	bool bIsReloadPending = false;
+	int32 numAdded = 0;
+	int32 numRemoved = 0;
+
+	TArray<FStoryKeyHistoryItemPtr> history;
+	TArray<FStoryKeyHistoryItemPtr> pendingHistory;
+	TSharedPtr<SListView<FStoryKeyHistoryItemPtr>> historyListView;
+
 	TSharedPtr<SSearchBox> searchBox;
 	TSharedPtr<SEditableTextBox> editKeyTextBox;
 	TSharedPtr<SListView<TSharedPtr<FString>>> keyListView;
 
+	FName referenceKey;
+	TArray<FStoryKeyReferencePtr> references;
+	TSharedPtr<SListView<FStoryKeyReferencePtr>> referenceListView;
+
 	void LogInfo(const FString& message);
+	void AddHistory(const FString& Change, const FString& Key);
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 class DIALOGSYSTEMEDITOR_API FDialogPhraseEventCustomization : public IPropertyTypeCustomization
 {
 	TSharedPtr<IPropertyHandle> StructPropertyHandle;
+	TArray<TSharedPtr<FName>> nativeNames;
 
 public:
 	static TSharedRef<IPropertyTypeCustomization> MakeInstance();
@@ -17,5 +18,11 @@ public:
 
 	EVisibility GetFingTagVisibility() const;
 	EVisibility GetObjectClassVisibility() const;
+	EVisibility GetEventNameVisibility() const;
+	EVisibility GetNativeNameVisibility() const;
+
+	bool IsNative() const;
+	FText GetNativeNameText() const;
+	void OnNativeNameSelected(TSharedPtr<FName> Item, ESelectInfo::Type SelectInfo);
 	FText GetTitleText() const;
 };
\ No newline at end of file
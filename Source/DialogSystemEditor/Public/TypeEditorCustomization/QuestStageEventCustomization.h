@@ -6,6 +6,7 @@
 class DIALOGSYSTEMEDITOR_API FQuestStageEventCustomization : public IPropertyTypeCustomization
 {
 	TSharedPtr<IPropertyHandle> StructPropertyHandle;
+	TArray<TSharedPtr<FName>> nativeNames;
 
 public:
 	static TSharedRef<IPropertyTypeCustomization> MakeInstance();
@@ -19,4 +20,10 @@ public:
 	FText GetTitleText() const;
 	EVisibility GetFingTagVisibility() const;
 	EVisibility GetObjectClassVisibility() const;
+	EVisibility GetEventNameVisibility() const;
+	EVisibility GetNativeNameVisibility() const;
+
+	bool IsNative() const;
+	FText GetNativeNameText() const;
+	void OnNativeNameSelected(TSharedPtr<FName> Item, ESelectInfo::Type SelectInfo);
 };
\ No newline at end of file
@@ -2,6 +2,15 @@
 #include "DialogAsset.h"
 #include "DialogNodes.h"
 
+void UDialogAsset::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
+{
+	Super::GetAssetRegistryTags(OutTags);
+
+#if WITH_EDITORONLY_DATA
+	Usage.GetAssetRegistryTags(OutTags);
+#endif
+}
+
 UDialogPhraseNode* UDialogAsset::FindPhraseByUID(const FName& UID) const
 {
 	TArray<UDialogNode*> visitList;
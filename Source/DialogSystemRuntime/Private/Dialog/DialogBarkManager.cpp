@@ -0,0 +1,242 @@
+#include "DialogSystemRuntime.h"
+#include "DialogBarkManager.h"
+#include "DialogProcessor.h"
+#include "DialogNodes.h"
+#include "DialogAsset.h"
+#include "StoryContext.h"
+#include "StoryInformationManager.h"
+#include "QaDSSettings.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Bark request"), STAT_QaDS_BarkRequest, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active barks"), STAT_QaDS_ActiveBarks, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Barks played"), STAT_QaDS_BarksPlayed, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Barks rejected"), STAT_QaDS_BarksRejected, STATGROUP_QaDS);
+
+UDialogBarkManager* UDialogBarkManager::GetBarkManager(UObject* WorldContextObject)
+{
+	auto context = UStoryContext::GetStoryContext(WorldContextObject);
+	return context ? context->BarkManager : NULL;
+}
+
+EDialogBarkResult UDialogBarkManager::TryBark(UDialogAsset* Dialog, AActor* NPC, AActor* Player)
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_BarkRequest);
+
+	auto settings = GetDefault<UQaDSSettings>();
+	auto result = EDialogBarkResult::Played;
+
+	// cheapest checks first, phrase conditions may call into game code
+	auto cooldownEnd = NPC ? cooldowns.Find(NPC) : NULL;
+	auto context = Cast<UStoryContext>(GetOuter());
+	auto listener = Player ? Player : (context ? (AActor*)context->GetPlayerPawn() : NULL);
+
+	if (Dialog == NULL || Dialog->RootNode == NULL || NPC == NULL)
+	{
+		result = EDialogBarkResult::NoValidPhrase;
+	}
+	else if ((cooldownEnd != NULL && *cooldownEnd > currentTime) || IsBarking(NPC))
+	{
+		result = EDialogBarkResult::Cooldown;
+	}
+	else if (activeBarks.Num() >= settings->MaxConcurrentBarks)
+	{
+		result = EDialogBarkResult::LimitReached;
+	}
+	else if (listener != NULL && FVector::DistSquared(listener->GetActorLocation(), NPC->GetActorLocation()) > FMath::Square(settings->MaxBarkDistance))
+	{
+		result = EDialogBarkResult::TooFar;
+	}
+
+	auto phrase = result == EDialogBarkResult::Played ? FindPhrase(Dialog, NPC, Player) : NULL;
+
+	if (result == EDialogBarkResult::Played && phrase == NULL)
+		result = EDialogBarkResult::NoValidPhrase;
+
+	if (result != EDialogBarkResult::Played)
+	{
+		INC_DWORD_STAT(STAT_QaDS_BarksRejected);
+		return result;
+	}
+
+	auto& data = phrase->Data;
+	auto sound = data.Sound.Get();
+	auto duration = data.AutoTime ? (sound ? sound->Duration : 0) : data.PhraseManualTime;
+
+	FStoryKeyChangeScope scope(TEXT("Bark"), Dialog, data.UID);
+
+	for (auto key : data.GiveKeys)
+		checkProcessor->StoryKeyManager->AddKey(key);
+
+	for (auto key : data.RemoveKeys)
+		checkProcessor->StoryKeyManager->RemoveKey(key);
+
+	for (auto& Event : data.Action)
+	{
+		// barks have no dialog script to call
+		if (Event.CallType == EDialogPhraseEventCallType::DialogScript)
+		{
+			if (!scriptEventPhrases.Contains(phrase))
+			{
+				scriptEventPhrases.Add(phrase);
+				UE_LOG(DialogModuleLog, Warning, TEXT("Bark phrase %s in %s skips event %s, barks have no dialog script"),
+					*data.UID.ToString(), *Dialog->GetName(), *Event.ToString());
+			}
+
+			continue;
+		}
+
+		Event.Invoke(checkProcessor);
+	}
+
+	// far barks are shown as text only
+	auto isNear = listener == NULL || FVector::DistSquared(listener->GetActorLocation(), NPC->GetActorLocation()) <= FMath::Square(settings->BarkSoundDistance);
+
+	if (sound != NULL && isNear)
+		UGameplayStatics::PlaySoundAtLocation(NPC, sound, NPC->GetActorLocation());
+
+	FActiveBark bark;
+	bark.NPC = NPC;
+	bark.Phrase = phrase;
+	bark.EndTime = currentTime + FMath::Max(duration, settings->MinBarkDuration);
+
+	activeBarks.Add(bark);
+	cooldowns.Add(NPC, bark.EndTime + settings->BarkCooldown);
+
+	INC_DWORD_STAT(STAT_QaDS_BarksPlayed);
+	INC_DWORD_STAT(STAT_QaDS_ActiveBarks);
+
+	OnBarkStart.Broadcast(NPC, data);
+
+	if (OnBarkStartBP.IsBound())
+		OnBarkStartBP.Broadcast(NPC, data.Text);
+
+	return result;
+}
+
+const UDialogPhraseNode* UDialogBarkManager::FindPhrase(UDialogAsset* Dialog, AActor* NPC, AActor* Player)
+{
+	if (checkProcessor == NULL)
+		checkProcessor = NewObject<UDialogProcessor>(this);
+
+	auto context = Cast<UStoryContext>(GetOuter());
+
+	checkProcessor->Asset = Dialog;
+	checkProcessor->NPC = NPC;
+	checkProcessor->Player = Player;
+	checkProcessor->StoryContext = context;
+	checkProcessor->StoryKeyManager = context ? context->StoryKeyManager : NULL;
+
+	if (checkProcessor->StoryKeyManager == NULL)
+		return NULL;
+
+	for (auto childNode : Dialog->RootNode->Childs)
+	{
+		if (!childNode->Check(checkProcessor))
+			continue;
+
+		auto phrase = Cast<UDialogPhraseNode>(childNode);
+		if (phrase != NULL)
+			return phrase;
+
+		auto nextPhrases = childNode->GetNextPhrases(checkProcessor);
+		if (nextPhrases.Num() > 0)
+			return nextPhrases[0];
+	}
+
+	return NULL;
+}
+
+void UDialogBarkManager::StopBark(AActor* NPC)
+{
+	for (auto i = activeBarks.Num() - 1; i >= 0; i--)
+	{
+		if (activeBarks[i].NPC == NPC)
+			EndBark(i);
+	}
+}
+
+bool UDialogBarkManager::IsBarking(AActor* NPC) const
+{
+	for (auto& bark : activeBarks)
+	{
+		if (bark.NPC == NPC)
+			return true;
+	}
+
+	return false;
+}
+
+void UDialogBarkManager::EndBark(int32 Index)
+{
+	auto bark = activeBarks[Index];
+	activeBarks.RemoveAtSwap(Index);
+
+	DEC_DWORD_STAT(STAT_QaDS_ActiveBarks);
+
+	auto npc = bark.NPC.Get();
+	if (npc == NULL)
+		return;
+
+	auto phrase = bark.Phrase.Get();
+	OnBarkEnd.Broadcast(npc, phrase ? phrase->Data : FDialogPhraseInfo());
+
+	if (OnBarkEndBP.IsBound())
+		OnBarkEndBP.Broadcast(npc);
+}
+
+void UDialogBarkManager::Tick(float DeltaTime)
+{
+	auto world = GetTickableGameObjectWorld();
+
+	if (world != NULL)
+	{
+		if (world->IsPaused())
+			return;
+
+		// dilated like the world timers
+		currentTime += world->GetDeltaSeconds();
+	}
+	else
+	{
+		currentTime += DeltaTime;
+	}
+
+	for (auto i = activeBarks.Num() - 1; i >= 0; i--)
+	{
+		if (activeBarks[i].EndTime <= currentTime || !activeBarks[i].NPC.IsValid())
+			EndBark(i);
+	}
+
+	// expired cooldowns of NPCs that do not bark again
+	if (cooldowns.Num() > GetDefault<UQaDSSettings>()->MaxConcurrentBarks * 4)
+	{
+		for (auto it = cooldowns.CreateIterator(); it; ++it)
+		{
+			if (it.Value() <= currentTime)
+				it.RemoveCurrent();
+		}
+	}
+}
+
+bool UDialogBarkManager::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && !IsPendingKillOrUnreachable();
+}
+
+UWorld* UDialogBarkManager::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UDialogBarkManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDialogBarkManager, STATGROUP_QaDS);
+}
+
+void UDialogBarkManager::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(activeBarks.GetAllocatedSize() + cooldowns.GetAllocatedSize());
+}
\ No newline at end of file
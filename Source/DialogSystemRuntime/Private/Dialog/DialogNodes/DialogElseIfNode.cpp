@@ -16,11 +16,13 @@ void UDialogElseIfNode::Invoke(UDialogProcessor* processor)
 			if (nextNode->Check(processor))
 			{
 				processor->SetCurrentNode(nextNode);
+				return;
 			}
 		}
 		break;
 	}
 
+	// no branch matched
 	processor->EndDialog();
 }
 
@@ -1,14 +1,19 @@
 #include "DialogSystemRuntime.h"
 #include "DialogPhraseNode.h"
+#include "DialogAsset.h"
 #include "DialogProcessor.h"
 #include "DialogNodes.h"
 #include "StoryInformationManager.h"
 #include "QuestProcessor.h"
+#include "StoryContext.h"
+#include "StoryPredicateProfiler.h"
 
 void UDialogPhraseNode::Invoke(UDialogProcessor* processor)
 {
 	check(processor);
 
+	FStoryKeyChangeScope scope(TEXT("Dialog"), processor->Asset, Data.UID);
+
 	for (auto key : Data.GiveKeys)
 		processor->StoryKeyManager->AddKey(key);
 
@@ -20,32 +25,14 @@ void UDialogPhraseNode::Invoke(UDialogProcessor* processor)
 	
 	if (!Data.StartQuest.ToSoftObjectPath().IsNull())
 	{
-		UQuestProcessor::GetQuestProcessor(processor)->StartQuest(Data.StartQuest.ToSoftObjectPath().TryLoad());
+		processor->StoryContext->QuestProcessor->StartQuest(Data.StartQuest.ToSoftObjectPath().TryLoad());
 	}
 	
-	if (Data.Source == EDialogPhraseSource::Player)
-	{
-		processor->OnShowPlayerPhrase.Broadcast(Data);
-	}
-	else
-	{
-		processor->OnShowNPCPhrase.Broadcast(Data);
-	}
+	processor->BroadcastPhrase(this);
 
 	if (processor->IsPlayerNext)
 	{
-		TArray<FDialogPhraseShortInfo> playerPhrases;
-
-		for (auto nextNode : processor->NextNodes)
-		{
-			FDialogPhraseShortInfo answerInfo;
-			answerInfo.Text = nextNode->Data.Text;
-			answerInfo.UID = nextNode->Data.UID;
-
-			playerPhrases.Add(answerInfo);
-		}
-
-		processor->OnChangePhraseVariant.Broadcast(playerPhrases);
+		processor->BroadcastChoices();
 	}
 	else
 	{
@@ -69,9 +56,25 @@ bool UDialogPhraseNode::Check(UDialogProcessor* processor)
 			return false;
 	}
 
-	for (auto& Conditions : Data.Predicate)
+	auto checkPredicate = [&](int32 Index)
+	{
+		if (!FStoryPredicateProfiler::IsEnabled())
+			return Data.Predicate[Index].InvokeCheck(processor);
+
+		auto startTime = FPlatformTime::Seconds();
+		auto result = Data.Predicate[Index].InvokeCheck(processor);
+		auto id = FStoryPredicateProfiler::MakeId(OwnerDialog, Data.UID.ToString(), Data.Predicate[Index].ToString());
+
+		FStoryPredicateProfiler::Record(id, result, FPlatformTime::Seconds() - startTime);
+		return result;
+	};
+
+	if (!Data.Condition.IsEmpty())
+		return Data.Condition.Evaluate(processor->StoryKeyManager, checkPredicate);
+
+	for (int32 i = 0; i < Data.Predicate.Num(); i++)
 	{
-		if (!Conditions.InvokeCheck(processor))
+		if (!checkPredicate(i))
 			return false;
 	}
 
@@ -10,6 +10,8 @@
 #include "DialogAsset.h"
 #include "DialogScript.h"
 #include "DialogPhraseEvent.h"
+#include "StoryNativeRegistry.h"
+#include "StoryContext.h"
 
 bool FDialogPhraseEvent::Compile(FString& ErrorMessage)
 {
@@ -19,6 +21,9 @@ bool FDialogPhraseEvent::Compile(FString& ErrorMessage)
 		return false;
 	}
 
+	if (CallType == EDialogPhraseEventCallType::Native)
+		return CompileNative(false, ErrorMessage);
+
 	if (ObjectClass == NULL && CallType != EDialogPhraseEventCallType::DialogScript)
 	{
 		ErrorMessage = FString::Printf(TEXT("Object classis empty"));
@@ -98,6 +103,11 @@ bool FDialogPhraseEvent::Compile(FString& ErrorMessage)
 
 bool FDialogPhraseCondition::Compile(FString& ErrorMessage)
 {
+	CommandHash = 0;
+
+	if (CallType == EDialogPhraseEventCallType::Native)
+		return CompileNative(true, ErrorMessage);
+
 	if (!Super::Compile(ErrorMessage))
 		return false;
 
@@ -125,6 +135,21 @@ bool FDialogPhraseCondition::Compile(FString& ErrorMessage)
 }
 
 
+bool FDialogPhraseEvent::CompileNative(bool bIsCondition, FString& ErrorMessage)
+{
+	NativeCall = FStoryNativeRegistry::Get().Compile(EventName, bIsCondition, Parameters, Command, ErrorMessage);
+	if (!NativeCall.IsValid())
+		return false;
+
+	ObjectClass = NULL;
+	return true;
+}
+
+bool FDialogPhraseEvent::BindNative(bool bIsCondition) const
+{
+	return FStoryNativeRegistry::Get().BindOnce(EventName, bIsCondition, Parameters, NativeCall);
+}
+
 UObject* FDialogPhraseEvent::GetObject(UDialogProcessor* DialogProcessor) const
 {
 	UObject* obj = NULL;
@@ -136,13 +161,17 @@ UObject* FDialogPhraseEvent::GetObject(UDialogProcessor* DialogProcessor) const
 		break;
 
 	case EDialogPhraseEventCallType::Player:
-		obj = UGameplayStatics::GetPlayerCharacter(DialogProcessor->NPC->GetWorld(), 0);
+		obj = DialogProcessor->GetPlayer();
 		break;
 
 	case EDialogPhraseEventCallType::NPC:
 		obj = DialogProcessor->NPC;
 		break;
 
+	case EDialogPhraseEventCallType::Native:
+		obj = DialogProcessor;
+		break;
+
 	case EDialogPhraseEventCallType::FindByTag:
 		for (FObjectIterator Itr(ObjectClass); Itr; ++Itr)
 		{
@@ -178,11 +207,23 @@ UObject* FDialogPhraseEvent::GetObject(UDialogProcessor* DialogProcessor) const
 	return obj;
 }
 
-void FDialogPhraseEvent::Invoke(UDialogProcessor* DialogProcessor)
+void FDialogPhraseEvent::Invoke(UDialogProcessor* DialogProcessor) const
 {
+	if (CallType == EDialogPhraseEventCallType::Native)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QaDS_NativeCall);
+
+		if (BindNative(false))
+			NativeCall->Call(DialogProcessor);
+
+		return;
+	}
+
 	auto obj = GetObject(DialogProcessor);
 	if (obj != NULL)
 	{ 
+		SCOPE_CYCLE_COUNTER(STAT_QaDS_ReflectionCall);
+
 		auto ar = FOutputDeviceRedirector::Get();
 		obj->CallFunctionByNameWithArguments(*Command, *ar, obj, true);
 	}
@@ -215,6 +256,9 @@ FString FDialogPhraseEvent::ToString() const
 	case EDialogPhraseEventCallType::NPC:
 		return TEXT("NPC.") + funcName;
 
+	case EDialogPhraseEventCallType::Native:
+		return TEXT("Native.") + funcName;
+
 	case EDialogPhraseEventCallType::FindByTag:
 		if (ObjectClass)
 			return ObjectClass->GetName() + TEXT("[") + FindTag + TEXT("].") + funcName;
@@ -226,7 +270,14 @@ FString FDialogPhraseEvent::ToString() const
 
 bool FDialogPhraseCondition::InvokeCheck(class UDialogProcessor* DialogProcessor) const
 {
+	if (!bIsPure && DialogProcessor->IsSpeculating())
+	{
+		DialogProcessor->CancelSpeculation();
+		return false;
+	}
+
 	auto obj = GetObject(DialogProcessor);
+	auto context = DialogProcessor->StoryContext;
 
 	if (obj == NULL)
 	{
@@ -234,13 +285,22 @@ bool FDialogPhraseCondition::InvokeCheck(class UDialogProcessor* DialogProcessor
 		return false;
 	}
 
-	bool checkResult;
-	if (!CallCheckFunction(obj, *Command, checkResult) || !checkResult)
+	auto cache = bIsPure && context != NULL ? &context->PredicateCache : NULL;
+	auto keysVersion = cache != NULL && context->StoryKeyManager != NULL ? context->StoryKeyManager->GetKeysVersion() : 0;
+
+	if (cache != NULL && CommandHash == 0)
+		CommandHash = FStoryPredicateCache::HashCommand(Command);
+
+	bool checkResult = false;
+	if (cache == NULL || !cache->Find(obj, EventName, Command, CommandHash, keysVersion, checkResult))
 	{
-		return InvertCondition;
+		checkResult = CallCheck(obj);
+
+		if (cache != NULL)
+			cache->Add(obj, EventName, Command, CommandHash, checkResult);
 	}
 
-	return !InvertCondition;
+	return checkResult != InvertCondition;
 }
 
 FString FDialogPhraseCondition::ToString() const
@@ -253,6 +313,20 @@ FString FDialogPhraseCondition::ToString() const
 	return baseText;
 }
 
+bool FDialogPhraseCondition::CallCheck(UObject* Executor) const
+{
+	if (CallType == EDialogPhraseEventCallType::Native)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QaDS_NativeCall);
+		return BindNative(true) && NativeCall->Call(Executor);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_ReflectionCall);
+
+	bool checkResult = false;
+	return CallCheckFunction(Executor, *Command, checkResult) && checkResult;
+}
+
 // Copy from ScriptCore.cpp UObject::CallFunctionByNameWithArguments
 bool FDialogPhraseCondition::CallCheckFunction(UObject* Executor, const TCHAR* Str, bool& checkResult) const
 {
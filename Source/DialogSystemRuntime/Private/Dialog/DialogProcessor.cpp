@@ -5,12 +5,21 @@
 #include "DialogNodes.h"
 #include "DialogAsset.h"
 #include "StoryInformationManager.h"
-#include "Runtime/Engine/Public/TimerManager.h"
+#include "StoryContext.h"
+#include "StoryObjectPool.h"
+#include "QaDSSettings.h"
 #include "Runtime/Engine/Classes/Sound/SoundBase.h"
 #include "Runtime/Engine/Classes/Components/AudioComponent.h"
 #include "Runtime/Engine/Classes/GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
 
-UDialogProcessor* UDialogProcessor::CreateDialogProcessor(UDialogAsset* DialogAsset, AActor* InNPC)
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dialog steps"), STAT_QaDS_DialogSteps, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dialog payload copies"), STAT_QaDS_DialogPayloadCopies, STATGROUP_QaDS);
+DECLARE_CYCLE_STAT(TEXT("Dialog speculation"), STAT_QaDS_Speculation, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dialog speculation hits"), STAT_QaDS_SpeculationHits, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dialog speculation misses"), STAT_QaDS_SpeculationMisses, STATGROUP_QaDS);
+
+UDialogProcessor* UDialogProcessor::CreateDialogProcessor(UDialogAsset* DialogAsset, AActor* InNPC, AActor* InPlayer)
 {
 	if (DialogAsset == NULL)
 	{
@@ -30,8 +39,15 @@ UDialogProcessor* UDialogProcessor::CreateDialogProcessor(UDialogAsset* DialogAs
 		return NULL;
 	}
 
-	auto impl = NewObject<UDialogProcessor>(InNPC->GetWorld());
+	auto context = UStoryContext::GetStoryContext(InPlayer != NULL ? (UObject*)InPlayer : InNPC);
+	auto pool = context->ObjectPool;
+	auto impl = GetDefault<UQaDSSettings>()->bPoolDialogProcessors ? pool->AcquireProcessor() : NewObject<UDialogProcessor>(InNPC->GetWorld());
+	impl->StoryContext = context;
+	impl->StoryKeyManager = context->StoryKeyManager;
+	impl->Pool = pool;
+	impl->bIsEnded = false;
 	impl->NPC = InNPC;
+	impl->Player = InPlayer;
 	impl->SetDialogAsset(DialogAsset);
 
 	return impl;
@@ -39,55 +55,259 @@ UDialogProcessor* UDialogProcessor::CreateDialogProcessor(UDialogAsset* DialogAs
 
 void UDialogProcessor::StartDialog()
 {
-	StoryKeyManager = UStoryKeyManager::GetStoryKeyManager(this);
+	if (IsPooled() && !CheckNotEnded(TEXT("StartDialog")))
+		return;
+
+	bIsEnded = false;
+
+	// Player may have been changed since the processor was created
+	StoryContext = UStoryContext::GetStoryContext(Player != NULL ? (UObject*)Player : (UObject*)NPC);
+	StoryKeyManager = StoryContext->StoryKeyManager;
+	StoryContext->DialogScheduler->Add(this);
 	SetCurrentNode(Asset->RootNode);
 }
 
+UDialogScheduler* UDialogProcessor::GetScheduler()
+{
+	if (StoryContext == NULL)
+		StoryContext = UStoryContext::GetStoryContext(Player != NULL ? (UObject*)Player : this);
+
+	return StoryContext->DialogScheduler;
+}
+
+bool UDialogProcessor::IsPooled() const
+{
+	return Pool != NULL && GetOuter() == Pool;
+}
+
+bool UDialogProcessor::CheckNotEnded(const TCHAR* Action) const
+{
+	if (!bIsEnded)
+		return true;
+
+	UE_LOG(DialogModuleLog, Warning, TEXT("%s is ignored, dialog processor %s is ended"), Action, *GetName());
+	return false;
+}
+
+AActor* UDialogProcessor::GetPlayer() const
+{
+	if (Player != NULL)
+		return Player;
+
+	return StoryContext ? StoryContext->GetPlayerPawn() : UGameplayStatics::GetPlayerPawn(NPC, 0);
+}
+
 void UDialogProcessor::SetDialogAsset(UDialogAsset* NewDialogAsset)
 {
 	Asset = NewDialogAsset;
 
 	if (!Asset->DialogScriptClass.IsValid())
 	{
-		DialogScript = NULL;
+		ReleaseScript();
 	}
 	else if (DialogScript == NULL || !DialogScript->IsA(Asset->DialogScriptClass.Get()))
 	{
-		DialogScript = NPC->GetWorld()->SpawnActor<ADialogScript>(Asset->DialogScriptClass.Get());
+		ReleaseScript();
+
+		if (Pool == NULL)
+			Pool = UStoryObjectPool::Get(NPC);
+
+		DialogScript = Pool->AcquireActor<ADialogScript>(NPC->GetWorld(), Asset->DialogScriptClass.Get());
 		DialogScript->Implementer = this;
 	}
 }
 
-void UDialogProcessor::SetCurrentNode(UDialogNode* node)
+void UDialogProcessor::ReleaseScript()
 {
-	IsPlayerNext = false;
-	CurrentNode = node;
+	if (DialogScript == NULL)
+		return;
+
+	if (Pool != NULL)
+	{
+		DialogScript->OnResetScript();
+		DialogScript->Implementer = NULL;
+		Pool->ReleaseActor(DialogScript);
+	}
+	else
+	{
+		DialogScript->Destroy();
+	}
+
+	DialogScript = NULL;
+}
+
+void UDialogProcessor::ResetForPool()
+{
+	ReleaseScript();
+
+	bIsEnded = true;
 	NextNodes.Reset();
+	IsPlayerNext = false;
+	CurrentNode = NULL;
+	speculativeNode = NULL;
+	speculativeNextNodes.Reset();
+	Asset = NULL;
+	StoryContext = NULL;
+	StoryKeyManager = NULL;
+	NPC = NULL;
+	Player = NULL;
+
+	OnChangePhraseVariant.Clear();
+	OnShowPlayerPhrase.Clear();
+	OnShowNPCPhrase.Clear();
+	OnEndDialog.Clear();
+	OnShowPhraseNode.Clear();
+	OnChoicesReady.Clear();
+	OnShowPhraseNative.Clear();
+	OnChoicesReadyNative.Clear();
+}
+
+UDialogPhraseNode* UDialogProcessor::GetCurrentPhrase() const
+{
+	return Cast<UDialogPhraseNode>(CurrentNode);
+}
+
+int32 UDialogProcessor::GetNumChoices() const
+{
+	return IsPlayerNext ? NextNodes.Num() : 0;
+}
+
+UDialogPhraseNode* UDialogProcessor::GetChoice(int32 Index) const
+{
+	return IsPlayerNext && NextNodes.IsValidIndex(Index) ? NextNodes[Index] : NULL;
+}
+
+void UDialogProcessor::BroadcastPhrase(UDialogPhraseNode* Phrase)
+{
+	OnShowPhraseNative.Broadcast(this, Phrase);
+
+	if (OnShowPhraseNode.IsBound())
+		OnShowPhraseNode.Broadcast(Phrase);
+
+	// legacy events copy the whole phrase
+	auto& phraseEvent = Phrase->Data.Source == EDialogPhraseSource::Player ? OnShowPlayerPhrase : OnShowNPCPhrase;
+	if (phraseEvent.IsBound())
+	{
+		INC_DWORD_STAT(STAT_QaDS_DialogPayloadCopies);
+		phraseEvent.Broadcast(Phrase->Data);
+	}
+}
+
+void UDialogProcessor::BroadcastChoices()
+{
+	OnChoicesReadyNative.Broadcast(this, NextNodes);
+
+	if (OnChoicesReady.IsBound())
+		OnChoicesReady.Broadcast();
 
-	for (auto childNode : CurrentNode->Childs)
+	if (OnChangePhraseVariant.IsBound())
+	{
+		choiceInfos.Reset();
+
+		for (auto nextNode : NextNodes)
+		{
+			FDialogPhraseShortInfo answerInfo;
+			answerInfo.Text = nextNode->Data.Text;
+			answerInfo.UID = nextNode->Data.UID;
+
+			choiceInfos.Add(answerInfo);
+		}
+
+		INC_DWORD_STAT(STAT_QaDS_DialogPayloadCopies);
+		OnChangePhraseVariant.Broadcast(choiceInfos);
+	}
+}
+
+void UDialogProcessor::EvaluateNext(UDialogNode* Node, TArray<UDialogPhraseNode*>& OutNextNodes, bool& OutIsPlayerNext)
+{
+	OutIsPlayerNext = false;
+	OutNextNodes.Reset();
+
+	for (auto childNode : Node->Childs)
 	{
 		if (!childNode->Check(this))
 			continue;
 
-		NextNodes.Append(childNode->GetNextPhrases(this));
+		OutNextNodes.Append(childNode->GetNextPhrases(this));
 
 		auto phrase = Cast<UDialogPhraseNode>(childNode);
 		if (phrase)
 		{
-			IsPlayerNext = phrase->Data.Source == EDialogPhraseSource::Player;
+			OutIsPlayerNext = phrase->Data.Source == EDialogPhraseSource::Player;
 		}
 	}
+}
+
+bool UDialogProcessor::Speculate()
+{
+	// only an automatic transition has a known next phrase
+	if (bIsEnded || IsPlayerNext || NextNodes.Num() == 0 || StoryKeyManager == NULL)
+		return false;
+
+	auto node = NextNodes[0];
+	if (speculativeNode == node && StoryKeyManager->GetKeysVersion() == speculativeKeysVersion)
+		return false;
+
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_Speculation);
+
+	speculativeKeysVersion = StoryKeyManager->GetKeysVersion();
 
-	if (NextTimerHandle.IsValid() && NPC != NULL)
+	bIsSpeculating = true;
+	bIsSpeculationCancelled = false;
+	EvaluateNext(node, speculativeNextNodes, bSpeculativeIsPlayerNext);
+	bIsSpeculating = false;
+
+	// an impure predicate must run only on the real transition
+	if (bIsSpeculationCancelled)
 	{
-		NPC->GetWorldTimerManager().ClearTimer(NextTimerHandle);
+		speculativeNextNodes.Reset();
+		speculativeNode = NULL;
+		return false;
 	}
 
+	// a predicate may have changed keys, the result is then rejected on transition
+	speculativeNode = node;
+	return true;
+}
+
+void UDialogProcessor::SetCurrentNode(UDialogNode* node)
+{
+	if (!CheckNotEnded(TEXT("SetCurrentNode")))
+		return;
+
+	INC_DWORD_STAT(STAT_QaDS_DialogSteps);
+
+	CurrentNode = node;
+
+	// choices evaluated while the previous phrase played are valid if no key changed since
+	if (speculativeNode == node && StoryKeyManager->GetKeysVersion() == speculativeKeysVersion)
+	{
+		INC_DWORD_STAT(STAT_QaDS_SpeculationHits);
+
+		Swap(NextNodes, speculativeNextNodes);
+		IsPlayerNext = bSpeculativeIsPlayerNext;
+	}
+	else
+	{
+		if (speculativeNode != NULL)
+			INC_DWORD_STAT(STAT_QaDS_SpeculationMisses);
+
+		EvaluateNext(node, NextNodes, IsPlayerNext);
+	}
+
+	speculativeNode = NULL;
+
+	if (SchedulerIndex != INDEX_NONE)
+		GetScheduler()->Cancel(this);
+
 	node->Invoke(this);
 }
 
 void UDialogProcessor::Next(FName PhraseUID)
 {
+	if (!CheckNotEnded(TEXT("Next")))
+		return;
+
 	for (auto node : NextNodes)
 	{
 		if (node->Data.UID == PhraseUID) 
@@ -103,19 +323,13 @@ void UDialogProcessor::Next(FName PhraseUID)
 
 void UDialogProcessor::DelayNext()
 {
-	if (NextTimerHandle.IsValid())
-		NPC->GetWorldTimerManager().ClearTimer(NextTimerHandle);
-
-	if (NPC == NULL)
-	{
-		UE_LOG(DialogModuleLog, Warning, TEXT("NPC is null, phrase delay has ben skip"));
-		OnTimerTick();
-	}
-
 	float delay = GetPhraseDuration();
 	if (delay > 0)
 	{
-		NPC->GetWorldTimerManager().SetTimer(NextTimerHandle, this, &UDialogProcessor::OnTimerTick, delay, false);
+		GetScheduler()->Schedule(this, delay);
+
+		if (GetDefault<UQaDSSettings>()->bSpeculateNextChoices)
+			GetScheduler()->RequestSpeculation(this);
 	}
 	else
 	{
@@ -125,6 +339,9 @@ void UDialogProcessor::DelayNext()
 
 void UDialogProcessor::OnTimerTick()
 {
+	if (bIsEnded)
+		return;
+
 	if (NextNodes.Num() > 0)
 	{
 		Next(NextNodes[0]->Data.UID);
@@ -158,8 +375,19 @@ float UDialogProcessor::GetPhraseDuration()
 
 void UDialogProcessor::EndDialog()
 {
-	if (DialogScript != NULL)
-		DialogScript->Destroy();
+	if (bIsEnded)
+		return;
+
+	bIsEnded = true;
+
+	if (SchedulerIndex != INDEX_NONE)
+		GetScheduler()->Remove(this);
+
+	ReleaseScript();
 
 	OnEndDialog.Broadcast();
+
+	// the pool reuses it only from a later frame, the caller and listeners may still read it now
+	if (IsPooled())
+		Pool->ReleaseProcessor(this);
 }
\ No newline at end of file
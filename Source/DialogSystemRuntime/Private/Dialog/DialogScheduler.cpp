@@ -0,0 +1,234 @@
+#include "DialogSystemRuntime.h"
+#include "DialogScheduler.h"
+#include "DialogProcessor.h"
+#include "StoryContext.h"
+#include "QaDSSettings.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_CYCLE_STAT(TEXT("Dialog scheduler tick"), STAT_QaDS_DialogSchedulerTick, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Active dialogs"), STAT_QaDS_ActiveDialogs, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dialog phrases advanced"), STAT_QaDS_PhrasesAdvanced, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Dialog phrases over budget"), STAT_QaDS_PhrasesOverBudget, STATGROUP_QaDS);
+
+UDialogScheduler* UDialogScheduler::GetDialogScheduler(UObject* WorldContextObject)
+{
+	auto context = UStoryContext::GetStoryContext(WorldContextObject);
+	return context ? context->DialogScheduler : NULL;
+}
+
+void UDialogScheduler::Add(UDialogProcessor* Processor)
+{
+	check(Processor);
+
+	if (Processor->SchedulerIndex != INDEX_NONE)
+		return;
+
+	Processor->SchedulerIndex = activeDialogs.Add(Processor);
+	Processor->LOD = EDialogLOD::Near;
+
+	INC_DWORD_STAT(STAT_QaDS_ActiveDialogs);
+}
+
+void UDialogScheduler::Remove(UDialogProcessor* Processor)
+{
+	auto index = Processor->SchedulerIndex;
+	if (index == INDEX_NONE || !activeDialogs.IsValidIndex(index) || activeDialogs[index].Get() != Processor)
+		return;
+
+	Cancel(Processor);
+
+	heap.RemoveAll([Processor](const FScheduledPhrase& Phrase) { return Phrase.Processor.Get() == Processor; });
+	heap.Heapify();
+	speculations.Remove(Processor);
+
+	RemoveAt(index);
+	Processor->SchedulerIndex = INDEX_NONE;
+}
+
+void UDialogScheduler::RemoveAt(int32 Index)
+{
+	activeDialogs.RemoveAtSwap(Index);
+
+	if (Index < activeDialogs.Num() && activeDialogs[Index].IsValid())
+		activeDialogs[Index]->SchedulerIndex = Index;
+
+	DEC_DWORD_STAT(STAT_QaDS_ActiveDialogs);
+}
+
+void UDialogScheduler::Schedule(UDialogProcessor* Processor, float Delay)
+{
+	Add(Processor);
+
+	if (Processor->LOD == EDialogLOD::Far)
+		Delay /= FMath::Max(GetDefault<UQaDSSettings>()->FarDialogTimeScale, 1.0f);
+
+	// entries of the previous serial are skipped when popped
+	FScheduledPhrase phrase;
+	phrase.DueTime = currentTime + Delay;
+	phrase.Serial = ++Processor->ScheduleSerial;
+	phrase.Processor = Processor;
+
+	heap.HeapPush(phrase);
+}
+
+void UDialogScheduler::Cancel(UDialogProcessor* Processor)
+{
+	Processor->ScheduleSerial++;
+}
+
+void UDialogScheduler::RequestSpeculation(UDialogProcessor* Processor)
+{
+	speculations.AddUnique(Processor);
+}
+
+void UDialogScheduler::UpdateLOD()
+{
+	auto settings = GetDefault<UQaDSSettings>();
+	auto context = Cast<UStoryContext>(GetOuter());
+
+	auto defaultPlayer = context ? context->GetPlayerPawn() : NULL;
+	auto farDistanceSq = FMath::Square(settings->FarDialogDistance);
+	auto pauseDistanceSq = FMath::Square(settings->PauseDialogDistance);
+
+	TArray<UDialogProcessor*> orphans;
+
+	for (auto i = activeDialogs.Num() - 1; i >= 0; i--)
+	{
+		auto processor = activeDialogs[i].Get();
+
+		// dropped by the game without EndDialog and collected
+		if (processor == NULL)
+		{
+			RemoveAt(i);
+			continue;
+		}
+
+		// NPC was destroyed while talking
+		if (!IsValid(processor->NPC))
+		{
+			orphans.Add(processor);
+			continue;
+		}
+
+		auto player = processor->Player ? processor->Player : defaultPlayer;
+
+		if (player == NULL)
+		{
+			processor->LOD = EDialogLOD::Near;
+			continue;
+		}
+
+		auto distanceSq = FVector::DistSquared(player->GetActorLocation(), processor->NPC->GetActorLocation());
+
+		if (settings->PauseDialogDistance > 0 && distanceSq > pauseDistanceSq)
+			processor->LOD = EDialogLOD::Paused;
+		else if (settings->FarDialogDistance > 0 && distanceSq > farDistanceSq)
+			processor->LOD = EDialogLOD::Far;
+		else
+			processor->LOD = EDialogLOD::Near;
+	}
+
+	for (auto processor : orphans)
+		processor->EndDialog();
+}
+
+void UDialogScheduler::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_DialogSchedulerTick);
+
+	auto settings = GetDefault<UQaDSSettings>();
+	auto world = GetTickableGameObjectWorld();
+
+	if (world != NULL)
+	{
+		if (world->IsPaused())
+			return;
+
+		// dilated like the world timers
+		currentTime += world->GetDeltaSeconds();
+	}
+	else
+	{
+		currentTime += DeltaTime;
+	}
+
+	if (currentTime >= lodTime)
+	{
+		lodTime = currentTime + FMath::Max(settings->DialogLODInterval, 0.1f);
+		UpdateLOD();
+	}
+
+	auto endTime = FPlatformTime::Seconds() + settings->DialogTickBudgetMs / 1000.0;
+	auto advanced = 0;
+
+	while (heap.Num() > 0 && heap.HeapTop().DueTime <= currentTime)
+	{
+		// at least one phrase per tick, the rest waits for the next frame
+		if (advanced > 0 && FPlatformTime::Seconds() > endTime)
+		{
+			INC_DWORD_STAT_BY(STAT_QaDS_PhrasesOverBudget, heap.Num());
+			break;
+		}
+
+		FScheduledPhrase phrase;
+		heap.HeapPop(phrase, false);
+
+		auto processor = phrase.Processor.Get();
+		if (processor == NULL || processor->ScheduleSerial != phrase.Serial || processor->SchedulerIndex == INDEX_NONE)
+			continue;
+
+		if (processor->LOD == EDialogLOD::Paused)
+		{
+			phrase.DueTime = currentTime + FMath::Max(settings->DialogLODInterval, 0.1f);
+			heap.HeapPush(phrase);
+			continue;
+		}
+
+		advanced++;
+		processor->OnTimerTick();
+	}
+
+	INC_DWORD_STAT_BY(STAT_QaDS_PhrasesAdvanced, advanced);
+
+	for (auto i = 0; i < speculations.Num() && FPlatformTime::Seconds() < endTime;)
+	{
+		auto processor = speculations[i].Get();
+
+		if (processor == NULL)
+		{
+			speculations.RemoveAt(i, 1, false);
+			continue;
+		}
+
+		// paused dialogs are speculated when they resume
+		if (processor->LOD == EDialogLOD::Paused)
+		{
+			i++;
+			continue;
+		}
+
+		speculations.RemoveAt(i, 1, false);
+		processor->Speculate();
+	}
+}
+
+bool UDialogScheduler::IsTickable() const
+{
+	return activeDialogs.Num() > 0 && !IsPendingKillOrUnreachable();
+}
+
+UWorld* UDialogScheduler::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+TStatId UDialogScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UDialogScheduler, STATGROUP_QaDS);
+}
+
+void UDialogScheduler::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(activeDialogs.GetAllocatedSize() + heap.GetAllocatedSize());
+}
\ No newline at end of file
@@ -8,7 +8,7 @@ ADialogScript::ADialogScript()
 
 AActor* ADialogScript::GetPlayer()
 {
-	return UGameplayStatics::GetPlayerCharacter(GetNPC()->GetWorld(), 0);
+	return Implementer->GetPlayer();
 }
 
 AActor* ADialogScript::GetNPC()
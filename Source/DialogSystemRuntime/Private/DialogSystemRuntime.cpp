@@ -1,9 +1,15 @@
 #include "DialogSystemRuntime.h"
+#include "StoryContext.h"
 
 DEFINE_LOG_CATEGORY(DialogModuleLog)
 
 #define LOCTEXT_NAMESPACE "FDialogSystemModule"
 
+void FDialogSystemRuntime::ShutdownModule()
+{
+	UStoryContext::ReleaseFallbackContext();
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FDialogSystemRuntime, DialogSystemRuntime)
\ No newline at end of file
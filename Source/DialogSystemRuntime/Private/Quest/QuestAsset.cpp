@@ -2,24 +2,127 @@
 #include "QuestProcessor.h"
 #include "QuestAsset.h"
 #include "QuestScript.h"
+#include "StoryContext.h"
+#include "StoryObjectPool.h"
+#include "QaDSSettings.h"
 
-void UQuestRuntimeAsset::CreateScript()
+void UQuestAsset::GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const
 {
-	if (!Asset->QuestScriptClass.IsNull())
+	Super::GetAssetRegistryTags(OutTags);
+
+#if WITH_EDITORONLY_DATA
+	Usage.GetAssetRegistryTags(OutTags);
+#endif
+}
+
+int32 UQuestAsset::GetStageIndex(const FGuid& UID) const
+{
+	auto index = 0;
+	for (auto& node : Nodes)
+	{
+		if (node.Key == UID)
+			return index;
+
+		index++;
+	}
+
+	return INDEX_NONE;
+}
+
+FGuid UQuestAsset::GetStageUID(int32 Index) const
+{
+	for (auto& node : Nodes)
+	{
+		if (Index-- == 0)
+			return node.Key;
+	}
+
+	return FGuid();
+}
+
+void UQuestRuntimeAsset::CreateScript(bool bDeferred)
+{
+	if (Asset->QuestScriptClass.IsNull() || Script != NULL || bIsScriptPending)
+		return;
+
+	if (bDeferred)
+	{
+		bIsScriptPending = true;
+		Processor->QueueScriptSpawn(this);
+	}
+	else
+	{
+		SpawnScript();
+	}
+}
+
+void UQuestRuntimeAsset::SpawnScript()
+{
+	if (bIsScriptPending)
+	{
+		bIsScriptPending = false;
+		Processor->CancelScriptSpawn(this);
+	}
+
+	if (Script != NULL || Asset->QuestScriptClass.IsNull())
+		return;
+
+	auto pool = Processor->StoryContext ? Processor->StoryContext->ObjectPool : NULL;
+	auto world = Processor->GetWorld();
+
+	if (pool != NULL)
+		Script = pool->AcquireActor<AQuestScript>(world, Asset->QuestScriptClass.Get());
+	else if (world != NULL)
+		Script = world->SpawnActor<AQuestScript>(Asset->QuestScriptClass.Get());
+
+	if (Script == NULL)
 	{
-		Script = UQuestProcessor::GetQuestProcessor(this)->GetWorld()->SpawnActor<AQuestScript>(Asset->QuestScriptClass.Get());
+		pendingCommands.Reset();
+		return;
+	}
+
+	Script->Quest = this;
 
-		if (Script)
-			Script->Quest = this;
+	auto commands = MoveTemp(pendingCommands);
+	for (auto& command : commands)
+	{
+		auto ar = FOutputDeviceRedirector::Get();
+		Script->CallFunctionByNameWithArguments(*command, *ar, Script, true);
 	}
 }
 
+void UQuestRuntimeAsset::QueueScriptCommand(const FString& Command)
+{
+	pendingCommands.Add(Command);
+}
+
 void UQuestRuntimeAsset::DestroyScript()
 {
+	if (bIsScriptPending)
+	{
+		bIsScriptPending = false;
+		Processor->CancelScriptSpawn(this);
+	}
+
+	pendingCommands.Reset();
+
 	if (Script != NULL && !Script->IsActorBeingDestroyed())
 	{
-		Script->Destroy();
+		auto pool = Processor->StoryContext ? Processor->StoryContext->ObjectPool : NULL;
+
+		if (pool != NULL)
+		{
+			Script->OnResetScript();
+			Script->Quest = NULL;
+			pool->ReleaseActor(Script);
+		}
+		else
+		{
+			Script->Destroy();
+		}
 	}
+
+	Script = NULL;
 }
 
 UQuestRuntimeNode* UQuestRuntimeAsset::LoadNode(FGuid uid)
@@ -30,11 +133,22 @@ UQuestRuntimeNode* UQuestRuntimeAsset::LoadNode(FGuid uid)
 		return NULL;
 	}
 
-	auto runtimeStage = NewObject<UQuestRuntimeNode>();
-	runtimeStage->Processor = UQuestProcessor::GetQuestProcessor(this);
+	auto& stage = Asset->Nodes[uid];
+
+	auto runtimeStage = NewObject<UQuestRuntimeNode>(this);
+	runtimeStage->Processor = Processor;
 	runtimeStage->OwnerQuest = this;
 	runtimeStage->Childs = Asset->Joins[uid].UIDs;
-	runtimeStage->Stage = Asset->Nodes[uid];
+	runtimeStage->UID = uid;
+
+	if (GetDefault<UQaDSSettings>()->bCopyQuestStageToNodes)
+		runtimeStage->Stage = stage;
+
+	for (auto& trigger : stage.WaitTriggers)
+		runtimeStage->WaitTriggersCount.Add(trigger.TotalCount);
+
+	for (auto& trigger : stage.FailedTriggers)
+		runtimeStage->FailedTriggersCount.Add(trigger.TotalCount);
 
 	return runtimeStage;
 }
@@ -60,9 +174,10 @@ FArchive& operator<<(FArchive& Ar, FQuestRuntimeNodeArchive& A)
 
 // Load from archive
 
-UQuestRuntimeAsset* FQuestRuntimeAssetArchive::Load()
+UQuestRuntimeAsset* FQuestRuntimeAssetArchive::Load(UQuestProcessor* Processor)
 {
-	auto runtimeAsset = NewObject<UQuestRuntimeAsset>();
+	auto runtimeAsset = NewObject<UQuestRuntimeAsset>(Processor);
+	runtimeAsset->Processor = Processor;
 
 	runtimeAsset->Asset = TSoftObjectPtr<UQuestAsset>(AssetName).LoadSynchronous();
 	runtimeAsset->Status = Status;
@@ -83,18 +198,20 @@ UQuestRuntimeAsset* FQuestRuntimeAssetArchive::Load()
 UQuestRuntimeNode* FQuestRuntimeNodeArchive::Load(UQuestRuntimeAsset* RuntimeAsset)
 {
 	auto node = RuntimeAsset->LoadNode(UID);
-	node->SetStatus(Status);
+	if (node == NULL)
+		return NULL;
 
-	for (auto i = 0; i < WaitTriggers.Num(); i++)
+	for (auto i = 0; i < WaitTriggers.Num() && i < node->WaitTriggersCount.Num(); i++)
 	{
-		node->Stage.WaitTriggers[i].TotalCount = WaitTriggers[i];
+		node->WaitTriggersCount[i] = WaitTriggers[i];
 	}
 
-	for (auto i = 0; i < FailedTriggers.Num(); i++)
+	for (auto i = 0; i < FailedTriggers.Num() && i < node->FailedTriggersCount.Num(); i++)
 	{
-		node->Stage.FailedTriggers[i].TotalCount = FailedTriggers[i];
+		node->FailedTriggersCount[i] = FailedTriggers[i];
 	}
 
+	node->SetStatus(Status);
 	return node;
 }
 
@@ -113,17 +230,10 @@ FQuestRuntimeAssetArchive::FQuestRuntimeAssetArchive(UQuestRuntimeAsset* Runtime
 
 FQuestRuntimeNodeArchive::FQuestRuntimeNodeArchive(UQuestRuntimeNode* RuntimeNode)
 {
-	UID = RuntimeNode->Stage.UID;
+	UID = RuntimeNode->UID;
 	Status = RuntimeNode->Status;
 	//Progress = RuntimeNode->GetProgress();
 
-	for (auto& trigger : RuntimeNode->Stage.WaitTriggers)
-	{
-		WaitTriggers.Add(trigger.TotalCount);
-	}
-
-	for (auto& trigger : RuntimeNode->Stage.FailedTriggers)
-	{
-		FailedTriggers.Add(trigger.TotalCount);
-	}
+	WaitTriggers = RuntimeNode->WaitTriggersCount;
+	FailedTriggers = RuntimeNode->FailedTriggersCount;
 }
\ No newline at end of file
@@ -3,6 +3,31 @@
 #include "QuestAsset.h"
 #include "QuestProcessor.h"
 #include "StoryInformationManager.h"
+#include "StoryPredicateProfiler.h"
+
+const FQuestStageInfo& UQuestRuntimeNode::GetStage() const
+{
+	static const FQuestStageInfo EmptyStage;
+
+	auto stage = OwnerQuest->Asset->Nodes.Find(UID);
+	return stage ? *stage : EmptyStage;
+}
+
+FQuestStageInfo UQuestRuntimeNode::GetStageInfo() const
+{
+	return GetStage();
+}
+
+void UQuestRuntimeNode::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(
+		childCahe.GetAllocatedSize() +
+		Childs.GetAllocatedSize() +
+		WaitTriggersCount.GetAllocatedSize() +
+		FailedTriggersCount.GetAllocatedSize());
+}
 
 TArray<UQuestRuntimeNode*> UQuestRuntimeNode::GetNextStage()
 {
@@ -20,28 +45,19 @@ TArray<UQuestRuntimeNode*> UQuestRuntimeNode::GetNextStage()
 	});
 }
 
-void UQuestRuntimeNode::OnChangeStoryKey(const FName& key)
-{
-	if (Stage.WaitHasKeys.Contains(key)		 ||
-		Stage.WaitDontHasKeys.Contains(key)  ||
-		Stage.FailedIfGiveKeys.Contains(key) ||
-		Stage.FailedIfRemoveKeys.Contains(key))
-	{
-		TryComplete();
-	}
-}
-
 void UQuestRuntimeNode::OnTrigger(const FStoryTrigger& Trigger)
 {
-	for (auto& cond : Stage.WaitTriggers)
+	auto& stage = GetStage();
+
+	for (auto i = 0; i < stage.WaitTriggers.Num(); i++)
 	{
-		if (MatchTringger(cond, Trigger))
+		if (MatchTringger(stage.WaitTriggers[i], WaitTriggersCount[i], Trigger))
 			break;
 	}
 
-	for (auto& cond : Stage.FailedTriggers)
+	for (auto i = 0; i < stage.FailedTriggers.Num(); i++)
 	{
-		if (MatchTringger(cond, Trigger))
+		if (MatchTringger(stage.FailedTriggers[i], FailedTriggersCount[i], Trigger))
 			break;
 	}
 }
@@ -68,6 +84,7 @@ void UQuestRuntimeNode::SetStatus(EQuestCompleteStatus NewStatus)
 		return;
 
 	Status = NewStatus;
+	Processor->OnStageStatusChange.Broadcast(this);
 
 	switch (Status)
 	{
@@ -97,16 +114,17 @@ void UQuestRuntimeNode::Activate()
 	if (TryComplete())
 		return;
 
-	if (Stage.WaitHasKeys.Num()			> 0 ||
-		Stage.WaitDontHasKeys.Num()		> 0 ||
-		Stage.FailedIfGiveKeys.Num()	> 0 ||
-		Stage.FailedIfRemoveKeys.Num()	> 0)
+	auto& stage = GetStage();
+
+	if (stage.WaitHasKeys.Num()			> 0 ||
+		stage.WaitDontHasKeys.Num()		> 0 ||
+		stage.FailedIfGiveKeys.Num()	> 0 ||
+		stage.FailedIfRemoveKeys.Num()	> 0)
 	{
-		Processor->StoryKeyManager->OnKeyRemoveBP.AddDynamic(this, &UQuestRuntimeNode::OnChangeStoryKey);
-		Processor->StoryKeyManager->OnKeyAddBP.AddDynamic(this, &UQuestRuntimeNode::OnChangeStoryKey);
+		Processor->RegisterStage(this);
 	}
 
-	if (Stage.FailedTriggers.Num() > 0 || Stage.WaitTriggers.Num() > 0)
+	if (stage.FailedTriggers.Num() > 0 || stage.WaitTriggers.Num() > 0)
 	{
 		Processor->StoryTriggerManager->OnTriggerInvoke.AddDynamic(this, &UQuestRuntimeNode::OnTrigger);
 	}
@@ -114,7 +132,7 @@ void UQuestRuntimeNode::Activate()
 
 void UQuestRuntimeNode::Failed()
 {
-	if (Stage.bFailedQuest || OwnerQuest->ActiveNodes.Num() == 1)
+	if (GetStage().bFailedQuest || OwnerQuest->ActiveNodes.Num() == 1)
 	{
 		Processor->EndQuest(OwnerQuest, EQuestCompleteStatus::Failed);
 	}
@@ -122,30 +140,34 @@ void UQuestRuntimeNode::Failed()
 
 void UQuestRuntimeNode::Complete()
 {
-	if (Stage.ChangeOderActiveStagesState != EQuestCompleteStatus::None)
+	auto& stage = GetStage();
+
+	if (stage.ChangeOderActiveStagesState != EQuestCompleteStatus::None)
 	{
 		auto nodes = OwnerQuest->ActiveNodes;
-		for (auto stage : nodes)
+		for (auto node : nodes)
 		{
-			if (stage == this)
+			if (node == this)
 				continue;
 
-			stage->SetStatus(Stage.ChangeOderActiveStagesState);
+			node->SetStatus(stage.ChangeOderActiveStagesState);
 		}
 	}
 
-	if (Stage.ChangeQuestState != EQuestCompleteStatus::None)
+	if (stage.ChangeQuestState != EQuestCompleteStatus::None)
 	{
-		Processor->EndQuest(OwnerQuest, Stage.ChangeQuestState);
+		Processor->EndQuest(OwnerQuest, stage.ChangeQuestState);
 	}
 
-	for (auto key : Stage.GiveKeys)
+	FStoryKeyChangeScope scope(TEXT("Quest"), OwnerQuest->Asset);
+
+	for (auto key : stage.GiveKeys)
 		Processor->StoryKeyManager->AddKey(key);
 
-	for (auto key : Stage.RemoveKeys)
+	for (auto key : stage.RemoveKeys)
 		Processor->StoryKeyManager->RemoveKey(key);
 
-	for (auto& Event : Stage.Action)
+	for (auto& Event : stage.Action)
 		Event.Invoke(this);
 }
 
@@ -156,12 +178,11 @@ void UQuestRuntimeNode::Deactivate()
 
 	Processor->CompleteStage(this);
 
-	Processor->StoryKeyManager->OnKeyRemoveBP.RemoveDynamic(this, &UQuestRuntimeNode::OnChangeStoryKey);
-	Processor->StoryKeyManager->OnKeyAddBP.RemoveDynamic(this, &UQuestRuntimeNode::OnChangeStoryKey);
+	Processor->UnregisterStage(this);
 	Processor->StoryTriggerManager->OnTriggerInvoke.RemoveDynamic(this, &UQuestRuntimeNode::OnTrigger);
 }
 
-bool UQuestRuntimeNode::MatchTringger(FStoryTriggerCondition& condition, const FStoryTrigger& trigger)
+bool UQuestRuntimeNode::MatchTringger(const FStoryTriggerCondition& condition, int& count, const FStoryTrigger& trigger)
 {
 	if (condition.TriggerName != trigger.TriggerName)
 		return false;
@@ -177,9 +198,9 @@ bool UQuestRuntimeNode::MatchTringger(FStoryTriggerCondition& condition, const F
 			return false;
 	}
 
-	condition.TotalCount -= trigger.Count;
+	count -= trigger.Count;
 
-	if (condition.TotalCount <= 0)
+	if (count <= 0)
 		TryComplete();
 
 	return true;
@@ -198,21 +219,39 @@ bool UQuestRuntimeNode::MatchTringgerParam(const FString& value, const FString&
 
 bool UQuestRuntimeNode::CkeckForActivate()
 {
-	for (auto key : Stage.CheckHasKeys)
+	auto& stage = GetStage();
+
+	for (auto key : stage.CheckHasKeys)
 	{
 		if (Processor->StoryKeyManager->DontHasKey(key))
 			return false;
 	}
 
-	for (auto key : Stage.CheckDontHasKeys)
+	for (auto key : stage.CheckDontHasKeys)
 	{
 		if (Processor->StoryKeyManager->HasKey(key))
 			return false;
 	}
 
-	for (auto& Conditions : Stage.Predicate)
+	auto checkPredicate = [&](int32 Index)
 	{
-		if (!Conditions.InvokeCheck(this))
+		if (!FStoryPredicateProfiler::IsEnabled())
+			return stage.Predicate[Index].InvokeCheck(this);
+
+		auto startTime = FPlatformTime::Seconds();
+		auto result = stage.Predicate[Index].InvokeCheck(this);
+		auto id = FStoryPredicateProfiler::MakeId(OwnerQuest->Asset, UID.ToString(), stage.Predicate[Index].ToString());
+
+		FStoryPredicateProfiler::Record(id, result, FPlatformTime::Seconds() - startTime);
+		return result;
+	};
+
+	if (!stage.Condition.IsEmpty())
+		return stage.Condition.Evaluate(Processor->StoryKeyManager, checkPredicate);
+
+	for (int32 i = 0; i < stage.Predicate.Num(); i++)
+	{
+		if (!checkPredicate(i))
 			return false;
 	}
 
@@ -221,25 +260,27 @@ bool UQuestRuntimeNode::CkeckForActivate()
 
 bool UQuestRuntimeNode::CkeckForComplete()
 {
-	for (auto& cond : Stage.WaitTriggers)
+	auto& stage = GetStage();
+
+	for (auto count : WaitTriggersCount)
 	{
-		if (cond.TotalCount != 0)
+		if (count > 0)
 			return false;
 	}
 
-	for (auto key : Stage.WaitHasKeys)
+	for (auto key : stage.WaitHasKeys)
 	{
 		if (Processor->StoryKeyManager->DontHasKey(key))
 			return false;
 	}
 
-	for (auto key : Stage.WaitDontHasKeys)
+	for (auto key : stage.WaitDontHasKeys)
 	{
 		if (Processor->StoryKeyManager->HasKey(key))
 			return false;
 	}
 
-	for (auto& Conditions : Stage.WaitPredicate)
+	for (auto& Conditions : stage.WaitPredicate)
 	{
 		if (!Conditions.InvokeCheck(this))
 			return false;
@@ -250,25 +291,27 @@ bool UQuestRuntimeNode::CkeckForComplete()
 
 bool UQuestRuntimeNode::CkeckForFailed()
 {
-	for (auto& cond : Stage.FailedTriggers)
+	auto& stage = GetStage();
+
+	for (auto count : FailedTriggersCount)
 	{
-		if (cond.TotalCount == 0)
+		if (count <= 0)
 			return true;
 	}
 
-	for (auto key : Stage.FailedIfGiveKeys)
+	for (auto key : stage.FailedIfGiveKeys)
 	{
 		if (Processor->StoryKeyManager->HasKey(key))
 			return true;
 	}
 
-	for (auto key : Stage.FailedIfRemoveKeys)
+	for (auto key : stage.FailedIfRemoveKeys)
 	{
 		if (Processor->StoryKeyManager->DontHasKey(key))
 			return true;
 	}
 
-	for (auto& Conditions : Stage.FailedPredicate)
+	for (auto& Conditions : stage.FailedPredicate)
 	{
 		if (Conditions.InvokeCheck(this))
 			return true;
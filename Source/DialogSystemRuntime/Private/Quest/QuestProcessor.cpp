@@ -7,32 +7,26 @@
 #include "QuestScript.h"
 #include "StoryInformationManager.h"
 #include "StoryTriggerManager.h"
+#include "StoryContext.h"
 #include "QaDSSettings.h"
 #include "Serialization/MemoryWriter.h"
 #include "Serialization/MemoryReader.h"
 
-UQuestProcessor* UQuestProcessor::Instance = NULL;
+DECLARE_CYCLE_STAT(TEXT("Quest key change"), STAT_QaDS_QuestKeyChange, STATGROUP_QaDS);
+DECLARE_CYCLE_STAT(TEXT("Quest load"), STAT_QaDS_QuestLoad, STATGROUP_QaDS);
+DECLARE_CYCLE_STAT(TEXT("Quest script spawn"), STAT_QaDS_QuestScriptSpawn, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pending quest scripts"), STAT_QaDS_PendingQuestScripts, STATGROUP_QaDS);
 
 UQuestProcessor* UQuestProcessor::GetQuestProcessor(UObject* WorldContextObject)
 {
-	if (Instance == NULL)
-		Instance = NewObject<UQuestProcessor>(WorldContextObject);
-
-	if (Instance->StoryKeyManager == NULL)
-		Instance->StoryKeyManager = UStoryKeyManager::GetStoryKeyManager(WorldContextObject);
-
-	if (Instance->StoryTriggerManager == NULL)
-		Instance->StoryTriggerManager = UStoryTriggerManager::GetStoryTriggerManager(WorldContextObject);
-
-	return Instance;
+	return UStoryContext::GetStoryContext(WorldContextObject)->QuestProcessor;
 }
 
-void UQuestProcessor::BeginDestroy()
+void UQuestProcessor::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
 {
-	Super::BeginDestroy();
-
-	if (Instance == this)
-		Instance = NULL;
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(archiveQuests.GetAllocatedSize() + activeQuests.GetAllocatedSize());
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(stageMasks.GetAllocatedSize() + changedKeys.GetAllocatedSize() + stageCandidates.GetAllocatedSize() + pendingScripts.GetAllocatedSize());
 }
 
 void UQuestProcessor::StartQuest(TAssetPtr<UQuestAsset> QuestAsset)
@@ -56,7 +50,8 @@ void UQuestProcessor::StartQuest(TAssetPtr<UQuestAsset> QuestAsset)
 		}
 	}
 	
-	auto runtimeQuest = NewObject<UQuestRuntimeAsset>();
+	auto runtimeQuest = NewObject<UQuestRuntimeAsset>(this);
+	runtimeQuest->Processor = this;
 	runtimeQuest->Status = EQuestCompleteStatus::Active;
 	runtimeQuest->Asset = quest;
 	runtimeQuest->CreateScript();
@@ -86,7 +81,7 @@ void UQuestProcessor::WaitStage(UQuestRuntimeNode* StageNode)
 
 	for (auto stage : stages)
 	{
-		isOptionalOnly &= stage->Stage.bIsOptional;
+		isOptionalOnly &= stage->GetStage().bIsOptional;
 	}
 
 	if (stages.Num() == 0 || isOptionalOnly)
@@ -107,6 +102,116 @@ void UQuestProcessor::WaitStage(UQuestRuntimeNode* StageNode)
 	}
 }
 
+void UQuestProcessor::RegisterStage(UQuestRuntimeNode* StageNode)
+{
+	check(StageNode);
+
+	if (!bIsKeyEventsBound)
+	{
+		StoryKeyManager->OnKeyAdd.AddUObject(this, &UQuestProcessor::OnKeyChanged);
+		StoryKeyManager->OnKeyRemove.AddUObject(this, &UQuestProcessor::OnKeyChanged);
+		bIsKeyEventsBound = true;
+	}
+
+	UnregisterStage(StageNode);
+
+	auto& stage = StageNode->GetStage();
+	auto toIds = [](const TArray<FName>& Keys, TArray<int32>& OutIds)
+	{
+		for (auto key : Keys)
+			OutIds.Add(FStoryKeyIds::Get(key));
+	};
+
+	FQuestStageMaskRow row;
+	toIds(stage.WaitHasKeys, row.WaitHas);
+	toIds(stage.WaitDontHasKeys, row.WaitDontHas);
+	toIds(stage.FailedIfGiveKeys, row.FailedIfGive);
+	toIds(stage.FailedIfRemoveKeys, row.FailedIfRemove);
+	row.bAlwaysCheck = stage.FailedPredicate.Num() > 0;
+
+	StageNode->MaskRow = stageMasks.Add(StageNode, row);
+}
+
+void UQuestProcessor::UnregisterStage(UQuestRuntimeNode* StageNode)
+{
+	auto row = StageNode->MaskRow;
+	StageNode->MaskRow = INDEX_NONE;
+
+	if (row == INDEX_NONE || row >= stageMasks.Num() || stageMasks.GetNode(row) != StageNode)
+		return;
+
+	stageMasks.Remove(row);
+
+	if (row < stageMasks.Num())
+		stageMasks.GetNode(row)->MaskRow = row;
+}
+
+void UQuestProcessor::OnKeyChanged(const FName& Key)
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_QuestKeyChange);
+
+	auto id = FStoryKeyIds::Find(Key);
+	auto numWords = stageMasks.GetNumWords();
+
+	// key is not used by any registered stage
+	if (id == INDEX_NONE || id >= numWords * 32 || stageMasks.Num() == 0)
+		return;
+
+	if (changedKeys.Num() < numWords)
+		changedKeys.SetNumZeroed(numWords);
+
+	changedKeys[id / 32] = 1u << (id % 32);
+
+	// stages may add keys on complete, which re-enters here
+	TArray<UQuestRuntimeNode*> candidates;
+	Swap(candidates, stageCandidates);
+	candidates.Reset();
+
+	stageMasks.Sweep(StoryKeyManager->GetKeyWords(numWords), changedKeys.GetData(), candidates);
+	changedKeys[id / 32] = 0;
+
+	for (auto stage : candidates)
+	{
+		if (stage->Status == EQuestCompleteStatus::Active)
+			stage->TryComplete();
+	}
+
+	Swap(candidates, stageCandidates);
+}
+
+void UQuestProcessor::QueueScriptSpawn(UQuestRuntimeAsset* Quest)
+{
+	pendingScripts.Add(Quest);
+	INC_DWORD_STAT(STAT_QaDS_PendingQuestScripts);
+}
+
+void UQuestProcessor::CancelScriptSpawn(UQuestRuntimeAsset* Quest)
+{
+	auto removed = pendingScripts.Remove(Quest);
+	DEC_DWORD_STAT_BY(STAT_QaDS_PendingQuestScripts, removed);
+}
+
+int32 UQuestProcessor::SpawnPendingScripts(double BudgetSeconds)
+{
+	if (pendingScripts.Num() == 0)
+		return 0;
+
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_QuestScriptSpawn);
+
+	auto endTime = FPlatformTime::Seconds() + BudgetSeconds;
+	auto spawned = 0;
+
+	// oldest first, SpawnScript removes the quest from the queue
+	do
+	{
+		pendingScripts[0]->SpawnScript();
+		spawned++;
+	}
+	while (pendingScripts.Num() > 0 && FPlatformTime::Seconds() < endTime);
+
+	return spawned;
+}
+
 void UQuestProcessor::CompleteStage(UQuestRuntimeNode* StageNode)
 {
 	if (bIsResetBegin)
@@ -118,19 +223,25 @@ void UQuestProcessor::CompleteStage(UQuestRuntimeNode* StageNode)
 	if(!activeQuests.Contains(StageNode->OwnerQuest))
 		return;
 
-	auto isNeedEvents = StageNode->Stage.bGenerateEvents;
-	isNeedEvents = !StageNode->Stage.Caption.IsEmpty();
+	BroadcastStageComplete(StageNode);
 
-	auto isEmpty = StageNode->Stage.Caption.IsEmpty();
+	if(StageNode->Status == EQuestCompleteStatus::Completed)
+		WaitStage(StageNode);
+}
+
+void UQuestProcessor::BroadcastStageComplete(UQuestRuntimeNode* StageNode)
+{
+	auto& stage = StageNode->GetStage();
+	auto isNeedEvents = stage.bGenerateEvents;
+	isNeedEvents = !stage.Caption.IsEmpty();
+
+	auto isEmpty = stage.Caption.IsEmpty();
 	auto generateForEmpty = !GetDefault<UQaDSSettings>()->bDontGenerateEventForEmptyQuestNode;
 	
-	if (generateForEmpty && StageNode->Stage.bGenerateEvents || !generateForEmpty && !isEmpty)
+	if (generateForEmpty && stage.bGenerateEvents || !generateForEmpty && !isEmpty)
 	{
-		OnStageComplete.Broadcast(StageNode->OwnerQuest, StageNode->Stage);
+		OnStageComplete.Broadcast(StageNode->OwnerQuest, stage);
 	}
-
-	if(StageNode->Status == EQuestCompleteStatus::Completed)
-		WaitStage(StageNode);
 }
 
 void UQuestProcessor::EndQuest(UQuestRuntimeAsset* Quest, EQuestCompleteStatus Status)
@@ -194,8 +305,79 @@ void UQuestProcessor::Reset()
 
 	archiveQuests.Reset();
 	activeQuests.Reset();
+	stageMasks.Reset();
 
 	bIsResetBegin = false;
+	OnQuestsLoaded.Broadcast();
+}
+
+UQuestRuntimeAsset* UQuestProcessor::MirrorQuestStart(UQuestAsset* QuestAsset)
+{
+	auto runtimeQuest = NewObject<UQuestRuntimeAsset>(this);
+	runtimeQuest->Processor = this;
+	runtimeQuest->Status = EQuestCompleteStatus::Active;
+	runtimeQuest->Asset = QuestAsset;
+
+	activeQuests.Add(runtimeQuest);
+	OnQuestStart.Broadcast(runtimeQuest);
+
+	return runtimeQuest;
+}
+
+void UQuestProcessor::MirrorQuestEnd(UQuestRuntimeAsset* Quest, EQuestCompleteStatus QuestStatus)
+{
+	if (!activeQuests.Remove(Quest))
+		return;
+
+	Quest->Status = QuestStatus;
+
+	if (GetDefault<UQaDSSettings>()->bUseQuestArchive)
+	{
+		archiveQuests.Add(Quest);
+	}
+
+	OnQuestEnd.Broadcast(Quest, QuestStatus);
+}
+
+void UQuestProcessor::MirrorQuestRemove(UQuestRuntimeAsset* Quest)
+{
+	activeQuests.Remove(Quest);
+	archiveQuests.Remove(Quest);
+}
+
+void UQuestProcessor::MirrorStageStatus(UQuestRuntimeAsset* Quest, const FGuid& UID, EQuestCompleteStatus StageStatus)
+{
+	UQuestRuntimeNode* node = NULL;
+
+	for (auto stage : Quest->ActiveNodes)
+	{
+		if (stage->UID == UID)
+			node = stage;
+	}
+
+	for (auto stage : Quest->ArchiveNodes)
+	{
+		if (stage->UID == UID)
+			node = stage;
+	}
+
+	if (node == NULL)
+		node = Quest->LoadNode(UID);
+
+	if (node == NULL || node->Status == StageStatus)
+		return;
+
+	node->Status = StageStatus;
+	Quest->ActiveNodes.Remove(node);
+	Quest->ArchiveNodes.Remove(node);
+
+	if (StageStatus == EQuestCompleteStatus::Active)
+		Quest->ActiveNodes.Add(node);
+	else
+		Quest->ArchiveNodes.Add(node);
+
+	if (StageStatus == EQuestCompleteStatus::Completed)
+		BroadcastStageComplete(node);
 }
 
 FArchive& operator<<(FArchive& Ar, UQuestProcessor& A)
@@ -224,21 +406,25 @@ FArchive& operator<<(FArchive& Ar, UQuestProcessor& A)
 
 	if (Ar.IsLoading())
 	{
+		for (auto quest : A.activeQuests)
+			quest->DestroyScript();
+
 		A.archiveQuests.Reset();
 		A.activeQuests.Reset();
+		A.stageMasks.Reset();
 
 		if (GetDefault<UQaDSSettings>()->bUseQuestArchive)
 		{
 			for (auto& archive : archiveQuestsArchive)
 			{
-				A.archiveQuests.Add(archive.Load());
+				A.archiveQuests.Add(archive.Load(&A));
 			}
 		}
 
 		for (auto& active : activeQuestsArchive)
 		{
-			auto quest = active.Load();
-			quest->CreateScript();
+			auto quest = active.Load(&A);
+			quest->CreateScript(GetDefault<UQaDSSettings>()->bDeferQuestScriptSpawn);
 			A.activeQuests.Add(quest);
 		}
 	}
@@ -257,6 +443,15 @@ TArray<uint8> UQuestProcessor::SaveToBinary()
 
 void UQuestProcessor::LoadFromBinary(const TArray<uint8>& Data)
 {
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_QuestLoad);
+
+	auto startTime = FPlatformTime::Seconds();
+
 	FMemoryReader reader(Data);
 	reader << *this;
+
+	UE_LOG(DialogModuleLog, Log, TEXT("Loaded %d active quests in %.2f ms, %d quest scripts deferred"),
+		activeQuests.Num(), (FPlatformTime::Seconds() - startTime) * 1000, pendingScripts.Num());
+
+	OnQuestsLoaded.Broadcast();
 }
\ No newline at end of file
@@ -10,6 +10,9 @@
 #include "QuestAsset.h"
 #include "QuestScript.h"
 #include "QuestStageEvent.h"
+#include "StoryNativeRegistry.h"
+#include "StoryContext.h"
+#include "GameFramework/Pawn.h"
 
 bool FQuestStageEvent::Compile(UQuestAsset* Quest, FString& ErrorMessage)
 {
@@ -19,6 +22,9 @@ bool FQuestStageEvent::Compile(UQuestAsset* Quest, FString& ErrorMessage)
 		return false;
 	}
 
+	if (CallType == EQuestStageEventCallType::Native)
+		return CompileNative(false, ErrorMessage);
+
 	if (ObjectClass == NULL && CallType != EQuestStageEventCallType::QuestScript)
 	{
 		ErrorMessage = FString::Printf(TEXT("Object classis empty"));
@@ -94,6 +100,11 @@ bool FQuestStageEvent::Compile(UQuestAsset* Quest, FString& ErrorMessage)
 
 bool FQuestStageCondition::Compile(UQuestAsset* Quest, FString& ErrorMessage)
 {
+	CommandHash = 0;
+
+	if (CallType == EQuestStageEventCallType::Native)
+		return CompileNative(true, ErrorMessage);
+
 	if (!Super::Compile(Quest, ErrorMessage))
 		return false;
 
@@ -120,6 +131,21 @@ bool FQuestStageCondition::Compile(UQuestAsset* Quest, FString& ErrorMessage)
 	return true;
 }
 
+bool FQuestStageEvent::CompileNative(bool bIsCondition, FString& ErrorMessage)
+{
+	NativeCall = FStoryNativeRegistry::Get().Compile(EventName, bIsCondition, Parameters, Command, ErrorMessage);
+	if (!NativeCall.IsValid())
+		return false;
+
+	ObjectClass = NULL;
+	return true;
+}
+
+bool FQuestStageEvent::BindNative(bool bIsCondition) const
+{
+	return FStoryNativeRegistry::Get().BindOnce(EventName, bIsCondition, Parameters, NativeCall);
+}
+
 UObject* FQuestStageEvent::GetObject(UQuestRuntimeNode* QuestNode) const
 {
 	UObject* obj = NULL;
@@ -128,17 +154,18 @@ UObject* FQuestStageEvent::GetObject(UQuestRuntimeNode* QuestNode) const
 	switch (CallType)
 	{
 	case EQuestStageEventCallType::QuestScript:
+		if (quest->IsScriptPending())
+			quest->SpawnScript();
+
 		obj = Cast<UObject>(quest->Script);
 		break;
 
 	case EQuestStageEventCallType::Player:
-		if (quest->Script == NULL)
-		{
-			UE_LOG(DialogModuleLog, Warning, TEXT("Need QuestScript for EQuestStageEventCallType::Player in %s"), *quest->GetPathName());
-			return NULL;
-		}
+		obj = QuestNode->Processor->StoryContext->GetPlayerPawn();
+		break;
 
-		obj = UGameplayStatics::GetPlayerCharacter(quest->Script->GetWorld(), 0);
+	case EQuestStageEventCallType::Native:
+		obj = QuestNode;
 		break;
 
 	case EQuestStageEventCallType::FindByTag:
@@ -176,11 +203,30 @@ UObject* FQuestStageEvent::GetObject(UQuestRuntimeNode* QuestNode) const
 	return obj;
 }
 
-void FQuestStageEvent::Invoke(UQuestRuntimeNode* QuestNode)
+void FQuestStageEvent::Invoke(UQuestRuntimeNode* QuestNode) const
 {
+	if (CallType == EQuestStageEventCallType::Native)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QaDS_NativeCall);
+
+		if (BindNative(false))
+			NativeCall->Call(QuestNode);
+
+		return;
+	}
+
+	// run when the deferred script is spawned
+	if (CallType == EQuestStageEventCallType::QuestScript && QuestNode->OwnerQuest->IsScriptPending())
+	{
+		QuestNode->OwnerQuest->QueueScriptCommand(Command);
+		return;
+	}
+
 	auto obj = GetObject(QuestNode);
 	if (obj != NULL)
 	{ 
+		SCOPE_CYCLE_COUNTER(STAT_QaDS_ReflectionCall);
+
 		auto ar = FOutputDeviceRedirector::Get();
 		obj->CallFunctionByNameWithArguments(*Command, *ar, obj, true);
 	}
@@ -210,6 +256,9 @@ FString FQuestStageEvent::ToString() const
 	case EQuestStageEventCallType::Player:
 		return TEXT("Player.") + funcName;
 
+	case EQuestStageEventCallType::Native:
+		return TEXT("Native.") + funcName;
+
 	case EQuestStageEventCallType::FindByTag:
 		if (ObjectClass)
 			return ObjectClass->GetName() + TEXT("[") + FindTag + TEXT("].") + funcName;
@@ -222,6 +271,7 @@ FString FQuestStageEvent::ToString() const
 bool FQuestStageCondition::InvokeCheck(UQuestRuntimeNode* QuestNode) const
 {
 	auto obj = GetObject(QuestNode);
+	auto context = QuestNode->Processor ? QuestNode->Processor->StoryContext : NULL;
 
 	if (obj == NULL)
 	{
@@ -229,13 +279,22 @@ bool FQuestStageCondition::InvokeCheck(UQuestRuntimeNode* QuestNode) const
 		return false;
 	}
 
-	bool checkResult;
-	if (!CallCheckFunction(obj, *Command, checkResult) || !checkResult)
+	auto cache = bIsPure && context != NULL ? &context->PredicateCache : NULL;
+	auto keysVersion = cache != NULL && context->StoryKeyManager != NULL ? context->StoryKeyManager->GetKeysVersion() : 0;
+
+	if (cache != NULL && CommandHash == 0)
+		CommandHash = FStoryPredicateCache::HashCommand(Command);
+
+	bool checkResult = false;
+	if (cache == NULL || !cache->Find(obj, EventName, Command, CommandHash, keysVersion, checkResult))
 	{
-		return InvertCondition;
+		checkResult = CallCheck(obj);
+
+		if (cache != NULL)
+			cache->Add(obj, EventName, Command, CommandHash, checkResult);
 	}
 
-	return !InvertCondition;
+	return checkResult != InvertCondition;
 }
 
 FString FQuestStageCondition::ToString() const
@@ -248,6 +307,20 @@ FString FQuestStageCondition::ToString() const
 	return baseText;
 }
 
+bool FQuestStageCondition::CallCheck(UObject* Executor) const
+{
+	if (CallType == EQuestStageEventCallType::Native)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_QaDS_NativeCall);
+		return BindNative(true) && NativeCall->Call(Executor);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_ReflectionCall);
+
+	bool checkResult = false;
+	return CallCheckFunction(Executor, *Command, checkResult) && checkResult;
+}
+
 // Copy from ScriptCore.cpp UObject::CallFunctionByNameWithArguments
 bool FQuestStageCondition::CallCheckFunction(UObject* Executor, const TCHAR* Str, bool& checkResult) const
 {
@@ -0,0 +1,178 @@
+#include "DialogSystemRuntime.h"
+#include "QuestStageMaskTable.h"
+#include "QuestNode.h"
+#include "Math/VectorRegister.h"
+
+DECLARE_CYCLE_STAT(TEXT("Stage mask sweep"), STAT_QaDS_StageMaskSweep, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Stage mask rows"), STAT_QaDS_StageMaskRows, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Stage mask candidates"), STAT_QaDS_StageMaskCandidates, STATGROUP_QaDS);
+
+static void SetMaskBits(uint32* Words, const TArray<int32>& Ids)
+{
+	for (auto id : Ids)
+		Words[id / 32] |= 1u << (id % 32);
+}
+
+int32 FQuestStageMaskTable::Add(UQuestRuntimeNode* Node, const FQuestStageMaskRow& Row)
+{
+	int32 maxId = -1;
+	for (auto ids : { &Row.WaitHas, &Row.WaitDontHas, &Row.FailedIfGive, &Row.FailedIfRemove })
+	{
+		for (auto id : *ids)
+			maxId = FMath::Max(maxId, id);
+	}
+
+	if (maxId >= numWords * 32)
+		Resize(Align(maxId / 32 + 1, 4));
+
+	auto row = nodes.Add(Node);
+	alwaysCheck.Add(Row.bAlwaysCheck);
+
+	for (auto& column : columns)
+		column.AddZeroed(numWords);
+
+	auto offset = row * numWords;
+	SetMaskBits(&columns[WaitHas][offset], Row.WaitHas);
+	SetMaskBits(&columns[WaitDontHas][offset], Row.WaitDontHas);
+	SetMaskBits(&columns[FailedIfGive][offset], Row.FailedIfGive);
+	SetMaskBits(&columns[FailedIfRemove][offset], Row.FailedIfRemove);
+
+	for (auto i = 0; i < numWords; i++)
+	{
+		columns[Watch][offset + i] =
+			columns[WaitHas][offset + i] |
+			columns[WaitDontHas][offset + i] |
+			columns[FailedIfGive][offset + i] |
+			columns[FailedIfRemove][offset + i];
+	}
+
+	INC_DWORD_STAT(STAT_QaDS_StageMaskRows);
+	return row;
+}
+
+// last row moves into the removed one, callers must update its index
+void FQuestStageMaskTable::Remove(int32 Row)
+{
+	auto last = nodes.Num() - 1;
+
+	if (Row != last)
+	{
+		for (auto& column : columns)
+			FMemory::Memcpy(&column[Row * numWords], &column[last * numWords], numWords * sizeof(uint32));
+	}
+
+	nodes.RemoveAtSwap(Row, 1, false);
+	alwaysCheck.RemoveAtSwap(Row, 1, false);
+
+	for (auto& column : columns)
+		column.SetNum(last * numWords, false);
+
+	DEC_DWORD_STAT(STAT_QaDS_StageMaskRows);
+}
+
+void FQuestStageMaskTable::Reset()
+{
+	DEC_DWORD_STAT_BY(STAT_QaDS_StageMaskRows, nodes.Num());
+
+	nodes.Reset();
+	alwaysCheck.Reset();
+
+	for (auto& column : columns)
+		column.Reset();
+}
+
+void FQuestStageMaskTable::Resize(int32 NewNumWords)
+{
+	for (auto& column : columns)
+	{
+		TArray<uint32> resized;
+		resized.AddZeroed(nodes.Num() * NewNumWords);
+
+		for (auto row = 0; row < nodes.Num(); row++)
+			FMemory::Memcpy(&resized[row * NewNumWords], &column[row * numWords], numWords * sizeof(uint32));
+
+		column = MoveTemp(resized);
+	}
+
+	numWords = NewNumWords;
+}
+
+SIZE_T FQuestStageMaskTable::GetAllocatedSize() const
+{
+	auto size = nodes.GetAllocatedSize() + alwaysCheck.GetAllocatedSize();
+
+	for (auto& column : columns)
+		size += column.GetAllocatedSize();
+
+	return size;
+}
+
+static FORCEINLINE bool AnyBits(VectorRegisterInt Value)
+{
+	uint32 lanes[4];
+	VectorIntStore(Value, lanes);
+
+	return (lanes[0] | lanes[1] | lanes[2] | lanes[3]) != 0;
+}
+
+void FQuestStageMaskTable::Sweep(const uint32* Keys, const uint32* Changed, TArray<UQuestRuntimeNode*>& OutCandidates) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_StageMaskSweep);
+
+	auto waitHas = columns[WaitHas].GetData();
+	auto waitDontHas = columns[WaitDontHas].GetData();
+	auto failedIfGive = columns[FailedIfGive].GetData();
+	auto failedIfRemove = columns[FailedIfRemove].GetData();
+	auto watch = columns[Watch].GetData();
+
+	for (auto row = 0; row < nodes.Num(); row++)
+	{
+		auto offset = row * numWords;
+
+		auto watched = GlobalVectorConstants::IntZero;
+		auto blocked = GlobalVectorConstants::IntZero;
+		auto failed = GlobalVectorConstants::IntZero;
+
+		for (auto i = 0; i < numWords; i += 4)
+		{
+			auto keys = VectorIntLoad(Keys + i);
+			auto changed = VectorIntLoad(Changed + i);
+
+			watched = VectorIntOr(watched, VectorIntAnd(VectorIntLoad(watch + offset + i), changed));
+
+			// required key is missing or forbidden key is present
+			blocked = VectorIntOr(blocked, VectorIntAndNot(keys, VectorIntLoad(waitHas + offset + i)));
+			blocked = VectorIntOr(blocked, VectorIntAnd(VectorIntLoad(waitDontHas + offset + i), keys));
+
+			failed = VectorIntOr(failed, VectorIntAnd(VectorIntLoad(failedIfGive + offset + i), keys));
+			failed = VectorIntOr(failed, VectorIntAndNot(keys, VectorIntLoad(failedIfRemove + offset + i)));
+		}
+
+		if (!AnyBits(watched))
+			continue;
+
+		if (alwaysCheck[row] || !AnyBits(blocked) || AnyBits(failed))
+			OutCandidates.Add(nodes[row]);
+	}
+
+	INC_DWORD_STAT_BY(STAT_QaDS_StageMaskCandidates, OutCandidates.Num());
+}
+
+void FQuestStageMaskTable::SweepScalar(const uint32* Keys, const uint32* Changed, TArray<UQuestRuntimeNode*>& OutCandidates) const
+{
+	for (auto row = 0; row < nodes.Num(); row++)
+	{
+		auto offset = row * numWords;
+		uint32 watched = 0, blocked = 0, failed = 0;
+
+		for (auto i = 0; i < numWords; i++)
+		{
+			watched |= columns[Watch][offset + i] & Changed[i];
+			blocked |= (columns[WaitHas][offset + i] & ~Keys[i]) | (columns[WaitDontHas][offset + i] & Keys[i]);
+			failed |= (columns[FailedIfGive][offset + i] & Keys[i]) | (columns[FailedIfRemove][offset + i] & ~Keys[i]);
+		}
+
+		if (watched != 0 && (alwaysCheck[row] || blocked == 0 || failed != 0))
+			OutCandidates.Add(nodes[row]);
+	}
+}
\ No newline at end of file
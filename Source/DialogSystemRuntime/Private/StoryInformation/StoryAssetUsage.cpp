@@ -0,0 +1,97 @@
+#include "DialogSystemRuntime.h"
+#include "StoryAssetUsage.h"
+
+const FName FStoryAssetUsage::GiveKeysTag("StoryGiveKeys");
+const FName FStoryAssetUsage::CheckKeysTag("StoryCheckKeys");
+const FName FStoryAssetUsage::RemoveKeysTag("StoryRemoveKeys");
+const FName FStoryAssetUsage::WaitTriggersTag("StoryWaitTriggers");
+const FName FStoryAssetUsage::StartQuestsTag("StoryStartQuests");
+
+static void NormalizeNames(TArray<FName>& Names)
+{
+	TSet<FName> unique(Names);
+	unique.Remove(NAME_None);
+
+	Names = unique.Array();
+	Names.Sort([](const FName& a, const FName& b)
+	{
+		return a.Compare(b) < 0;
+	});
+}
+
+// commas separate the names of a tag value, inside names they are written as %2C and % as %25
+static FString EscapeName(const FName& Name)
+{
+	auto text = Name.ToString();
+
+	int32 index;
+	if (text.FindChar(',', index) || text.FindChar('%', index))
+	{
+		text.ReplaceInline(TEXT("%"), TEXT("%25"));
+		text.ReplaceInline(TEXT(","), TEXT("%2C"));
+	}
+
+	return text;
+}
+
+static FString UnescapeName(const FString& Text)
+{
+	int32 index;
+	if (!Text.FindChar('%', index))
+		return Text;
+
+	auto text = Text.Replace(TEXT("%2C"), TEXT(","));
+	text.ReplaceInline(TEXT("%25"), TEXT("%"));
+
+	return text;
+}
+
+static FString JoinNames(const TArray<FName>& Names)
+{
+	FString value = TEXT(",");
+	for (auto& name : Names)
+		value += EscapeName(name) + TEXT(",");
+
+	return value;
+}
+
+void FStoryAssetUsage::Reset()
+{
+	GiveKeys.Reset();
+	CheckKeys.Reset();
+	RemoveKeys.Reset();
+	WaitTriggers.Reset();
+	StartQuests.Reset();
+}
+
+void FStoryAssetUsage::Normalize()
+{
+	NormalizeNames(GiveKeys);
+	NormalizeNames(CheckKeys);
+	NormalizeNames(RemoveKeys);
+	NormalizeNames(WaitTriggers);
+	NormalizeNames(StartQuests);
+}
+
+void FStoryAssetUsage::GetAssetRegistryTags(TArray<UObject::FAssetRegistryTag>& OutTags) const
+{
+	OutTags.Add(UObject::FAssetRegistryTag(GiveKeysTag, JoinNames(GiveKeys), UObject::FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(UObject::FAssetRegistryTag(CheckKeysTag, JoinNames(CheckKeys), UObject::FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(UObject::FAssetRegistryTag(RemoveKeysTag, JoinNames(RemoveKeys), UObject::FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(UObject::FAssetRegistryTag(WaitTriggersTag, JoinNames(WaitTriggers), UObject::FAssetRegistryTag::TT_Alphabetical));
+	OutTags.Add(UObject::FAssetRegistryTag(StartQuestsTag, JoinNames(StartQuests), UObject::FAssetRegistryTag::TT_Alphabetical));
+}
+
+bool FStoryAssetUsage::TagContains(const FString& TagValue, const FName& Name)
+{
+	return TagValue.Contains(TEXT(",") + EscapeName(Name) + TEXT(","));
+}
+
+void FStoryAssetUsage::ParseTag(const FString& TagValue, TArray<FName>& OutNames)
+{
+	TArray<FString> names;
+	TagValue.ParseIntoArray(names, TEXT(","));
+
+	for (auto& name : names)
+		OutNames.Add(*UnescapeName(name));
+}
\ No newline at end of file
@@ -0,0 +1,306 @@
+#include "DialogSystemRuntime.h"
+#include "StoryConditionExpression.h"
+#include "StoryInformationManager.h"
+
+namespace
+{
+	enum class EStoryExprNode : uint8
+	{
+		Key,
+		Predicate,
+		Not,
+		And,
+		Or,
+	};
+
+	struct FStoryExprNode
+	{
+		EStoryExprNode Type;
+		int32 Index = 0;
+		bool bHasPredicate = false;
+		TArray<TSharedPtr<FStoryExprNode>> Childs;
+
+		FStoryExprNode(EStoryExprNode InType) : Type(InType) {}
+	};
+
+	typedef TSharedPtr<FStoryExprNode> FStoryExprNodePtr;
+
+	// expression := and ('|' and)*,  and := unary ('&' unary)*,  unary := '!' unary | '(' expression ')' | Pred(N) | key
+	class FStoryExprParser
+	{
+		const FString& text;
+		int32 numPredicates;
+		TArray<FName>& keys;
+		FString& error;
+		int32 pos;
+
+		TCHAR Peek()
+		{
+			while (pos < text.Len() && FChar::IsWhitespace(text[pos]))
+				pos++;
+
+			return pos < text.Len() ? text[pos] : 0;
+		}
+
+		// '&&' and '||' are accepted as well
+		bool Match(TCHAR c)
+		{
+			if (Peek() != c)
+				return false;
+
+			pos++;
+			if ((c == '&' || c == '|') && pos < text.Len() && text[pos] == c)
+				pos++;
+
+			return true;
+		}
+
+		static bool IsIdentifierChar(TCHAR c)
+		{
+			return FChar::IsAlnum(c) || c == '_' || c == '.';
+		}
+
+		FStoryExprNodePtr Error(const TCHAR* Message)
+		{
+			if (error.IsEmpty())
+				error = FString::Printf(TEXT("Condition \"%s\": %s at %d"), *text, Message, pos);
+
+			return nullptr;
+		}
+
+		static FStoryExprNodePtr MakeGroup(EStoryExprNode Type, FStoryExprNodePtr Left, FStoryExprNodePtr Right)
+		{
+			auto group = Left->Type == Type ? Left : MakeShared<FStoryExprNode>(Type);
+			if (group != Left)
+				group->Childs.Add(Left);
+
+			if (Right->Type == Type)
+				group->Childs.Append(Right->Childs);
+			else
+				group->Childs.Add(Right);
+
+			group->bHasPredicate = Left->bHasPredicate || Right->bHasPredicate;
+			return group;
+		}
+
+		FStoryExprNodePtr ParseExpression()
+		{
+			auto left = ParseAnd();
+			while (left.IsValid() && Match('|'))
+			{
+				auto right = ParseAnd();
+				if (!right.IsValid())
+					return nullptr;
+
+				left = MakeGroup(EStoryExprNode::Or, left, right);
+			}
+
+			return left;
+		}
+
+		FStoryExprNodePtr ParseAnd()
+		{
+			auto left = ParseUnary();
+			while (left.IsValid() && Match('&'))
+			{
+				auto right = ParseUnary();
+				if (!right.IsValid())
+					return nullptr;
+
+				left = MakeGroup(EStoryExprNode::And, left, right);
+			}
+
+			return left;
+		}
+
+		FStoryExprNodePtr ParseUnary()
+		{
+			if (Match('!'))
+			{
+				auto child = ParseUnary();
+				if (!child.IsValid())
+					return nullptr;
+
+				auto node = MakeShared<FStoryExprNode>(EStoryExprNode::Not);
+				node->bHasPredicate = child->bHasPredicate;
+				node->Childs.Add(child);
+				return node;
+			}
+
+			if (Match('('))
+			{
+				auto node = ParseExpression();
+				if (!node.IsValid())
+					return nullptr;
+
+				if (!Match(')'))
+					return Error(TEXT("expected ')'"));
+
+				return node;
+			}
+
+			if (!IsIdentifierChar(Peek()))
+				return Error(Peek() == 0 ? TEXT("unexpected end") : TEXT("expected key or Pred(N)"));
+
+			auto start = pos;
+			while (pos < text.Len() && IsIdentifierChar(text[pos]))
+				pos++;
+
+			auto identifier = text.Mid(start, pos - start);
+
+			if (identifier == TEXT("Pred") && Match('('))
+			{
+				auto numberStart = pos;
+				while (pos < text.Len() && FChar::IsDigit(text[pos]))
+					pos++;
+
+				if (numberStart == pos)
+					return Error(TEXT("expected predicate index"));
+
+				auto index = FCString::Atoi(*text.Mid(numberStart, pos - numberStart));
+				if (index >= numPredicates)
+					return Error(*FString::Printf(TEXT("predicate %d not found, node has %d predicates"), index, numPredicates));
+
+				if (!Match(')'))
+					return Error(TEXT("expected ')'"));
+
+				auto node = MakeShared<FStoryExprNode>(EStoryExprNode::Predicate);
+				node->Index = index;
+				node->bHasPredicate = true;
+				return node;
+			}
+
+			auto node = MakeShared<FStoryExprNode>(EStoryExprNode::Key);
+			node->Index = keys.AddUnique(*identifier);
+			return node;
+		}
+
+	public:
+		FStoryExprParser(const FString& Text, int32 NumPredicates, TArray<FName>& Keys, FString& Error)
+			: text(Text), numPredicates(NumPredicates), keys(Keys), error(Error), pos(0)
+		{
+		}
+
+		FStoryExprNodePtr Parse()
+		{
+			auto root = ParseExpression();
+			if (root.IsValid() && Peek() != 0)
+				return Error(TEXT("unexpected symbol"));
+
+			return root;
+		}
+	};
+
+	void EmitNode(FStoryExprNode& Node, TArray<FStoryConditionInstruction>& Program)
+	{
+		FStoryConditionInstruction instruction;
+
+		switch (Node.Type)
+		{
+		case EStoryExprNode::Key:
+		case EStoryExprNode::Predicate:
+			instruction.Op = Node.Type == EStoryExprNode::Key ? EStoryConditionOp::Key : EStoryConditionOp::Predicate;
+			instruction.Arg = Node.Index;
+			Program.Add(instruction);
+			break;
+
+		case EStoryExprNode::Not:
+			EmitNode(*Node.Childs[0], Program);
+			instruction.Op = EStoryConditionOp::Not;
+			Program.Add(instruction);
+			break;
+
+		case EStoryExprNode::And:
+		case EStoryExprNode::Or:
+		{
+			// key tests are cheap, predicates call into game code
+			Node.Childs.StableSort([](const FStoryExprNodePtr& A, const FStoryExprNodePtr& B)
+			{
+				return !A->bHasPredicate && B->bHasPredicate;
+			});
+
+			TArray<int32> jumps;
+			for (int32 i = 0; i < Node.Childs.Num(); i++)
+			{
+				if (i != 0)
+				{
+					instruction.Op = Node.Type == EStoryExprNode::And ? EStoryConditionOp::JumpIfFalse : EStoryConditionOp::JumpIfTrue;
+					jumps.Add(Program.Add(instruction));
+				}
+
+				EmitNode(*Node.Childs[i], Program);
+			}
+
+			for (auto jump : jumps)
+				Program[jump].Arg = Program.Num();
+		}
+			break;
+		}
+	}
+}
+
+bool FStoryConditionExpression::Compile(int32 NumPredicates, FString& ErrorMessage)
+{
+	Keys.Empty();
+	Program.Empty();
+
+	if (Expression.TrimStartAndEnd().IsEmpty())
+		return true;
+
+	FString error;
+	auto root = FStoryExprParser(Expression, NumPredicates, Keys, error).Parse();
+
+	if (root.IsValid())
+		EmitNode(*root, Program);
+
+	if (root.IsValid() && Program.Num() > MAX_uint16)
+		error = FString::Printf(TEXT("Condition \"%s\" is too long"), *Expression);
+
+	if (!error.IsEmpty())
+	{
+		Keys.Empty();
+		Program.Empty();
+		ErrorMessage = error;
+		return false;
+	}
+
+	return true;
+}
+
+bool FStoryConditionExpression::Evaluate(const UStoryKeyManager* StoryKeyManager, TFunctionRef<bool(int32)> CheckPredicate) const
+{
+	if (Program.Num() == 0)
+		return true;
+
+	TArray<bool, TInlineAllocator<16>> stack;
+
+	for (int32 i = 0; i < Program.Num(); i++)
+	{
+		auto& instruction = Program[i];
+
+		switch (instruction.Op)
+		{
+		case EStoryConditionOp::Key:
+			stack.Push(StoryKeyManager->HasKey(Keys[instruction.Arg]));
+			break;
+
+		case EStoryConditionOp::Predicate:
+			stack.Push(CheckPredicate(instruction.Arg));
+			break;
+
+		case EStoryConditionOp::Not:
+			stack.Last() = !stack.Last();
+			break;
+
+		case EStoryConditionOp::JumpIfFalse:
+		case EStoryConditionOp::JumpIfTrue:
+			if (stack.Last() == (instruction.Op == EStoryConditionOp::JumpIfTrue))
+				i = instruction.Arg - 1;
+			else
+				stack.Pop(false);
+			break;
+		}
+	}
+
+	return stack.Num() > 0 && stack.Last();
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+#include "DialogSystemRuntime.h"
+#include "StoryContext.h"
+#include "StoryPlayerComponent.h"
+#include "StoryInformationManager.h"
+#include "StoryTriggerManager.h"
+#include "QuestProcessor.h"
+#include "StoryObjectPool.h"
+#include "DialogBarkManager.h"
+#include "DialogScheduler.h"
+#include "QaDSSettings.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/Pawn.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Story contexts"), STAT_QaDS_StoryContexts, STATGROUP_QaDS);
+DECLARE_CYCLE_STAT(TEXT("Story inbox"), STAT_QaDS_StoryInbox, STATGROUP_QaDS);
+
+static TMap<TWeakObjectPtr<UGameInstance>, TWeakObjectPtr<UStoryContext>> GameInstanceContexts;
+static TWeakObjectPtr<UStoryContext> FallbackContext;
+static int32 NumStoryContexts = 0;
+
+// lookups of the current frame, owners and possession may change between frames
+static TMap<TWeakObjectPtr<UObject>, TWeakObjectPtr<UStoryContext>> FrameContexts;
+static uint64 FrameContextsFrame = 0;
+
+UStoryContext* UStoryContext::GetStoryContext(UObject* WorldContextObject)
+{
+	if (WorldContextObject == NULL)
+		return FindStoryContext(NULL);
+
+	if (FrameContextsFrame != GFrameCounter)
+	{
+		FrameContexts.Reset();
+		FrameContextsFrame = GFrameCounter;
+	}
+
+	auto cached = FrameContexts.FindRef(WorldContextObject);
+	if (cached.IsValid())
+		return cached.Get();
+
+	auto context = FindStoryContext(WorldContextObject);
+	FrameContexts.Add(WorldContextObject, context);
+
+	return context;
+}
+
+void UStoryContext::ReleaseFallbackContext()
+{
+	if (FallbackContext.IsValid())
+		FallbackContext->RemoveFromRoot();
+
+	FallbackContext = NULL;
+	FrameContexts.Reset();
+}
+
+UStoryContext* UStoryContext::FindStoryContext(UObject* WorldContextObject)
+{
+	for (auto outer = WorldContextObject; outer != NULL; outer = outer->GetOuter())
+	{
+		auto context = Cast<UStoryContext>(outer);
+		if (context != NULL)
+			return context;
+	}
+
+	auto playerComponent = UStoryPlayerComponent::FindPlayerComponent(WorldContextObject);
+	if (playerComponent != NULL)
+		return playerComponent->GetStoryContext();
+
+	auto world = WorldContextObject ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : NULL;
+	auto gameInstance = world ? world->GetGameInstance() : NULL;
+
+	if (gameInstance == NULL)
+	{
+		if (!FallbackContext.IsValid())
+		{
+			FallbackContext = CreateStoryContext(GetTransientPackage());
+			FallbackContext->AddToRoot();
+		}
+
+		return FallbackContext.Get();
+	}
+
+	auto existContext = GameInstanceContexts.FindRef(gameInstance);
+	if (existContext.IsValid())
+		return existContext.Get();
+
+	for (auto it = GameInstanceContexts.CreateIterator(); it; ++it)
+	{
+		if (!it.Key().IsValid() || !it.Value().IsValid())
+			it.RemoveCurrent();
+	}
+
+	auto context = CreateStoryContext(gameInstance);
+	gameInstance->RegisterReferencedObject(context);
+	GameInstanceContexts.Add(gameInstance, context);
+
+	return context;
+}
+
+UStoryContext* UStoryContext::CreateStoryContext(UObject* Outer)
+{
+	auto context = NewObject<UStoryContext>(Outer);
+	context->OwnerComponent = Cast<UStoryPlayerComponent>(Outer);
+	context->StoryKeyManager = NewObject<UStoryKeyManager>(context);
+	context->StoryTriggerManager = NewObject<UStoryTriggerManager>(context);
+	context->ObjectPool = NewObject<UStoryObjectPool>(context);
+	context->BarkManager = NewObject<UDialogBarkManager>(context);
+	context->DialogScheduler = NewObject<UDialogScheduler>(context);
+
+	context->QuestProcessor = NewObject<UQuestProcessor>(context);
+	context->QuestProcessor->StoryContext = context;
+	context->QuestProcessor->StoryKeyManager = context->StoryKeyManager;
+	context->QuestProcessor->StoryTriggerManager = context->StoryTriggerManager;
+
+	NumStoryContexts++;
+	INC_DWORD_STAT(STAT_QaDS_StoryContexts);
+
+	return context;
+}
+
+int32 UStoryContext::GetNumContexts()
+{
+	return NumStoryContexts;
+}
+
+void UStoryContext::BeginDestroy()
+{
+	Super::BeginDestroy();
+
+	if (StoryKeyManager != NULL)
+	{
+		NumStoryContexts--;
+		DEC_DWORD_STAT(STAT_QaDS_StoryContexts);
+	}
+}
+
+APawn* UStoryContext::GetPlayerPawn() const
+{
+	if (OwnerComponent != NULL)
+		return OwnerComponent->GetPlayerPawn();
+
+	return UGameplayStatics::GetPlayerPawn(GetOuter(), 0);
+}
+
+bool UStoryContext::IsPlayerContext() const
+{
+	return OwnerComponent != NULL;
+}
+
+void UStoryContext::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_QaDS_StoryInbox);
+
+	StoryKeyManager->ProcessInbox();
+	StoryTriggerManager->ProcessInbox();
+	StoryKeyManager->PublishSnapshot();
+
+	QuestProcessor->SpawnPendingScripts(GetDefault<UQaDSSettings>()->QuestScriptSpawnBudgetMs / 1000.0);
+}
+
+bool UStoryContext::IsTickable() const
+{
+	return StoryKeyManager != NULL && !IsPendingKillOrUnreachable();
+}
+
+bool UStoryContext::IsTickableWhenPaused() const
+{
+	return true;
+}
+
+TStatId UStoryContext::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStoryContext, STATGROUP_QaDS);
+}
\ No newline at end of file
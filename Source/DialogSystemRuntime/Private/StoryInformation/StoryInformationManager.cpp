@@ -2,25 +2,116 @@
 #include "EngineUtils.h"
 #include "Runtime/CoreUObject/Public/UObject/UObjectIterator.h"
 #include "StoryInformationManager.h"
+#include "StoryContext.h"
 #include "Serialization/MemoryWriter.h"
 #include "Serialization/MemoryReader.h"
 
-UStoryKeyManager* UStoryKeyManager::Instance = NULL;
+DECLARE_DWORD_COUNTER_STAT(TEXT("Key snapshots published"), STAT_QaDS_KeySnapshots, STATGROUP_QaDS);
+
+static TMap<FName, int32> StoryKeyIds;
+
+int32 FStoryKeyIds::Get(FName Key)
+{
+	check(IsInGameThread());
+
+	auto id = StoryKeyIds.Find(Key);
+	if (id != NULL)
+		return *id;
+
+	return StoryKeyIds.Add(Key, StoryKeyIds.Num());
+}
+
+int32 FStoryKeyIds::Find(FName Key)
+{
+	auto id = StoryKeyIds.Find(Key);
+	return id ? *id : INDEX_NONE;
+}
+
+int32 FStoryKeyIds::Num()
+{
+	return StoryKeyIds.Num();
+}
+
+FStoryKeyChangeScope* FStoryKeyChangeScope::current = NULL;
+
+FStoryKeyChangeScope::FStoryKeyChangeScope(const TCHAR* InKind, const UObject* InObject, FName InDetail)
+	: kind(InKind), object(InObject), detail(InDetail), previous(current)
+{
+	current = this;
+}
+
+FStoryKeyChangeScope::~FStoryKeyChangeScope()
+{
+	current = previous;
+}
+
+FString FStoryKeyChangeScope::GetSource()
+{
+	if (current == NULL)
+		return FString();
+
+	auto source = FString(current->kind);
+
+	if (current->object != NULL)
+		source += TEXT(" ") + current->object->GetName();
+
+	if (!current->detail.IsNone())
+		source += TEXT(" ") + current->detail.ToString();
+
+	return source;
+}
+
+UStoryKeyManager::UStoryKeyManager()
+	: version(0)
+	, snapshotVersion(0)
+	, keptSnapshotIndex(0)
+{
+	keptSnapshots[0] = MakeShareable(new FStoryKeySnapshot(TSet<FName>(), 0));
+	publishedSnapshot.Store(keptSnapshots[0].Get());
+}
 
 UStoryKeyManager* UStoryKeyManager::GetStoryKeyManager(UObject* WorldContextObject)
 {
-	if (Instance == NULL)
-		Instance = NewObject<UStoryKeyManager>(WorldContextObject);
+	return UStoryContext::GetStoryContext(WorldContextObject)->StoryKeyManager;
+}
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Key inbox posts"), STAT_QaDS_KeyInboxPosts, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Key inbox drained"), STAT_QaDS_KeyInboxDrained, STATGROUP_QaDS);
 
-	return Instance;
+void UStoryKeyManager::PostAddKey(FName Key)
+{
+	inbox.Enqueue({ Key, true });
+	INC_DWORD_STAT(STAT_QaDS_KeyInboxPosts);
 }
 
-void UStoryKeyManager::BeginDestroy()
+void UStoryKeyManager::PostRemoveKey(FName Key)
 {
-	Super::BeginDestroy();
+	inbox.Enqueue({ Key, false });
+	INC_DWORD_STAT(STAT_QaDS_KeyInboxPosts);
+}
+
+int32 UStoryKeyManager::ProcessInbox()
+{
+	check(IsInGameThread());
+
+	FStoryKeyChangeScope scope(TEXT("Posted"));
+
+	auto count = inbox.Drain([this](const FInboxItem& item)
+	{
+		if (item.bAdd)
+			AddKey(item.Key);
+		else
+			RemoveKey(item.Key);
+	});
 
-	if (Instance == this)
-		Instance = NULL;
+	INC_DWORD_STAT_BY(STAT_QaDS_KeyInboxDrained, count);
+	return count;
+}
+
+void UStoryKeyManager::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(Database.GetAllocatedSize() + keyWords.GetAllocatedSize() + inbox.GetAllocatedSize());
 }
 
 bool UStoryKeyManager::HasKey(FName Key) const
@@ -39,6 +130,9 @@ bool UStoryKeyManager::AddKey(FName Key)
 		return false;
 
 	Database.Add(Key);
+	SetKeyBit(Key, true);
+	MarkChanged();
+
 	OnKeyAdd.Broadcast(Key);
 	OnKeyAddBP.Broadcast(Key);
 
@@ -51,6 +145,9 @@ bool UStoryKeyManager::RemoveKey(FName Key)
 	if (!Database.Remove(Key))
 		return false;
 
+	SetKeyBit(Key, false);
+	MarkChanged();
+
 	OnKeyRemove.Broadcast(Key);
 	OnKeyRemoveBP.Broadcast(Key);
 
@@ -66,6 +163,9 @@ TArray<FName> UStoryKeyManager::GetKeys() const
 void UStoryKeyManager::SetKeys(const TSet<FName>& keys)
 {
 	Database = keys;
+	RebuildKeyWords();
+	MarkChanged();
+
 	OnKeysLoaded.Broadcast(Database.Array());
 	OnKeysLoadedBP.Broadcast(Database.Array());
 
@@ -75,6 +175,9 @@ void UStoryKeyManager::SetKeys(const TSet<FName>& keys)
 void UStoryKeyManager::Reset()
 {
 	Database.Reset();
+	RebuildKeyWords();
+	MarkChanged();
+
 	OnKeysLoaded.Broadcast(Database.Array());
 	OnKeysLoadedBP.Broadcast(Database.Array());
 
@@ -99,7 +202,72 @@ void UStoryKeyManager::LoadFromBinary(const TArray<uint8>& Data)
 {
 	FMemoryReader reader(Data);
 	reader << *this;
+	RebuildKeyWords();
+	MarkChanged();
 
 	OnKeysLoaded.Broadcast(Database.Array());
 	OnKeysLoadedBP.Broadcast(Database.Array());
+}
+
+void UStoryKeyManager::MarkChanged()
+{
+	version++;
+}
+
+void UStoryKeyManager::SetKeyBit(FName Key, bool bHasKey)
+{
+	auto id = FStoryKeyIds::Get(Key);
+	auto word = id / 32;
+
+	if (keyWords.Num() <= word)
+		keyWords.SetNumZeroed(word + 1);
+
+	if (bHasKey)
+		keyWords[word] |= 1u << (id % 32);
+	else
+		keyWords[word] &= ~(1u << (id % 32));
+}
+
+void UStoryKeyManager::RebuildKeyWords()
+{
+	keyWords.Reset();
+
+	for (auto& key : Database)
+		SetKeyBit(key, true);
+}
+
+const uint32* UStoryKeyManager::GetKeyWords(int32 MinWords)
+{
+	if (keyWords.Num() < MinWords)
+		keyWords.SetNumZeroed(MinWords);
+
+	return keyWords.GetData();
+}
+
+uint64 UStoryKeyManager::GetKeysVersion() const
+{
+	return version.Load(EMemoryOrder::Relaxed);
+}
+
+FStoryKeySnapshotPtr UStoryKeyManager::GetSnapshot() const
+{
+	return publishedSnapshot.Load()->AsShared();
+}
+
+void UStoryKeyManager::PublishSnapshot()
+{
+	check(IsInGameThread());
+
+	auto currentVersion = GetKeysVersion();
+	if (currentVersion == snapshotVersion)
+		return;
+
+	snapshotVersion = currentVersion;
+
+	// releases the snapshot published NumKeptSnapshots times ago, unless a reader still holds it
+	keptSnapshotIndex = (keptSnapshotIndex + 1) % NumKeptSnapshots;
+	keptSnapshots[keptSnapshotIndex] = MakeShareable(new FStoryKeySnapshot(Database, currentVersion));
+	publishedSnapshot.Store(keptSnapshots[keptSnapshotIndex].Get());
+
+	INC_DWORD_STAT(STAT_QaDS_KeySnapshots);
 }
\ No newline at end of file
@@ -0,0 +1,109 @@
+#include "DialogSystemRuntime.h"
+#include "StoryNativeRegistry.h"
+
+DEFINE_STAT(STAT_QaDS_NativeCall);
+DEFINE_STAT(STAT_QaDS_ReflectionCall);
+
+FStoryNativeRegistry& FStoryNativeRegistry::Get()
+{
+	static FStoryNativeRegistry registry;
+	return registry;
+}
+
+void FStoryNativeRegistry::Add(const FStoryNativeFunction& Native)
+{
+	if (functions.Contains(Native.Name))
+		UE_LOG(DialogModuleLog, Warning, TEXT("Native story function %s registered twice"), *Native.Name.ToString());
+
+	functions.Add(Native.Name, Native);
+}
+
+void FStoryNativeRegistry::Unregister(FName Name)
+{
+	functions.Remove(Name);
+}
+
+const FStoryNativeFunction* FStoryNativeRegistry::Find(FName Name) const
+{
+	return functions.Find(Name);
+}
+
+void FStoryNativeRegistry::GetNames(bool bConditions, TArray<FName>& OutNames) const
+{
+	for (auto& kpv : functions)
+	{
+		if (kpv.Value.bIsCondition == bConditions)
+			OutNames.Add(kpv.Key);
+	}
+
+	OutNames.Sort(FNameLexicalLess());
+}
+
+TSharedPtr<FStoryNativeCall> FStoryNativeRegistry::Bind(FName Name, bool bIsCondition, const TArray<FString>& Params, FString& ErrorMessage) const
+{
+	auto native = functions.Find(Name);
+	if (native == NULL)
+	{
+		ErrorMessage = FString::Printf(TEXT("Native function %s not registered"), *Name.ToString());
+		return nullptr;
+	}
+
+	if (native->bIsCondition != bIsCondition)
+	{
+		ErrorMessage = FString::Printf(bIsCondition ? TEXT("Native function %s is an action, not a condition") : TEXT("Native function %s is a condition, not an action"), *Name.ToString());
+		return nullptr;
+	}
+
+	auto call = native->Bind(Params);
+	if (!call.IsValid())
+	{
+		ErrorMessage = FString::Printf(TEXT("Bad parameters for native function %s, expected (%s)"), *Name.ToString(), *FString::Join(native->ParamTypes, TEXT(", ")));
+		return nullptr;
+	}
+
+	return call;
+}
+
+TSharedPtr<FStoryNativeCall> FStoryNativeRegistry::Compile(FName Name, bool bIsCondition, TArray<FString>& Params, FString& OutCommand, FString& ErrorMessage) const
+{
+	auto native = functions.Find(Name);
+	if (native != NULL)
+	{
+		while (native->ParamTypes.Num() < Params.Num())
+		{
+			Params.RemoveAt(Params.Num() - 1);
+		}
+		while (native->ParamTypes.Num() > Params.Num())
+		{
+			Params.Add("0");
+		}
+	}
+
+	auto call = Bind(Name, bIsCondition, Params, ErrorMessage);
+	if (!call.IsValid())
+		return nullptr;
+
+	OutCommand = Name.ToString();
+
+	for (auto& p : Params)
+	{
+		OutCommand.AppendChar(' ');
+		OutCommand.Append(p);
+	}
+
+	return call;
+}
+
+bool FStoryNativeRegistry::BindOnce(FName Name, bool bIsCondition, const TArray<FString>& Params, TSharedPtr<FStoryNativeCall>& Call) const
+{
+	if (Call.IsValid())
+		return true;
+
+	FString errorMessage;
+	Call = Bind(Name, bIsCondition, Params, errorMessage);
+
+	if (!Call.IsValid())
+		UE_LOG(DialogModuleLog, Error, TEXT("%s"), *errorMessage);
+
+	return Call.IsValid();
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "DialogSystemRuntime.h"
+#include "StoryObjectPool.h"
+#include "StoryContext.h"
+#include "DialogProcessor.h"
+#include "QaDSSettings.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled dialog processors"), STAT_QaDS_PooledProcessors, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Pooled script actors"), STAT_QaDS_PooledActors, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool reuses"), STAT_QaDS_PoolReuses, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Pool allocations"), STAT_QaDS_PoolAllocations, STATGROUP_QaDS);
+
+UStoryObjectPool* UStoryObjectPool::Get(UObject* WorldContextObject)
+{
+	auto context = UStoryContext::GetStoryContext(WorldContextObject);
+	return context ? context->ObjectPool : NULL;
+}
+
+UDialogProcessor* UStoryObjectPool::AcquireProcessor()
+{
+	RecycleEndedProcessors();
+
+	if (freeProcessors.Num() > 0)
+	{
+		DEC_DWORD_STAT(STAT_QaDS_PooledProcessors);
+		INC_DWORD_STAT(STAT_QaDS_PoolReuses);
+
+		return freeProcessors.Pop(false);
+	}
+
+	INC_DWORD_STAT(STAT_QaDS_PoolAllocations);
+	return NewObject<UDialogProcessor>(this);
+}
+
+void UStoryObjectPool::ReleaseProcessor(UDialogProcessor* Processor)
+{
+	check(Processor);
+
+	if (freeProcessors.Contains(Processor) || endedProcessors.Contains(Processor))
+		return;
+
+	endedProcessors.Add(Processor);
+	endedFrames.Add(GFrameCounter);
+}
+
+void UStoryObjectPool::RecycleEndedProcessors()
+{
+	auto maxProcessors = GetDefault<UQaDSSettings>()->MaxPooledProcessors;
+	auto num = 0;
+
+	while (num < endedProcessors.Num() && endedFrames[num] < GFrameCounter)
+	{
+		auto processor = endedProcessors[num++];
+		processor->ResetForPool();
+
+		if (freeProcessors.Num() < maxProcessors)
+		{
+			freeProcessors.Add(processor);
+			INC_DWORD_STAT(STAT_QaDS_PooledProcessors);
+		}
+	}
+
+	endedProcessors.RemoveAt(0, num, false);
+	endedFrames.RemoveAt(0, num, false);
+}
+
+AActor* UStoryObjectPool::AcquireActor(UWorld* World, UClass* ActorClass)
+{
+	if (World == NULL || ActorClass == NULL)
+		return NULL;
+
+	auto pooled = freeActors.Find(ActorClass);
+	if (pooled != NULL)
+	{
+		for (auto i = pooled->Actors.Num() - 1; i >= 0; i--)
+		{
+			auto actor = pooled->Actors[i];
+
+			// destroyed with its level or belongs to other world
+			if (actor == NULL || actor->IsPendingKillPending())
+			{
+				pooled->Actors.RemoveAtSwap(i);
+				numFreeActors--;
+				DEC_DWORD_STAT(STAT_QaDS_PooledActors);
+				continue;
+			}
+
+			if (actor->GetWorld() != World)
+				continue;
+
+			pooled->Actors.RemoveAtSwap(i);
+			numFreeActors--;
+			DEC_DWORD_STAT(STAT_QaDS_PooledActors);
+			INC_DWORD_STAT(STAT_QaDS_PoolReuses);
+
+			actor->SetActorHiddenInGame(false);
+			actor->SetActorTickEnabled(actor->PrimaryActorTick.bStartWithTickEnabled);
+
+			return actor;
+		}
+	}
+
+	INC_DWORD_STAT(STAT_QaDS_PoolAllocations);
+	return World->SpawnActor<AActor>(ActorClass);
+}
+
+void UStoryObjectPool::ReleaseActor(AActor* Actor)
+{
+	if (Actor == NULL || Actor->IsPendingKillPending())
+		return;
+
+	if (!GetDefault<UQaDSSettings>()->bPoolScriptActors)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	auto& pooled = freeActors.FindOrAdd(Actor->GetClass());
+
+	if (pooled.Actors.Num() >= GetDefault<UQaDSSettings>()->MaxPooledScriptsPerClass)
+	{
+		Actor->Destroy();
+		return;
+	}
+
+	if (pooled.Actors.Contains(Actor))
+		return;
+
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorTickEnabled(false);
+
+	pooled.Actors.Add(Actor);
+	numFreeActors++;
+	INC_DWORD_STAT(STAT_QaDS_PooledActors);
+}
+
+void UStoryObjectPool::Empty()
+{
+	for (auto& it : freeActors)
+	{
+		for (auto actor : it.Value.Actors)
+		{
+			if (actor != NULL && !actor->IsPendingKillPending())
+				actor->Destroy();
+		}
+	}
+
+	DEC_DWORD_STAT_BY(STAT_QaDS_PooledProcessors, freeProcessors.Num());
+	DEC_DWORD_STAT_BY(STAT_QaDS_PooledActors, numFreeActors);
+
+	freeActors.Reset();
+	freeProcessors.Reset();
+	endedProcessors.Reset();
+	endedFrames.Reset();
+	numFreeActors = 0;
+}
+
+void UStoryObjectPool::BeginDestroy()
+{
+	DEC_DWORD_STAT_BY(STAT_QaDS_PooledProcessors, freeProcessors.Num());
+	DEC_DWORD_STAT_BY(STAT_QaDS_PooledActors, numFreeActors);
+
+	freeProcessors.Reset();
+	endedProcessors.Reset();
+	endedFrames.Reset();
+	numFreeActors = 0;
+
+	Super::BeginDestroy();
+}
+
+void UStoryObjectPool::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(freeProcessors.GetAllocatedSize() + freeActors.GetAllocatedSize());
+}
\ No newline at end of file
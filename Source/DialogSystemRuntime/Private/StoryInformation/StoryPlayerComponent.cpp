@@ -0,0 +1,592 @@
+#include "DialogSystemRuntime.h"
+#include "StoryPlayerComponent.h"
+#include "StoryContext.h"
+#include "StoryInformationManager.h"
+#include "QuestProcessor.h"
+#include "QuestAsset.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerState.h"
+#include "Net/UnrealNetwork.h"
+#include "Serialization/BitWriter.h"
+#include "Runtime/Engine/Public/TimerManager.h"
+
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Key replication bytes"), STAT_QaDS_KeyReplicationBytes, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Key replication bytes (full name list)"), STAT_QaDS_KeyNameListBytes, STATGROUP_QaDS);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Quest replication bytes"), STAT_QaDS_QuestReplicationBytes, STATGROUP_QaDS);
+
+// seconds an ended quest that is not archived stays replicated
+static const float EndedQuestLifetime = 5.0f;
+
+static uint64 GetStageKey(int32 QuestId, int32 StageIndex)
+{
+	return ((uint64)QuestId << 32) | (uint32)StageIndex;
+}
+
+UStoryPlayerComponent::UStoryPlayerComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	bReplicates = true;
+	nextQuestId = 0;
+
+	SetArrayOwners();
+}
+
+void UStoryPlayerComponent::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// arrays copied from the archetype point to it
+	SetArrayOwners();
+}
+
+void UStoryPlayerComponent::SetArrayOwners()
+{
+	KeyNames.Owner = this;
+	KeyWords.Owner = this;
+	QuestStates.Owner = this;
+	StageStates.Owner = this;
+}
+
+void UStoryPlayerComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(UStoryPlayerComponent, KeyNames, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UStoryPlayerComponent, KeyWords, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UStoryPlayerComponent, QuestStates, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UStoryPlayerComponent, StageStates, COND_OwnerOnly);
+}
+
+void UStoryPlayerComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetOwnerRole() != ROLE_Authority || GetNetMode() == NM_Standalone)
+		return;
+
+	auto context = GetStoryContext();
+	context->StoryKeyManager->OnKeyAdd.AddUObject(this, &UStoryPlayerComponent::OnServerKeyAdd);
+	context->StoryKeyManager->OnKeyRemove.AddUObject(this, &UStoryPlayerComponent::OnServerKeyRemove);
+	context->StoryKeyManager->OnKeysLoaded.AddUObject(this, &UStoryPlayerComponent::OnServerKeysLoaded);
+
+	context->QuestProcessor->OnQuestStart.AddDynamic(this, &UStoryPlayerComponent::OnServerQuestStart);
+	context->QuestProcessor->OnQuestEnd.AddDynamic(this, &UStoryPlayerComponent::OnServerQuestEnd);
+	context->QuestProcessor->OnStageStatusChange.AddUObject(this, &UStoryPlayerComponent::OnServerStageStatus);
+	context->QuestProcessor->OnQuestsLoaded.AddUObject(this, &UStoryPlayerComponent::RebuildReplicatedQuests);
+
+	OnServerKeysLoaded(context->StoryKeyManager->GetKeys());
+	RebuildReplicatedQuests();
+}
+
+// Server......................................................................
+
+void UStoryPlayerComponent::OnServerKeyAdd(const FName& Key)
+{
+	SetReplicatedKey(Key, true);
+}
+
+void UStoryPlayerComponent::OnServerKeyRemove(const FName& Key)
+{
+	SetReplicatedKey(Key, false);
+}
+
+void UStoryPlayerComponent::OnServerKeysLoaded(const TArray<FName>& Keys)
+{
+#if STATS
+	serverNameListBytes = sizeof(int32);
+#endif
+
+	for (auto& word : KeyWords.Items)
+	{
+		if (word.Bits == 0)
+			continue;
+
+		word.Bits = 0;
+		KeyWords.MarkItemDirty(word);
+	}
+
+	for (auto& key : Keys)
+		SetReplicatedKey(key, true);
+}
+
+void UStoryPlayerComponent::SetReplicatedKey(FName Key, bool bHasKey)
+{
+	auto keyId = serverKeyIds.Find(Key);
+	if (keyId == NULL)
+	{
+		if (!bHasKey)
+			return;
+
+		auto& nameItem = KeyNames.Items[KeyNames.Items.AddDefaulted()];
+		nameItem.KeyId = KeyNames.Items.Num() - 1;
+		nameItem.Key = Key;
+		KeyNames.MarkItemDirty(nameItem);
+
+		keyId = &serverKeyIds.Add(Key, nameItem.KeyId);
+
+#if STATS
+		// written as UPackageMap::SerializeName writes a name that is not hardcoded
+		FBitWriter writer(0, true);
+		auto plainName = Key.GetPlainNameString();
+		auto number = Key.GetNumber();
+
+		writer.WriteBit(0);
+		writer << plainName << number;
+
+		serverNameBytes.Add((writer.GetNumBits() + 7) / 8);
+#endif
+	}
+
+	auto wordIndex = *keyId / 32;
+	while (KeyWords.Items.Num() <= wordIndex)
+	{
+		auto& newWord = KeyWords.Items[KeyWords.Items.AddDefaulted()];
+		newWord.WordIndex = KeyWords.Items.Num() - 1;
+		KeyWords.MarkItemDirty(newWord);
+	}
+
+	auto& word = KeyWords.Items[wordIndex];
+	auto mask = 1u << (*keyId % 32);
+	auto bits = bHasKey ? word.Bits | mask : word.Bits & ~mask;
+
+	if (bits == word.Bits)
+		return;
+
+	word.Bits = bits;
+	KeyWords.MarkItemDirty(word);
+
+#if STATS
+	// what an RPC carrying the whole key list would send for this change
+	if (bHasKey)
+		serverNameListBytes += serverNameBytes[*keyId];
+	else
+		serverNameListBytes -= serverNameBytes[*keyId];
+
+	INC_DWORD_STAT_BY(STAT_QaDS_KeyNameListBytes, serverNameListBytes);
+#endif
+}
+
+void UStoryPlayerComponent::OnServerQuestStart(UQuestRuntimeAsset* Quest)
+{
+	SetReplicatedQuest(Quest);
+}
+
+void UStoryPlayerComponent::OnServerQuestEnd(UQuestRuntimeAsset* Quest, EQuestCompleteStatus QuestStatus)
+{
+	SetReplicatedQuest(Quest);
+
+	if (GetStoryContext()->QuestProcessor->GetQuests(Quest->Status).Contains(Quest))
+		return;
+
+	// not archived, the item is removed once the owner had time to see the end
+	serverEndedQuests.Add(serverQuestIds.FindAndRemoveChecked(Quest));
+	GetWorld()->GetTimerManager().SetTimer(serverPruneTimer, this, &UStoryPlayerComponent::PruneEndedQuests, EndedQuestLifetime);
+}
+
+void UStoryPlayerComponent::SetReplicatedQuest(UQuestRuntimeAsset* Quest)
+{
+	auto questId = serverQuestIds.Find(Quest);
+	if (questId == NULL)
+	{
+		auto& newItem = QuestStates.Items[QuestStates.Items.AddDefaulted()];
+		newItem.QuestId = nextQuestId++;
+		newItem.Asset = Quest->Asset;
+
+		serverQuestItems.Add(newItem.QuestId, QuestStates.Items.Num() - 1);
+		questId = &serverQuestIds.Add(Quest, newItem.QuestId);
+	}
+
+	auto& item = QuestStates.Items[serverQuestItems[*questId]];
+	if (item.Status == Quest->Status)
+		return;
+
+	item.Status = Quest->Status;
+	QuestStates.MarkItemDirty(item);
+}
+
+void UStoryPlayerComponent::OnServerStageStatus(UQuestRuntimeNode* Stage)
+{
+	SetReplicatedStage(Stage);
+}
+
+int32 UStoryPlayerComponent::SetReplicatedStage(UQuestRuntimeNode* Stage)
+{
+	auto questId = serverQuestIds.Find(Stage->OwnerQuest);
+	if (questId == NULL)
+		return INDEX_NONE;
+
+	auto stageIndex = Stage->OwnerQuest->Asset->GetStageIndex(Stage->UID);
+	if (stageIndex == INDEX_NONE)
+		return INDEX_NONE;
+
+	auto stageKey = GetStageKey(*questId, stageIndex);
+	auto itemIndex = serverStageItems.Find(stageKey);
+	auto bIsNew = itemIndex == NULL;
+
+	if (bIsNew)
+	{
+		auto& newItem = StageStates.Items[StageStates.Items.AddDefaulted()];
+		newItem.QuestId = *questId;
+		newItem.StageIndex = stageIndex;
+
+		itemIndex = &serverStageItems.Add(stageKey, StageStates.Items.Num() - 1);
+	}
+
+	auto& item = StageStates.Items[*itemIndex];
+	if (bIsNew || item.Status != Stage->Status)
+	{
+		item.Status = Stage->Status;
+		StageStates.MarkItemDirty(item);
+	}
+
+	return *itemIndex;
+}
+
+void UStoryPlayerComponent::RebuildReplicatedQuests()
+{
+	auto quests = GetStoryContext()->QuestProcessor->GetQuests(EQuestCompleteStatus::None);
+
+	// ended quests waiting for the prune are not taken over
+	TSet<int32> usedIds;
+	usedIds.Append(serverEndedQuests);
+
+	TMap<TWeakObjectPtr<UQuestRuntimeAsset>, int32> questIds;
+	for (auto quest : quests)
+	{
+		auto questId = serverQuestIds.Find(quest);
+		if (questId == NULL)
+			continue;
+
+		questIds.Add(quest, *questId);
+		usedIds.Add(*questId);
+	}
+
+	// loaded quests are new objects, they take over an item of the same asset so the owner sees a change and not
+	// a new quest, a running quest does not take an ended one as the owner would not start it again
+	for (auto quest : quests)
+	{
+		if (questIds.Contains(quest))
+			continue;
+
+		FSoftObjectPath questPath(quest->Asset);
+		for (auto& item : QuestStates.Items)
+		{
+			if (usedIds.Contains(item.QuestId) || item.Asset.ToSoftObjectPath() != questPath)
+				continue;
+
+			if (item.Status != EQuestCompleteStatus::Active && item.Status != quest->Status)
+				continue;
+
+			questIds.Add(quest, item.QuestId);
+			usedIds.Add(item.QuestId);
+			break;
+		}
+	}
+
+	serverQuestIds = MoveTemp(questIds);
+
+	TSet<int32> liveStages;
+	for (auto quest : quests)
+	{
+		SetReplicatedQuest(quest);
+
+		for (auto stage : quest->ArchiveNodes)
+			liveStages.Add(SetReplicatedStage(stage));
+
+		for (auto stage : quest->ActiveNodes)
+			liveStages.Add(SetReplicatedStage(stage));
+	}
+
+	// quests the processor no longer has and stages a taken over quest no longer has
+	TSet<int32> liveQuests;
+	liveQuests.Append(serverEndedQuests);
+	for (auto& kvp : serverQuestIds)
+		liveQuests.Add(kvp.Value);
+
+	auto numRemoved = QuestStates.Items.RemoveAll([&](const FStoryQuestStateItem& Item)
+	{
+		return !liveQuests.Contains(Item.QuestId);
+	});
+
+	for (auto i = StageStates.Items.Num() - 1; i >= 0; i--)
+	{
+		if (!liveStages.Contains(i) && !serverEndedQuests.Contains(StageStates.Items[i].QuestId))
+		{
+			StageStates.Items.RemoveAt(i, 1, false);
+			numRemoved++;
+		}
+	}
+
+	if (numRemoved > 0)
+		ReindexReplicatedQuests();
+}
+
+void UStoryPlayerComponent::PruneEndedQuests()
+{
+	QuestStates.Items.RemoveAll([this](const FStoryQuestStateItem& Item)
+	{
+		return serverEndedQuests.Contains(Item.QuestId);
+	});
+
+	StageStates.Items.RemoveAll([this](const FStoryStageStateItem& Item)
+	{
+		return serverEndedQuests.Contains(Item.QuestId);
+	});
+
+	serverEndedQuests.Reset();
+	ReindexReplicatedQuests();
+}
+
+void UStoryPlayerComponent::ReindexReplicatedQuests()
+{
+	// items were removed, the rest moved
+	QuestStates.MarkArrayDirty();
+	StageStates.MarkArrayDirty();
+
+	serverQuestItems.Reset();
+	for (auto i = 0; i < QuestStates.Items.Num(); i++)
+		serverQuestItems.Add(QuestStates.Items[i].QuestId, i);
+
+	serverStageItems.Reset();
+	for (auto i = 0; i < StageStates.Items.Num(); i++)
+		serverStageItems.Add(GetStageKey(StageStates.Items[i].QuestId, StageStates.Items[i].StageIndex), i);
+}
+
+// Client......................................................................
+
+void UStoryPlayerComponent::OnRepKeyName(const FStoryKeyNameItem& Item)
+{
+	if (clientKeyNames.Num() <= Item.KeyId)
+		clientKeyNames.SetNum(Item.KeyId + 1);
+
+	clientKeyNames[Item.KeyId] = Item.Key;
+	OnRepKeyWords();
+}
+
+void UStoryPlayerComponent::OnRepKeyWords()
+{
+	auto keyManager = GetStoryContext()->StoryKeyManager;
+
+	for (auto& word : KeyWords.Items)
+	{
+		if (clientAppliedWords.Num() <= word.WordIndex)
+			clientAppliedWords.SetNumZeroed(word.WordIndex + 1);
+
+		FStoryKeyChangeScope scope(TEXT("Replication"), GetOwner());
+
+		auto& applied = clientAppliedWords[word.WordIndex];
+		auto changed = applied ^ word.Bits;
+
+		for (auto bit = 0; changed != 0; bit++, changed >>= 1)
+		{
+			if ((changed & 1) == 0)
+				continue;
+
+			auto keyId = word.WordIndex * 32 + bit;
+			if (!clientKeyNames.IsValidIndex(keyId) || clientKeyNames[keyId].IsNone())
+				continue;
+
+			auto mask = 1u << bit;
+			if (word.Bits & mask)
+				keyManager->AddKey(clientKeyNames[keyId]);
+			else
+				keyManager->RemoveKey(clientKeyNames[keyId]);
+
+			applied ^= mask;
+		}
+	}
+}
+
+void UStoryPlayerComponent::OnRepQuestState(const FStoryQuestStateItem& Item)
+{
+	auto processor = GetStoryContext()->QuestProcessor;
+	auto quest = clientQuests.FindRef(Item.QuestId);
+
+	if (quest == NULL)
+	{
+		auto asset = Item.Asset.LoadSynchronous();
+		if (asset == NULL)
+		{
+			UE_LOG(DialogModuleLog, Error, TEXT("Failed load replicated quest %s"), *Item.Asset.ToString());
+			return;
+		}
+
+		quest = processor->MirrorQuestStart(asset);
+		clientQuests.Add(Item.QuestId, quest);
+
+		for (auto& stage : StageStates.Items)
+		{
+			if (stage.QuestId == Item.QuestId)
+				OnRepStageState(stage);
+		}
+	}
+
+	if (quest->Status == EQuestCompleteStatus::Active && Item.Status != EQuestCompleteStatus::Active)
+		processor->MirrorQuestEnd(quest, Item.Status);
+}
+
+void UStoryPlayerComponent::OnRepQuestRemoved(const FStoryQuestStateItem& Item)
+{
+	auto quest = clientQuests.FindRef(Item.QuestId);
+	if (quest == NULL)
+		return;
+
+	GetStoryContext()->QuestProcessor->MirrorQuestRemove(quest);
+	clientQuests.Remove(Item.QuestId);
+}
+
+void UStoryPlayerComponent::OnRepStageState(const FStoryStageStateItem& Item)
+{
+	auto quest = clientQuests.FindRef(Item.QuestId);
+	if (quest == NULL)
+		return;
+
+	GetStoryContext()->QuestProcessor->MirrorStageStatus(quest, quest->Asset->GetStageUID(Item.StageIndex), Item.Status);
+}
+
+// Replication items...........................................................
+
+void FStoryKeyNameItem::PostReplicatedAdd(const FStoryKeyNameArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepKeyName(*this);
+}
+
+void FStoryKeyWordItem::PostReplicatedAdd(const FStoryKeyWordArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepKeyWords();
+}
+
+void FStoryKeyWordItem::PostReplicatedChange(const FStoryKeyWordArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepKeyWords();
+}
+
+void FStoryQuestStateItem::PostReplicatedAdd(const FStoryQuestStateArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepQuestState(*this);
+}
+
+void FStoryQuestStateItem::PostReplicatedChange(const FStoryQuestStateArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepQuestState(*this);
+}
+
+void FStoryQuestStateItem::PreReplicatedRemove(const FStoryQuestStateArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepQuestRemoved(*this);
+}
+
+void FStoryStageStateItem::PostReplicatedAdd(const FStoryStageStateArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepStageState(*this);
+}
+
+void FStoryStageStateItem::PostReplicatedChange(const FStoryStageStateArray& InArraySerializer)
+{
+	InArraySerializer.Owner->OnRepStageState(*this);
+}
+
+template<typename ItemType, typename ArrayType>
+static bool StoryDeltaSerialize(TArray<ItemType>& Items, FNetDeltaSerializeInfo& DeltaParms, ArrayType& ArraySerializer, uint32& OutBytes)
+{
+	auto startBits = DeltaParms.Writer ? DeltaParms.Writer->GetNumBits() : 0;
+	auto result = FFastArraySerializer::FastArrayDeltaSerialize<ItemType, ArrayType>(Items, DeltaParms, ArraySerializer);
+
+	OutBytes = DeltaParms.Writer ? (DeltaParms.Writer->GetNumBits() - startBits + 7) / 8 : 0;
+	return result;
+}
+
+bool FStoryKeyNameArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	uint32 bytes;
+	auto result = StoryDeltaSerialize(Items, DeltaParms, *this, bytes);
+
+	INC_DWORD_STAT_BY(STAT_QaDS_KeyReplicationBytes, bytes);
+	return result;
+}
+
+bool FStoryKeyWordArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	uint32 bytes;
+	auto result = StoryDeltaSerialize(Items, DeltaParms, *this, bytes);
+
+	INC_DWORD_STAT_BY(STAT_QaDS_KeyReplicationBytes, bytes);
+	return result;
+}
+
+bool FStoryQuestStateArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	uint32 bytes;
+	auto result = StoryDeltaSerialize(Items, DeltaParms, *this, bytes);
+
+	INC_DWORD_STAT_BY(STAT_QaDS_QuestReplicationBytes, bytes);
+	return result;
+}
+
+bool FStoryStageStateArray::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+	uint32 bytes;
+	auto result = StoryDeltaSerialize(Items, DeltaParms, *this, bytes);
+
+	INC_DWORD_STAT_BY(STAT_QaDS_QuestReplicationBytes, bytes);
+	return result;
+}
+
+UStoryContext* UStoryPlayerComponent::GetStoryContext()
+{
+	if (StoryContext == NULL)
+		StoryContext = UStoryContext::CreateStoryContext(this);
+
+	return StoryContext;
+}
+
+APawn* UStoryPlayerComponent::GetPlayerPawn() const
+{
+	auto owner = GetOwner();
+
+	auto playerState = Cast<APlayerState>(owner);
+	if (playerState != NULL)
+		owner = playerState->GetOwner();
+
+	auto controller = Cast<AController>(owner);
+	if (controller != NULL)
+		return controller->GetPawn();
+
+	return Cast<APawn>(owner);
+}
+
+UStoryPlayerComponent* UStoryPlayerComponent::FindPlayerComponent(UObject* Object)
+{
+	auto playerComponent = Cast<UStoryPlayerComponent>(Object);
+	if (playerComponent != NULL)
+		return playerComponent;
+
+	auto actorComponent = Cast<UActorComponent>(Object);
+	auto actor = actorComponent ? actorComponent->GetOwner() : Cast<AActor>(Object);
+
+	for (; actor != NULL; actor = actor->GetOwner())
+	{
+		playerComponent = actor->FindComponentByClass<UStoryPlayerComponent>();
+		if (playerComponent != NULL)
+			return playerComponent;
+
+		auto pawn = Cast<APawn>(actor);
+		auto controller = pawn ? pawn->GetController() : Cast<AController>(actor);
+		if (controller == NULL)
+			continue;
+
+		playerComponent = controller->FindComponentByClass<UStoryPlayerComponent>();
+		if (playerComponent != NULL)
+			return playerComponent;
+
+		if (controller->PlayerState != NULL)
+		{
+			playerComponent = controller->PlayerState->FindComponentByClass<UStoryPlayerComponent>();
+			if (playerComponent != NULL)
+				return playerComponent;
+		}
+	}
+
+	return NULL;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "DialogSystemRuntime.h"
+#include "StoryPredicateCache.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Predicate cache hits"), STAT_QaDS_PredicateHits, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Predicate cache misses"), STAT_QaDS_PredicateMisses, STATGROUP_QaDS);
+
+FStoryPredicateCache::FStoryPredicateCache()
+	: frame(MAX_uint64), keysVersion(MAX_uint64), hits(0), misses(0)
+{
+}
+
+void FStoryPredicateCache::UpdateEpoch(uint64 KeysVersion)
+{
+	if (frame == GFrameCounter && keysVersion == KeysVersion)
+		return;
+
+	results.Reset();
+	frame = GFrameCounter;
+	keysVersion = KeysVersion;
+}
+
+uint32 FStoryPredicateCache::HashCommand(const FString& Command)
+{
+	return FCrc::StrCrc32(*Command);
+}
+
+bool FStoryPredicateCache::Find(const UObject* Target, FName Function, const FString& Command, uint32 CommandHash, uint64 KeysVersion, bool& OutResult)
+{
+	UpdateEpoch(KeysVersion);
+
+	if (auto entries = results.Find(FKey(Target, Function, CommandHash)))
+	{
+		for (auto& entry : *entries)
+		{
+			if (!entry.Command.Equals(Command, ESearchCase::CaseSensitive))
+				continue;
+
+			hits++;
+			INC_DWORD_STAT(STAT_QaDS_PredicateHits);
+			OutResult = entry.Result;
+			return true;
+		}
+	}
+
+	misses++;
+	INC_DWORD_STAT(STAT_QaDS_PredicateMisses);
+	return false;
+}
+
+void FStoryPredicateCache::Add(const UObject* Target, FName Function, const FString& Command, uint32 CommandHash, bool Result)
+{
+	results.FindOrAdd(FKey(Target, Function, CommandHash)).Add({ Command, Result });
+}
+
+void FStoryPredicateCache::Reset()
+{
+	results.Reset();
+	frame = MAX_uint64;
+	keysVersion = MAX_uint64;
+}
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include "DialogSystemRuntime.h"
+#include "StoryPredicateProfiler.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<int32> CVarProfilePredicates(
+	TEXT("QaDS.ProfilePredicates"),
+	0,
+	TEXT("Record pass rate and cost of dialog and quest predicates, saved to Saved/QaDS on world cleanup"));
+
+static TMap<FString, FStoryPredicateStats> PredicateStats;
+static bool bPredicateStatsLoaded = false;
+static bool bPredicateStatsDirty = false;
+static FDelegateHandle WorldCleanupHandle;
+
+static FAutoConsoleCommand SavePredicateProfileCommand(
+	TEXT("QaDS.SavePredicateProfile"),
+	TEXT("Save recorded predicate profile"),
+	FConsoleCommandDelegate::CreateStatic(&FStoryPredicateProfiler::Save));
+
+static FAutoConsoleCommand ResetPredicateProfileCommand(
+	TEXT("QaDS.ResetPredicateProfile"),
+	TEXT("Clear recorded predicate profile"),
+	FConsoleCommandDelegate::CreateStatic(&FStoryPredicateProfiler::Reset));
+
+bool FStoryPredicateProfiler::IsEnabled()
+{
+	return CVarProfilePredicates.GetValueOnGameThread() != 0;
+}
+
+FString FStoryPredicateProfiler::MakeId(const UObject* Asset, const FString& NodeId, const FString& Predicate)
+{
+	return (Asset ? Asset->GetPathName() : FString()) + TEXT("|") + NodeId + TEXT("|") + Predicate;
+}
+
+void FStoryPredicateProfiler::Record(const FString& Id, bool bResult, double Seconds)
+{
+	if (!bPredicateStatsLoaded)
+		Load();
+
+	if (!WorldCleanupHandle.IsValid())
+	{
+		WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([](UWorld*, bool, bool)
+		{
+			if (bPredicateStatsDirty)
+				Save();
+		});
+	}
+
+	auto& stats = PredicateStats.FindOrAdd(Id);
+	stats.Calls++;
+	stats.TrueCount += bResult ? 1 : 0;
+	stats.Seconds += Seconds;
+
+	bPredicateStatsDirty = true;
+}
+
+const TMap<FString, FStoryPredicateStats>& FStoryPredicateProfiler::GetStats()
+{
+	if (!bPredicateStatsLoaded)
+		Load();
+
+	return PredicateStats;
+}
+
+FString FStoryPredicateProfiler::GetFilePath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("QaDS") / TEXT("PredicateProfile.txt");
+}
+
+// one predicate per line: calls;true count;seconds;id
+void FStoryPredicateProfiler::Load()
+{
+	PredicateStats.Empty();
+	bPredicateStatsLoaded = true;
+	bPredicateStatsDirty = false;
+
+	TArray<FString> lines;
+	if (!FFileHelper::LoadFileToStringArray(lines, *GetFilePath()))
+		return;
+
+	for (auto& line : lines)
+	{
+		TArray<FString> parts;
+		if (line.ParseIntoArray(parts, TEXT(";"), false) < 4)
+			continue;
+
+		auto id = FString::Join(TArray<FString>(parts.GetData() + 3, parts.Num() - 3), TEXT(";"));
+		auto& stats = PredicateStats.FindOrAdd(id);
+		stats.Calls = FCString::Atoi64(*parts[0]);
+		stats.TrueCount = FCString::Atoi64(*parts[1]);
+		stats.Seconds = FCString::Atod(*parts[2]);
+	}
+}
+
+void FStoryPredicateProfiler::Save()
+{
+	FString text;
+	for (auto& kpv : PredicateStats)
+		text += FString::Printf(TEXT("%lld;%lld;%.9f;%s\n"), kpv.Value.Calls, kpv.Value.TrueCount, kpv.Value.Seconds, *kpv.Key);
+
+	if (FFileHelper::SaveStringToFile(text, *GetFilePath()))
+	{
+		bPredicateStatsDirty = false;
+		UE_LOG(DialogModuleLog, Log, TEXT("Predicate profile saved to %s (%d predicates)"), *GetFilePath(), PredicateStats.Num());
+	}
+	else
+		UE_LOG(DialogModuleLog, Error, TEXT("Can't save predicate profile to %s"), *GetFilePath());
+}
+
+void FStoryPredicateProfiler::Reset()
+{
+	PredicateStats.Empty();
+	bPredicateStatsLoaded = true;
+	bPredicateStatsDirty = true;
+}
+
+bool FStoryPredicateProfiler::SortRuns(const TArray<double>& Ranks, const TArray<bool>& Pure, TArray<int32>& OutOrder)
+{
+	bool changed = false;
+
+	for (int32 start = 0; start < Ranks.Num();)
+	{
+		auto end = start + 1;
+		if (Pure[start])
+		{
+			while (end < Ranks.Num() && Pure[end])
+				end++;
+		}
+
+		TArray<int32> run;
+		bool hasStats = true;
+		for (auto i = start; i < end; i++)
+		{
+			run.Add(i);
+			hasStats &= Ranks[i] >= 0;
+		}
+
+		if (hasStats && run.Num() > 1)
+		{
+			run.StableSort([&Ranks](int32 A, int32 B) { return Ranks[A] < Ranks[B]; });
+
+			for (auto i = 0; i < run.Num(); i++)
+				changed |= run[i] != start + i;
+		}
+
+		OutOrder.Append(run);
+		start = end;
+	}
+
+	return changed;
+}
\ No newline at end of file
@@ -2,23 +2,14 @@
 #include "EngineUtils.h"
 #include "Runtime/CoreUObject/Public/UObject/UObjectIterator.h"
 #include "StoryTriggerManager.h"
+#include "StoryContext.h"
 
-UStoryTriggerManager* UStoryTriggerManager::Instance = NULL;
+DECLARE_DWORD_COUNTER_STAT(TEXT("Trigger inbox posts"), STAT_QaDS_TriggerInboxPosts, STATGROUP_QaDS);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Trigger inbox drained"), STAT_QaDS_TriggerInboxDrained, STATGROUP_QaDS);
 
 UStoryTriggerManager* UStoryTriggerManager::GetStoryTriggerManager(UObject* WorldContextObject)
 {
-	if (Instance == NULL)
-		Instance = NewObject<UStoryTriggerManager>(WorldContextObject);
-	
-	return Instance;
-}
-
-void UStoryTriggerManager::BeginDestroy()
-{
-	Super::BeginDestroy();
-
-	if (Instance == this)
-		Instance = NULL;
+	return UStoryContext::GetStoryContext(WorldContextObject)->StoryTriggerManager;
 }
 
 void UStoryTriggerManager::InvokeTrigger(const FStoryTrigger& Trigger)
@@ -30,3 +21,22 @@ void UStoryTriggerManager::InvokeTrigger(const FStoryTrigger& Trigger)
 
 	UE_LOG(DialogModuleLog, Log, TEXT("Invoke trigger %s"), *Trigger.TriggerName.ToString());
 }
+
+void UStoryTriggerManager::PostTrigger(const FStoryTrigger& Trigger)
+{
+	inbox.Enqueue(Trigger);
+	INC_DWORD_STAT(STAT_QaDS_TriggerInboxPosts);
+}
+
+int32 UStoryTriggerManager::ProcessInbox()
+{
+	check(IsInGameThread());
+
+	auto count = inbox.Drain([this](const FStoryTrigger& trigger)
+	{
+		InvokeTrigger(trigger);
+	});
+
+	INC_DWORD_STAT_BY(STAT_QaDS_TriggerInboxDrained, count);
+	return count;
+}
@@ -4,13 +4,14 @@
 #include "StoryTriggerManager.h"
 #include "QuestProcessor.h"
 #include "QuestAsset.h"
+#include "StoryContext.h"
 #include "GameFramework/Pawn.h"
 
 bool AStrotyVolume::CanActivate(AActor* Other)
 {
 	if (CheckHasKeys.Num() + CheckDontHasKeys.Num() > 0)
 	{
-		auto skm = UStoryKeyManager::GetStoryKeyManager(this);
+		auto skm = UStoryKeyManager::GetStoryKeyManager(Other != NULL ? (UObject*)Other : this);
 
 		for (auto& key : CheckHasKeys)
 		{
@@ -32,22 +33,25 @@ void AStrotyVolume::ActorEnteredVolume(AActor* Other)
 {
 	Super::ActorEnteredVolume(Other);
 
-	auto playerCharacter = UGameplayStatics::GetPlayerCharacter(GetWorld(), 0);
+	auto pawn = Cast<APawn>(Other);
 
-	if (playerCharacter != NULL && Other == playerCharacter)
+	if (pawn != NULL && pawn->IsPlayerControlled())
 	{
 		if (CanActivate(Other))
-			Activate();
+			Activate(Other);
 	}
 }
 
-void AStrotyVolume::Activate()
+void AStrotyVolume::Activate(AActor* Other)
 {
+	auto context = UStoryContext::GetStoryContext(Other != NULL ? (UObject*)Other : this);
+
 	UE_LOG(DialogModuleLog, Log, TEXT("Activate story volume %s"), *GetFName().ToString());
 
 	if (RemoveKeys.Num() + GiveKeys.Num() > 0)
 	{
-		auto skm = UStoryKeyManager::GetStoryKeyManager(this);
+		auto skm = context->StoryKeyManager;
+		FStoryKeyChangeScope scope(TEXT("Volume"), this);
 
 		for (auto& key : GiveKeys)
 		{
@@ -62,7 +66,7 @@ void AStrotyVolume::Activate()
 	
 	if (ActivateTriggers.Num() > 0)
 	{
-		auto stm = UStoryTriggerManager::GetStoryTriggerManager(this);
+		auto stm = context->StoryTriggerManager;
 		for (auto& trigger : ActivateTriggers)
 		{
 			stm->InvokeTrigger(trigger);
@@ -71,7 +75,7 @@ void AStrotyVolume::Activate()
 
 	if (!StartQuest.IsNull())
 	{
-		auto questProcesstor = UQuestProcessor::GetQuestProcessor(this);
+		auto questProcesstor = context->QuestProcessor;
 		questProcesstor->StartQuest(StartQuest);
 	}
 
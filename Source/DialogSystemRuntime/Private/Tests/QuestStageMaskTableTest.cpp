@@ -0,0 +1,137 @@
+#include "DialogSystemRuntime.h"
+#include "QuestStageMaskTable.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	// rows are told apart by fake node pointers, the table never dereferences them
+	UQuestRuntimeNode* GetTestNode(int32 Index)
+	{
+		return reinterpret_cast<UQuestRuntimeNode*>((UPTRINT)(Index + 1) * 16);
+	}
+
+	bool HasBit(const TArray<uint32>& Words, int32 Id)
+	{
+		return (Words[Id / 32] & (1u << (Id % 32))) != 0;
+	}
+
+	// per-stage check as done before the mask table
+	void SweepReference(const TArray<FQuestStageMaskRow>& Rows, const TArray<UQuestRuntimeNode*>& Nodes, const TArray<uint32>& Keys, const TArray<uint32>& Changed, TArray<UQuestRuntimeNode*>& OutCandidates)
+	{
+		for (auto i = 0; i < Rows.Num(); i++)
+		{
+			auto& row = Rows[i];
+
+			auto watched = false;
+			for (auto ids : { &row.WaitHas, &row.WaitDontHas, &row.FailedIfGive, &row.FailedIfRemove })
+			{
+				for (auto id : *ids)
+					watched |= HasBit(Changed, id);
+			}
+
+			if (!watched)
+				continue;
+
+			auto blocked = false;
+			for (auto id : row.WaitHas)
+				blocked |= !HasBit(Keys, id);
+			for (auto id : row.WaitDontHas)
+				blocked |= HasBit(Keys, id);
+
+			auto failed = false;
+			for (auto id : row.FailedIfGive)
+				failed |= HasBit(Keys, id);
+			for (auto id : row.FailedIfRemove)
+				failed |= !HasBit(Keys, id);
+
+			if (row.bAlwaysCheck || !blocked || failed)
+				OutCandidates.Add(Nodes[i]);
+		}
+	}
+
+	TArray<int32> RandomIds(FRandomStream& Random, int32 NumKeys, int32 MaxCount)
+	{
+		TArray<int32> ids;
+		for (auto i = Random.RandRange(0, MaxCount); i > 0; i--)
+			ids.Add(Random.RandRange(0, NumKeys - 1));
+
+		return ids;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FQuestStageMaskSweepTest, "QaDS.Quest.StageMaskTable.Sweep", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FQuestStageMaskSweepTest::RunTest(const FString& Parameters)
+{
+	const int32 numKeys = 300;
+	const int32 numStages = 500;
+
+	FRandomStream random(1234);
+
+	FQuestStageMaskTable table;
+	TArray<FQuestStageMaskRow> rows;
+	TArray<UQuestRuntimeNode*> nodes;
+
+	for (auto i = 0; i < numStages; i++)
+	{
+		// the first rows use low ids only, later ones make the table grow
+		auto rowKeys = i < numStages / 2 ? 64 : numKeys;
+
+		FQuestStageMaskRow row;
+		row.WaitHas = RandomIds(random, rowKeys, 3);
+		row.WaitDontHas = RandomIds(random, rowKeys, 2);
+		row.FailedIfGive = RandomIds(random, rowKeys, 1);
+		row.FailedIfRemove = RandomIds(random, rowKeys, 1);
+		row.bAlwaysCheck = random.FRand() < 0.05f;
+
+		table.Add(GetTestNode(i), row);
+		rows.Add(row);
+		nodes.Add(GetTestNode(i));
+	}
+
+	// same swap removal as the table
+	for (auto i = 0; i < 50; i++)
+	{
+		auto row = random.RandRange(0, rows.Num() - 1);
+		table.Remove(row);
+		rows.RemoveAtSwap(row);
+		nodes.RemoveAtSwap(row);
+	}
+
+	TestEqual(TEXT("Rows after removal"), table.Num(), rows.Num());
+
+	TArray<uint32> keys, changed;
+	keys.AddZeroed(table.GetNumWords());
+	changed.AddZeroed(table.GetNumWords());
+
+	for (auto pass = 0; pass < 20; pass++)
+	{
+		for (auto& word : keys)
+			word = random.GetUnsignedInt();
+
+		FMemory::Memzero(changed.GetData(), changed.Num() * sizeof(uint32));
+		for (auto id : RandomIds(random, numKeys, 4))
+			changed[id / 32] |= 1u << (id % 32);
+
+		TArray<UQuestRuntimeNode*> expected, scalar, vector;
+		SweepReference(rows, nodes, keys, changed, expected);
+		table.SweepScalar(keys.GetData(), changed.GetData(), scalar);
+		table.Sweep(keys.GetData(), changed.GetData(), vector);
+
+		TestTrue(FString::Printf(TEXT("Pass %d scalar sweep matches the per-stage check (%d / %d candidates)"), pass, scalar.Num(), expected.Num()), scalar == expected);
+		TestTrue(FString::Printf(TEXT("Pass %d vector sweep matches the per-stage check (%d / %d candidates)"), pass, vector.Num(), expected.Num()), vector == expected);
+	}
+
+	// nothing changed, nothing to check
+	FMemory::Memzero(changed.GetData(), changed.Num() * sizeof(uint32));
+
+	TArray<UQuestRuntimeNode*> candidates;
+	table.Sweep(keys.GetData(), changed.GetData(), candidates);
+	TestEqual(TEXT("No changed keys"), candidates.Num(), 0);
+
+	return true;
+}
+
+#endif
\ No newline at end of file
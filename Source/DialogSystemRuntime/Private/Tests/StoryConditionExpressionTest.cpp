@@ -0,0 +1,129 @@
+#include "DialogSystemRuntime.h"
+#include "StoryConditionExpression.h"
+#include "StoryInformationManager.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	struct FConditionTestResult
+	{
+		bool bCompiled = false;
+		bool bResult = false;
+		int32 NumPredicateCalls = 0;
+		FString Error;
+	};
+
+	FConditionTestResult EvaluateCondition(const FString& Expression, const TArray<FName>& Keys, int32 NumPredicates = 0, bool bPredicateResult = true)
+	{
+		FConditionTestResult result;
+
+		FStoryConditionExpression condition;
+		condition.Expression = Expression;
+		result.bCompiled = condition.Compile(NumPredicates, result.Error);
+
+		if (!result.bCompiled)
+			return result;
+
+		auto keyManager = NewObject<UStoryKeyManager>(GetTransientPackage());
+		for (auto key : Keys)
+			keyManager->AddKey(key);
+
+		result.bResult = condition.Evaluate(keyManager, [&](int32 Index)
+		{
+			result.NumPredicateCalls++;
+			return bPredicateResult;
+		});
+
+		keyManager->MarkPendingKill();
+		return result;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryConditionPrecedenceTest, "QaDS.Story.ConditionExpression.Precedence", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStoryConditionPrecedenceTest::RunTest(const FString& Parameters)
+{
+	TArray<FName> keysA = { TEXT("A") };
+
+	// '&' binds tighter than '|'
+	TestTrue(TEXT("A | B & C"), EvaluateCondition(TEXT("A | B & C"), keysA).bResult);
+	TestFalse(TEXT("(A | B) & C"), EvaluateCondition(TEXT("(A | B) & C"), keysA).bResult);
+
+	// '!' binds tighter than '&'
+	TestFalse(TEXT("!A & B"), EvaluateCondition(TEXT("!A & B"), keysA).bResult);
+	TestTrue(TEXT("!(B & A)"), EvaluateCondition(TEXT("!(B & A)"), keysA).bResult);
+	TestTrue(TEXT("!!A"), EvaluateCondition(TEXT("!!A"), keysA).bResult);
+
+	TestTrue(TEXT("A || B && C"), EvaluateCondition(TEXT("A || B && C"), keysA).bResult);
+	TestTrue(TEXT("empty condition"), EvaluateCondition(TEXT("  "), {}).bResult);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryConditionShortCircuitTest, "QaDS.Story.ConditionExpression.ShortCircuit", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStoryConditionShortCircuitTest::RunTest(const FString& Parameters)
+{
+	TArray<FName> keysA = { TEXT("A") };
+
+	auto result = EvaluateCondition(TEXT("B & Pred(0)"), keysA, 1);
+	TestFalse(TEXT("B & Pred(0)"), result.bResult);
+	TestEqual(TEXT("B & Pred(0) predicate calls"), result.NumPredicateCalls, 0);
+
+	// key tests run before predicates whatever the written order
+	result = EvaluateCondition(TEXT("Pred(0) | A"), keysA, 1);
+	TestTrue(TEXT("Pred(0) | A"), result.bResult);
+	TestEqual(TEXT("Pred(0) | A predicate calls"), result.NumPredicateCalls, 0);
+
+	result = EvaluateCondition(TEXT("Pred(0) & B"), keysA, 1);
+	TestFalse(TEXT("Pred(0) & B"), result.bResult);
+	TestEqual(TEXT("Pred(0) & B predicate calls"), result.NumPredicateCalls, 0);
+
+	result = EvaluateCondition(TEXT("B | Pred(0) | Pred(1)"), keysA, 2, true);
+	TestTrue(TEXT("B | Pred(0) | Pred(1)"), result.bResult);
+	TestEqual(TEXT("B | Pred(0) | Pred(1) predicate calls"), result.NumPredicateCalls, 1);
+
+	result = EvaluateCondition(TEXT("A & Pred(0) & Pred(1)"), keysA, 2, false);
+	TestFalse(TEXT("A & Pred(0) & Pred(1)"), result.bResult);
+	TestEqual(TEXT("A & Pred(0) & Pred(1) predicate calls"), result.NumPredicateCalls, 1);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryConditionErrorTest, "QaDS.Story.ConditionExpression.Errors", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStoryConditionErrorTest::RunTest(const FString& Parameters)
+{
+	struct FErrorCase
+	{
+		const TCHAR* Expression;
+		const TCHAR* Error;
+	};
+
+	FErrorCase cases[] =
+	{
+		{ TEXT("A &"), TEXT("unexpected end at 3") },
+		{ TEXT("A & )"), TEXT("expected key or Pred(N) at 4") },
+		{ TEXT("(A | B"), TEXT("expected ')' at 6") },
+		{ TEXT("A B"), TEXT("unexpected symbol at 2") },
+		{ TEXT("Pred()"), TEXT("expected predicate index at 5") },
+		{ TEXT("Pred(2)"), TEXT("predicate 2 not found, node has 1 predicates at 6") },
+	};
+
+	for (auto& errorCase : cases)
+	{
+		FStoryConditionExpression condition;
+		condition.Expression = errorCase.Expression;
+
+		FString error;
+		TestFalse(errorCase.Expression, condition.Compile(1, error));
+		TestTrue(FString::Printf(TEXT("%s reports '%s', got '%s'"), errorCase.Expression, errorCase.Error, *error), error.EndsWith(errorCase.Error));
+		TestTrue(FString::Printf(TEXT("%s leaves no program"), errorCase.Expression), condition.IsEmpty() && condition.Keys.Num() == 0);
+	}
+
+	return true;
+}
+
+#endif
\ No newline at end of file
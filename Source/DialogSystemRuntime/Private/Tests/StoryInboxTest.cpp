@@ -0,0 +1,106 @@
+#include "DialogSystemRuntime.h"
+#include "StoryInbox.h"
+#include "Async/Async.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	struct FInboxTestPost
+	{
+		int32 Producer;
+		int32 Sequence;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryInboxOverflowOrderTest, "QaDS.Story.Inbox.OverflowOrder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStoryInboxOverflowOrderTest::RunTest(const FString& Parameters)
+{
+	TStoryInbox<FInboxTestPost, 8> inbox;
+	TArray<int32> drained;
+
+	auto drain = [&]()
+	{
+		return inbox.Drain([&](const FInboxTestPost& Post) { drained.Add(Post.Sequence); });
+	};
+
+	TestEqual(TEXT("Empty inbox"), drain(), 0);
+
+	// fills the ring and goes on in the overflow
+	for (auto i = 0; i < 20; i++)
+		inbox.Enqueue({ 0, i });
+
+	TestEqual(TEXT("Ring and overflow drained"), drain(), 20);
+
+	// the ring has room again
+	for (auto i = 20; i < 24; i++)
+		inbox.Enqueue({ 0, i });
+
+	TestEqual(TEXT("Ring drained"), drain(), 4);
+
+	auto isOrdered = drained.Num() == 24;
+	for (auto i = 0; isOrdered && i < drained.Num(); i++)
+		isOrdered = drained[i] == i;
+
+	TestTrue(TEXT("Posts drained in post order"), isOrdered);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryInboxProducerOrderTest, "QaDS.Story.Inbox.ProducerOrder", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStoryInboxProducerOrderTest::RunTest(const FString& Parameters)
+{
+	const int32 numProducers = 4;
+	const int32 numPosts = 20000;
+
+	// small ring, producers keep switching between the ring and the overflow
+	TStoryInbox<FInboxTestPost, 16> inbox;
+	TArray<TFuture<void>> producers;
+
+	for (auto p = 0; p < numProducers; p++)
+	{
+		producers.Add(Async<void>(EAsyncExecution::Thread, [&inbox, numPosts, p]()
+		{
+			for (auto i = 0; i < numPosts; i++)
+				inbox.Enqueue({ p, i });
+		}));
+	}
+
+	TArray<int32> nextSequence;
+	nextSequence.AddZeroed(numProducers);
+
+	auto numDrained = 0;
+	auto numOutOfOrder = 0;
+	auto numDrains = 0;
+
+	while (numDrained < numProducers * numPosts)
+	{
+		auto count = inbox.Drain([&](const FInboxTestPost& Post)
+		{
+			if (Post.Sequence != nextSequence[Post.Producer])
+				numOutOfOrder++;
+
+			nextSequence[Post.Producer] = Post.Sequence + 1;
+		});
+
+		if (count == 0)
+			FPlatformProcess::Yield();
+
+		numDrained += count;
+		numDrains++;
+	}
+
+	for (auto& producer : producers)
+		producer.Wait();
+
+	TestEqual(TEXT("Drained posts"), numDrained, numProducers * numPosts);
+	TestEqual(TEXT("Posts out of producer order"), numOutOfOrder, 0);
+	TestEqual(TEXT("Posts left after the producers ended"), inbox.Drain([](const FInboxTestPost&) {}), 0);
+
+	AddInfo(FString::Printf(TEXT("%d posts in %d drains"), numDrained, numDrains));
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "DialogSystemRuntime.h"
+#include "StoryPredicateCache.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStoryPredicateCacheCommandTest, "QaDS.Story.PredicateCache.Commands", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
+
+bool FStoryPredicateCacheCommandTest::RunTest(const FString& Parameters)
+{
+	FStoryPredicateCache cache;
+	auto target = GetTransientPackage();
+	FName function = TEXT("HasItem");
+
+	FString upper = TEXT("HasItem Sword");
+	FString lower = TEXT("HasItem sword");
+	auto upperHash = FStoryPredicateCache::HashCommand(upper);
+	auto lowerHash = FStoryPredicateCache::HashCommand(lower);
+
+	bool result = false;
+	TestFalse(TEXT("Empty cache"), cache.Find(target, function, upper, upperHash, 1, result));
+
+	cache.Add(target, function, upper, upperHash, true);
+	TestTrue(TEXT("Cached command"), cache.Find(target, function, upper, upperHash, 1, result) && result);
+
+	// params are compared case sensitive
+	TestFalse(TEXT("Command differing in case"), cache.Find(target, function, lower, lowerHash, 1, result));
+
+	cache.Add(target, function, lower, lowerHash, false);
+	TestTrue(TEXT("Both commands cached"), cache.Find(target, function, lower, lowerHash, 1, result) && !result);
+	TestTrue(TEXT("First command keeps its result"), cache.Find(target, function, upper, upperHash, 1, result) && result);
+
+	// a hash match alone is not a hit
+	TestFalse(TEXT("Same hash, other command"), cache.Find(target, function, TEXT("HasItem Shield"), upperHash, 1, result));
+
+	TestFalse(TEXT("Other target"), cache.Find(GetMutableDefault<UObject>(), function, upper, upperHash, 1, result));
+	TestFalse(TEXT("Keys changed"), cache.Find(target, function, upper, upperHash, 2, result));
+
+	return true;
+}
+
+#endif
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Engine/DataAsset.h"
+#include "StoryAssetUsage.h"
 #include "DialogAsset.generated.h"
 
 class UDialogPhraseNode;
@@ -23,8 +24,13 @@ public:
 #if WITH_EDITORONLY_DATA
 	UPROPERTY()
 	class UEdGraph* UpdateGraph;
+
+	UPROPERTY()
+	FStoryAssetUsage Usage;
 #endif	// WITH_EDITORONLY_DATA
 
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
+
 	UFUNCTION(BlueprintCallable)
 	UDialogPhraseNode* FindPhraseByUID(const FName& UID) const;
 
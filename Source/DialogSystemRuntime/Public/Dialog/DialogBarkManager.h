@@ -0,0 +1,87 @@
+#pragma once
+
+#include "EngineUtils.h"
+#include "Tickable.h"
+#include "DialogPhrase.h"
+#include "DialogBarkManager.generated.h"
+
+class UDialogAsset;
+class UDialogProcessor;
+class UDialogPhraseNode;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDialogBarkSignature, AActor*, const FDialogPhraseInfo&);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FDialogBarkStartSignatureBP, AActor*, NPC, FText, Text);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDialogBarkEndSignatureBP, AActor*, NPC);
+
+UENUM(BlueprintType)
+enum class EDialogBarkResult : uint8
+{
+	Played,
+	Cooldown,
+	TooFar,
+	LimitReached,
+	NoValidPhrase
+};
+
+/*
+	One-shot NPC lines. The first valid phrase among the dialog root children
+	is played without starting a dialog: no dialog script, no timers and no
+	objects are created per bark. Shared by all NPCs of one story context.
+*/
+UCLASS(BlueprintType)
+class DIALOGSYSTEMRUNTIME_API UDialogBarkManager : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	struct FActiveBark
+	{
+		TWeakObjectPtr<AActor> NPC;
+		// the dialog asset may be unloaded while the bark plays
+		TWeakObjectPtr<const UDialogPhraseNode> Phrase;
+		double EndTime;
+	};
+
+	TArray<FActiveBark> activeBarks;
+	TMap<FObjectKey, double> cooldowns;
+	// phrases already warned about events on the dialog script
+	TSet<FObjectKey> scriptEventPhrases;
+	double currentTime = 0;
+
+	// used only to check phrase conditions, never started
+	UPROPERTY()
+	UDialogProcessor* checkProcessor;
+
+	const UDialogPhraseNode* FindPhrase(UDialogAsset* Dialog, AActor* NPC, AActor* Player);
+	void EndBark(int32 Index);
+
+public:
+	FDialogBarkSignature OnBarkStart;
+	FDialogBarkSignature OnBarkEnd;
+
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FDialogBarkStartSignatureBP OnBarkStartBP;
+
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FDialogBarkEndSignatureBP OnBarkEndBP;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog", meta = (WorldContext = "WorldContextObject"))
+	static UDialogBarkManager* GetBarkManager(UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintCallable, Category = "Gameplay|Dialog")
+	EDialogBarkResult TryBark(UDialogAsset* Dialog, AActor* NPC, AActor* Player = NULL);
+
+	UFUNCTION(BlueprintCallable, Category = "Gameplay|Dialog")
+	void StopBark(AActor* NPC);
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	bool IsBarking(AActor* NPC) const;
+
+	int32 GetNumActiveBarks() const { return activeBarks.Num(); }
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+};
\ No newline at end of file
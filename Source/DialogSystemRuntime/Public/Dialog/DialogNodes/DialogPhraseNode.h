@@ -11,6 +11,18 @@ public:
 
 	UPROPERTY(BlueprintReadOnly)
 	FDialogPhraseInfo Data;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	FText GetText() const { return Data.Text; }
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	FName GetUID() const { return Data.UID; }
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	EDialogPhraseSource GetSource() const { return Data.Source; }
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	FString GetAditionalData(FName Key) const { return Data.AditionalData.FindRef(Key); }
 	
 	virtual void Invoke(UDialogProcessor* processor) override;
 	virtual bool Check(UDialogProcessor* processor) override;
@@ -5,6 +5,7 @@
 #include "UObject/NoExportTypes.h"
 #include "Runtime/Engine/Classes/Sound/SoundBase.h"
 #include "DialogPhraseEvent.h"
+#include "StoryConditionExpression.h"
 #include "DialogPhrase.generated.h"
 
 class UDialogNode;
@@ -72,6 +73,10 @@ struct DIALOGSYSTEMRUNTIME_API FDialogPhraseInfo
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
 	TArray<FDialogPhraseCondition> Predicate;
 
+	// When set, predicates are called only through Pred(N) in this expression
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	FStoryConditionExpression Condition;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Activate")
 	TArray<FName> GiveKeys;
 
@@ -15,8 +15,11 @@ enum class EDialogPhraseEventCallType : uint8
 	Player,
 	NPC,
 	FindByTag,
+	Native,
 };
 
+class FStoryNativeCall;
+
 USTRUCT(BlueprintType)
 struct DIALOGSYSTEMRUNTIME_API FDialogPhraseEvent
 {
@@ -47,10 +50,17 @@ public:
 
 	virtual bool Compile(FString& ErrorMessage);
 	virtual UObject* GetObject(class UDialogProcessor* Implementer) const;
-	virtual void Invoke(class UDialogProcessor* Implementer);
+	virtual void Invoke(class UDialogProcessor* Implementer) const;
 	virtual ~FDialogPhraseEvent() {}
 
 	virtual FString ToString() const;
+
+protected:
+	// Bound on first use, see FStoryNativeRegistry
+	mutable TSharedPtr<FStoryNativeCall> NativeCall;
+
+	bool CompileNative(bool bIsCondition, FString& ErrorMessage);
+	bool BindNative(bool bIsCondition) const;
 };
 
 USTRUCT(BlueprintType)
@@ -63,11 +73,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	bool InvertCondition;
 
+	// Result depends only on the target and story keys, so it is shared within a frame
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bIsPure = false;
+
 	virtual bool Compile(FString& ErrorMessage) override;
 	virtual bool InvokeCheck(class UDialogProcessor* Implementer) const;
 	virtual FString ToString() const override;
 	virtual ~FDialogPhraseCondition() {}
 
 private:
+	// case sensitive hash of Command for the predicate cache, made on first use
+	mutable uint32 CommandHash = 0;
+
+	bool CallCheck(UObject* Executor) const;
 	bool CallCheckFunction(UObject* Executor, const TCHAR* Str, bool& checkResult) const;
 };
@@ -2,6 +2,7 @@
 
 #include "Engine/EngineTypes.h"
 #include "DialogPhrase.h"
+#include "DialogScheduler.h"
 #include "UObject/NoExportTypes.h"
 #include "DialogProcessor.generated.h"
 
@@ -9,10 +10,18 @@ class UDialogRootEdGraphNode;
 class UDialogPhraseEdGraphNode;
 class UDdialogEdGraphNode;
 class UStoryKeyManager;
+class UStoryContext;
+class UStoryObjectPool;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDialogEndSignature);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FChangePhraseVariantSignature, const TArray<FDialogPhraseShortInfo>&, Variants);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDialogPhraseSignature, FDialogPhraseInfo, Phrase);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FDialogPhraseNodeSignature, UDialogPhraseNode*, Phrase);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FDialogChoicesSignature);
+
+// native events pass compiled phrases without copying them
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDialogPhraseNativeSignature, UDialogProcessor*, const UDialogPhraseNode*);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FDialogChoicesNativeSignature, UDialogProcessor*, const TArray<UDialogPhraseNode*>&);
 
 
 UCLASS(BlueprintType)
@@ -23,23 +32,60 @@ class DIALOGSYSTEMRUNTIME_API UDialogProcessor : public UObject
 	UPROPERTY()
 	UDialogNode* CurrentNode;
 
+	UPROPERTY()
+	UStoryObjectPool* Pool;
+
+	// set by EndDialog, an ended pooled processor is returned to the pool and can't be advanced or restarted
+	bool bIsEnded = false;
+
+	void ReleaseScript();
+	UDialogScheduler* GetScheduler();
+	bool IsPooled() const;
+	bool CheckNotEnded(const TCHAR* Action) const;
+
+	// reused between steps, filled only when OnChangePhraseVariant is bound
+	TArray<FDialogPhraseShortInfo> choiceInfos;
+
+	// choices of the phrase after the current one, evaluated while the current one plays
+	UPROPERTY()
+	UDialogNode* speculativeNode;
+
+	TArray<UDialogPhraseNode*> speculativeNextNodes;
+	bool bSpeculativeIsPlayerNext = false;
+	uint64 speculativeKeysVersion = 0;
+	bool bIsSpeculating = false;
+	bool bIsSpeculationCancelled = false;
+
+	void EvaluateNext(UDialogNode* Node, TArray<UDialogPhraseNode*>& OutNextNodes, bool& OutIsPlayerNext);
+
 public:
-	FTimerHandle NextTimerHandle;
 	TArray<UDialogPhraseNode*> NextNodes;
 	bool IsPlayerNext;
 
+	// state owned by UDialogScheduler
+	int32 SchedulerIndex = INDEX_NONE;
+	uint32 ScheduleSerial = 0;
+	EDialogLOD LOD = EDialogLOD::Near;
+
 	UPROPERTY(BlueprintReadOnly)
 	UDialogAsset* Asset;
 
 	UPROPERTY(BlueprintReadOnly)
 	ADialogScript* DialogScript;
 
+	UPROPERTY(BlueprintReadOnly)
+	UStoryContext* StoryContext;
+
 	UPROPERTY(BlueprintReadOnly)
 	UStoryKeyManager* StoryKeyManager;
 
 	UPROPERTY(BlueprintReadWrite)
 	AActor* NPC;
 
+	// story state is taken from this player, if it has own story context
+	UPROPERTY(BlueprintReadWrite)
+	AActor* Player;
+
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FChangePhraseVariantSignature OnChangePhraseVariant;
 
@@ -52,11 +98,22 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Events")
 	FDialogEndSignature OnEndDialog;
 
+	// phrase is passed as a handle, read it with the UDialogPhraseNode getters
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FDialogPhraseNodeSignature OnShowPhraseNode;
+
+	// player choices are ready, read them with GetNumChoices and GetChoice
+	UPROPERTY(BlueprintAssignable, Category = "Events")
+	FDialogChoicesSignature OnChoicesReady;
+
+	FDialogPhraseNativeSignature OnShowPhraseNative;
+	FDialogChoicesNativeSignature OnChoicesReadyNative;
+
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Dialog")
 	void SetDialogAsset(UDialogAsset* NewDialogAsset);
 
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Dialog")
-	static UDialogProcessor* CreateDialogProcessor(UDialogAsset* DialogAsset, AActor* InNPC);
+	static UDialogProcessor* CreateDialogProcessor(UDialogAsset* DialogAsset, AActor* InNPC, AActor* InPlayer = NULL);
 
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Dialog")
 	void StartDialog();
@@ -70,7 +127,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Dialog")
 	void SetCurrentNode(UDialogNode* node);
 
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	AActor* GetPlayer() const;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	UDialogPhraseNode* GetCurrentPhrase() const;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	int32 GetNumChoices() const;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	UDialogPhraseNode* GetChoice(int32 Index) const;
+
+	// evaluate the choices of the next automatic phrase ahead of time, called by UDialogScheduler
+	bool Speculate();
+
+	// only pure predicates run while speculating, any other cancels the speculation
+	bool IsSpeculating() const { return bIsSpeculating; }
+	void CancelSpeculation() { bIsSpeculationCancelled = true; }
+
+	void BroadcastPhrase(UDialogPhraseNode* Phrase);
+	void BroadcastChoices();
+
 	float GetPhraseDuration();
 	void OnTimerTick();
 	void DelayNext();
+
+	// clear dialog state and bound events before the processor is reused
+	void ResetForPool();
 };
\ No newline at end of file
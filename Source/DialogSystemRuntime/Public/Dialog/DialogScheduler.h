@@ -0,0 +1,75 @@
+#pragma once
+
+#include "EngineUtils.h"
+#include "Tickable.h"
+#include "DialogScheduler.generated.h"
+
+class UDialogProcessor;
+
+UENUM(BlueprintType)
+enum class EDialogLOD : uint8
+{
+	Near,
+	// phrase delays are shortened
+	Far,
+	// phrases are not advanced until the player comes closer
+	Paused
+};
+
+/*
+	Advances the phrase delays of all running dialogs of one story context
+	from a single tick. Due phrases are kept in a heap ordered by time, and
+	far dialogs are fast-forwarded or paused by distance to the player.
+	Time follows the owning world, so game pause and time dilation apply.
+	Processors are held weakly, like the world timers this replaces.
+*/
+UCLASS()
+class DIALOGSYSTEMRUNTIME_API UDialogScheduler : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	struct FScheduledPhrase
+	{
+		double DueTime;
+		uint32 Serial;
+		TWeakObjectPtr<UDialogProcessor> Processor;
+
+		bool operator<(const FScheduledPhrase& Other) const { return DueTime < Other.DueTime; }
+	};
+
+	TArray<TWeakObjectPtr<UDialogProcessor>> activeDialogs;
+
+	TArray<FScheduledPhrase> heap;
+	TArray<TWeakObjectPtr<UDialogProcessor>> speculations;
+	double currentTime = 0;
+	double lodTime = 0;
+
+	void RemoveAt(int32 Index);
+	void UpdateLOD();
+
+public:
+	void Add(UDialogProcessor* Processor);
+	void Remove(UDialogProcessor* Processor);
+
+	// replaces the previously scheduled phrase of this processor
+	void Schedule(UDialogProcessor* Processor, float Delay);
+	void Cancel(UDialogProcessor* Processor);
+
+	// run UDialogProcessor::Speculate in a later tick with the budget left after due phrases
+	void RequestSpeculation(UDialogProcessor* Processor);
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog")
+	int32 GetNumActiveDialogs() const { return activeDialogs.Num(); }
+
+	int32 GetNumScheduled() const { return heap.Num(); }
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Dialog", meta = (WorldContext = "WorldContextObject"))
+	static UDialogScheduler* GetDialogScheduler(UObject* WorldContextObject);
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+	virtual TStatId GetStatId() const override;
+};
\ No newline at end of file
@@ -18,4 +18,8 @@ public:
 
 	UFUNCTION(BlueprintPure, Category = "Dialog")
 	AActor* GetNPC();
+
+	// script is returned to the pool after dialog end, clear variables set during the dialog here
+	UFUNCTION(BlueprintImplementableEvent, Category = "Dialog")
+	void OnResetScript();
 };
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "ModuleManager.h"
+#include "Stats/Stats.h"
 
 DECLARE_LOG_CATEGORY_EXTERN(DialogModuleLog, All, All)
+DECLARE_STATS_GROUP(TEXT("QaDS"), STATGROUP_QaDS, STATCAT_Advanced);
 
 class FDialogSystemRuntime : public IModuleInterface
 {
+public:
+	virtual void ShutdownModule() override;
 };
\ No newline at end of file
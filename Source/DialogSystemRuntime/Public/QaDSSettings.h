@@ -12,9 +12,88 @@ public:
 	UPROPERTY(config, EditAnywhere, Category = Settings)
 	bool AutoCompile = true;
 
+	// Seconds without edits before the auto compile rebuilds the changed nodes
+	UPROPERTY(config, EditAnywhere, Category = Settings, meta = (ClampMin = "0"))
+	float AutoCompileDelay = 0.3f;
+
+	// Graph zoom below which nodes show only their title, key, predicate and event rows are hidden
+	UPROPERTY(config, EditAnywhere, Category = Settings, meta = (ClampMin = "0.1", ClampMax = "2"))
+	float NodeDetailZoom = 0.5f;
+
+	// Reorder adjacent pure predicates on compile using data recorded with QaDS.ProfilePredicates
+	UPROPERTY(config, EditAnywhere, Category = Settings)
+	bool bReorderPredicatesByProfile = false;
+
+	// Return script actors to the story context pool instead of destroying them, scripts must reset their state in OnResetScript
+	UPROPERTY(config, EditAnywhere, Category = Pooling)
+	bool bPoolScriptActors = false;
+
+	// Reuse dialog processors after EndDialog, references to an ended processor must not be kept
+	UPROPERTY(config, EditAnywhere, Category = Pooling)
+	bool bPoolDialogProcessors = false;
+
+	UPROPERTY(config, EditAnywhere, Category = Pooling, meta = (ClampMin = "0"))
+	int32 MaxPooledScriptsPerClass = 8;
+
+	UPROPERTY(config, EditAnywhere, Category = Pooling, meta = (ClampMin = "0"))
+	int32 MaxPooledProcessors = 32;
+
+	// Spawn quest scripts of loaded quests over several frames, script events are queued until then and Script is NULL right after load
+	UPROPERTY(config, EditAnywhere, Category = Pooling)
+	bool bDeferQuestScriptSpawn = false;
+
+	UPROPERTY(config, EditAnywhere, Category = Pooling, meta = (ClampMin = "0", EditCondition = "bDeferQuestScriptSpawn"))
+	float QuestScriptSpawnBudgetMs = 1.0f;
+
+	// Time spent advancing dialog phrases per frame, at least one phrase is advanced
+	UPROPERTY(config, EditAnywhere, Category = Dialog, meta = (ClampMin = "0"))
+	float DialogTickBudgetMs = 0.5f;
+
+	UPROPERTY(config, EditAnywhere, Category = Dialog, meta = (ClampMin = "0.1"))
+	float DialogLODInterval = 0.5f;
+
+	// Evaluate the choices after an NPC phrase while it plays, reused if no story key changed.
+	// Only choices whose predicates are all marked pure are evaluated ahead.
+	UPROPERTY(config, EditAnywhere, Category = Dialog)
+	bool bSpeculateNextChoices = false;
+
+	// Dialogs farther than this from the player run faster, 0 to disable
+	UPROPERTY(config, EditAnywhere, Category = Dialog, meta = (ClampMin = "0"))
+	float FarDialogDistance = 0.0f;
+
+	UPROPERTY(config, EditAnywhere, Category = Dialog, meta = (ClampMin = "1"))
+	float FarDialogTimeScale = 4.0f;
+
+	// Dialogs farther than this from the player are paused, 0 to disable
+	UPROPERTY(config, EditAnywhere, Category = Dialog, meta = (ClampMin = "0"))
+	float PauseDialogDistance = 0.0f;
+
+	UPROPERTY(config, EditAnywhere, Category = Barks, meta = (ClampMin = "0"))
+	int32 MaxConcurrentBarks = 8;
+
+	// Barks farther than this from the player are rejected
+	UPROPERTY(config, EditAnywhere, Category = Barks, meta = (ClampMin = "0"))
+	float MaxBarkDistance = 3000.0f;
+
+	// Barks farther than this from the player are shown without sound
+	UPROPERTY(config, EditAnywhere, Category = Barks, meta = (ClampMin = "0"))
+	float BarkSoundDistance = 1500.0f;
+
+	// Seconds after a bark ends before the same NPC can bark again
+	UPROPERTY(config, EditAnywhere, Category = Barks, meta = (ClampMin = "0"))
+	float BarkCooldown = 10.0f;
+
+	UPROPERTY(config, EditAnywhere, Category = Barks, meta = (ClampMin = "0"))
+	float MinBarkDuration = 2.0f;
+
 	UPROPERTY(config, EditAnywhere, Category = Quest)
 	bool bDontGenerateEventForEmptyQuestNode = true;
 
 	UPROPERTY(config, EditAnywhere, Category = Quest)
 	bool bUseQuestArchive = true;
+
+	// Fill the deprecated UQuestRuntimeNode::Stage copy for Blueprints that still read it,
+	// disable to keep stage data only in the shared quest asset
+	UPROPERTY(config, EditAnywhere, Category = Quest)
+	bool bCopyQuestStageToNodes = true;
 };
\ No newline at end of file
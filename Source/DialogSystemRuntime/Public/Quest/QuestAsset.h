@@ -2,6 +2,7 @@
 
 #include "Engine/DataAsset.h"
 #include "QuestNode.h"
+#include "StoryAssetUsage.h"
 #include "QuestAsset.generated.h"
 
 class UQuestRuntimeNode;
@@ -44,11 +45,20 @@ public:
 
 	UPROPERTY(EditAnywhere, meta = (DisplayName = "QuestScript"))
 	TAssetSubclassOf<AQuestScript> QuestScriptClass;
+
+	// dense stage index, stable for the same asset data
+	int32 GetStageIndex(const FGuid& UID) const;
+	FGuid GetStageUID(int32 Index) const;
 	
 #if WITH_EDITORONLY_DATA
 	UPROPERTY()
 	class UEdGraph* UpdateGraph;
+
+	UPROPERTY()
+	FStoryAssetUsage Usage;
 #endif
+
+	virtual void GetAssetRegistryTags(TArray<FAssetRegistryTag>& OutTags) const override;
 };
 
 USTRUCT(BlueprintType)
@@ -82,7 +92,7 @@ struct DIALOGSYSTEMRUNTIME_API FQuestRuntimeAssetArchive
 	FQuestRuntimeAssetArchive() {}
 	FQuestRuntimeAssetArchive(class UQuestRuntimeAsset* RuntimeAsset);
 
-	class UQuestRuntimeAsset* Load();
+	class UQuestRuntimeAsset* Load(class UQuestProcessor* Processor);
 	friend FArchive& operator<<(FArchive& Ar, FQuestRuntimeAssetArchive& A);
 };
 
@@ -107,7 +117,20 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	UQuestAsset* Asset;
 
+	UPROPERTY()
+	UQuestProcessor* Processor;
+
 	class UQuestRuntimeNode* LoadNode(FGuid uid);
-	void CreateScript();
+
+	// deferred scripts are spawned by the processor within the frame budget
+	void CreateScript(bool bDeferred = false);
 	void DestroyScript();
+	void SpawnScript();
+
+	bool IsScriptPending() const { return bIsScriptPending; }
+	void QueueScriptCommand(const FString& Command);
+
+private:
+	bool bIsScriptPending = false;
+	TArray<FString> pendingCommands;
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "QuestStageEvent.h"
 #include "StoryTriggerManager.h"
+#include "StoryConditionExpression.h"
 #include "QuestNode.generated.h"
 
 UENUM(BlueprintType)
@@ -65,6 +66,10 @@ struct DIALOGSYSTEMRUNTIME_API FQuestStageInfo
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
 	TArray<FQuestStageCondition> Predicate;
 
+	// When set, predicates are called only through Pred(N) in this expression
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	FStoryConditionExpression Condition;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Task")
 	TArray<FName> WaitHasKeys;
 
@@ -124,7 +129,7 @@ class DIALOGSYSTEMRUNTIME_API UQuestRuntimeNode : public UObject
 	bool CkeckForComplete();
 	bool CkeckForFailed();
 
-	bool MatchTringger(FStoryTriggerCondition& condition, const FStoryTrigger& trigger);
+	bool MatchTringger(const FStoryTriggerCondition& condition, int& count, const FStoryTrigger& trigger);
 	bool MatchTringgerParam(const FString& value, const FString& filter);
 
 public:
@@ -140,17 +145,35 @@ public:
 	UPROPERTY(BlueprintReadOnly)
 	EQuestCompleteStatus Status;
 
-	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	UPROPERTY(BlueprintReadOnly)
+	FGuid UID;
+
+	UPROPERTY()
+	TArray<int> WaitTriggersCount;
+
+	UPROPERTY()
+	TArray<int> FailedTriggersCount;
+
+	// copy of the asset stage for Blueprints that read it, filled only while UQaDSSettings::bCopyQuestStageToNodes is set
+	UPROPERTY(BlueprintReadOnly, Transient, meta = (DeprecatedProperty, DeprecationMessage = "Use GetStageInfo, Stage is empty when Copy Quest Stage To Nodes is disabled"))
 	FQuestStageInfo Stage;
 
+	// stage data is shared with the quest asset, only progress is stored per node
+	const FQuestStageInfo& GetStage() const;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Quest")
+	FQuestStageInfo GetStageInfo() const;
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
 	bool TryComplete();
 	void SetStatus(EQuestCompleteStatus NewStatus);
 	TArray<UQuestRuntimeNode*> GetNextStage();
 
-private:
-	UFUNCTION()
-	void OnChangeStoryKey(const FName& key);
+	// row in the processor stage mask table while active and waiting for keys
+	int32 MaskRow = INDEX_NONE;
 
+private:
 	UFUNCTION()
 	void OnTrigger(const FStoryTrigger& Trigger);
 };
\ No newline at end of file
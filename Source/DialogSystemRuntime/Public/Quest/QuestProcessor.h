@@ -3,26 +3,37 @@
 #include "EngineUtils.h"
 #include "Components/ActorComponent.h"
 #include "QuestNode.h"
+#include "QuestStageMaskTable.h"
 #include "QuestProcessor.generated.h"
 
 class UQuestAsset;
 class UQuestRuntimeAsset;
 class UStoryKeyManager;
+class UStoryContext;
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FQuestStartSignature, UQuestRuntimeAsset*, Quest);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FQuestStageCompleteSignature, UQuestRuntimeAsset*, Quest, FQuestStageInfo, Stage);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FQuestEndSignature, UQuestRuntimeAsset*, Quest, EQuestCompleteStatus, QuestStatus);
+DECLARE_MULTICAST_DELEGATE_OneParam(FQuestStageStatusSignature, UQuestRuntimeNode*);
 
 UCLASS()
 class DIALOGSYSTEMRUNTIME_API UQuestProcessor : public UObject
 {
 	GENERATED_BODY()
 
-	static UQuestProcessor* Instance;
-
 	TArray<UQuestRuntimeAsset*> archiveQuests;
 	TArray<UQuestRuntimeAsset*> activeQuests;
 	bool bIsResetBegin;
+
+	FQuestStageMaskTable stageMasks;
+	TArray<uint32> changedKeys;
+	TArray<UQuestRuntimeNode*> stageCandidates;
+	bool bIsKeyEventsBound = false;
+
+	TArray<UQuestRuntimeAsset*> pendingScripts;
+
+	void BroadcastStageComplete(UQuestRuntimeNode* Stage);
+	void OnKeyChanged(const FName& Key);
 	
 public:
 	UPROPERTY(BlueprintAssignable, Category = "Gameplay|Quest")
@@ -34,6 +45,12 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Gameplay|Quest")
 	FQuestEndSignature OnQuestEnd;
 
+	FQuestStageStatusSignature OnStageStatusChange;
+	FSimpleMulticastDelegate OnQuestsLoaded;
+
+	UPROPERTY(BlueprintReadOnly)
+	UStoryContext* StoryContext;
+
 	UPROPERTY(BlueprintReadOnly)
 	UStoryKeyManager* StoryKeyManager;
 
@@ -49,6 +66,17 @@ public:
 	void CompleteStage(UQuestRuntimeNode* Stage);
 	void WaitStage(UQuestRuntimeNode* Stage);
 
+	// stage is checked only when a key it depends on changes
+	void RegisterStage(UQuestRuntimeNode* Stage);
+	void UnregisterStage(UQuestRuntimeNode* Stage);
+
+	void QueueScriptSpawn(UQuestRuntimeAsset* Quest);
+	void CancelScriptSpawn(UQuestRuntimeAsset* Quest);
+
+	// spawn deferred quest scripts until the budget is spent, at least one per call
+	int32 SpawnPendingScripts(double BudgetSeconds);
+	int32 GetNumPendingScripts() const { return pendingScripts.Num(); }
+
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Quest")
 	void EndQuest(UQuestRuntimeAsset* Quest, EQuestCompleteStatus QuestStatus);
 
@@ -64,7 +92,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Quest")
 	void LoadFromBinary(const TArray<uint8>& Data);
 
-	virtual void BeginDestroy() override;
+	// apply quest state replicated from server, without running stage logic
+	UQuestRuntimeAsset* MirrorQuestStart(UQuestAsset* QuestAsset);
+	void MirrorQuestEnd(UQuestRuntimeAsset* Quest, EQuestCompleteStatus QuestStatus);
+	void MirrorQuestRemove(UQuestRuntimeAsset* Quest);
+	void MirrorStageStatus(UQuestRuntimeAsset* Quest, const FGuid& UID, EQuestCompleteStatus StageStatus);
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
 	friend FArchive& operator<<(FArchive& Ar, UQuestProcessor& A);
 };
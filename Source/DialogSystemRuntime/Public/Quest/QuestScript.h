@@ -11,4 +11,8 @@ public:
 
 	UPROPERTY(BlueprintReadOnly)
 	class UQuestRuntimeAsset* Quest;
+
+	// script is returned to the pool after quest end, clear variables set by the quest here
+	UFUNCTION(BlueprintImplementableEvent, Category = "Quest")
+	void OnResetScript();
 };
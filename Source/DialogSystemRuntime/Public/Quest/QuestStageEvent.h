@@ -14,10 +14,12 @@ enum class EQuestStageEventCallType : uint8
 	QuestScript,
 	Player,
 	FindByTag,
+	Native,
 };
 
 class UQuestAsset;
 class UQuestRuntimeNode;
+class FStoryNativeCall;
 
 USTRUCT(BlueprintType)
 struct DIALOGSYSTEMRUNTIME_API FQuestStageEvent
@@ -46,10 +48,17 @@ public:
 
 	virtual bool Compile(UQuestAsset* Quest, FString& ErrorMessage);
 	virtual UObject* GetObject(UQuestRuntimeNode* QuestNode) const;
-	virtual void Invoke(UQuestRuntimeNode* QuestNode);
+	virtual void Invoke(UQuestRuntimeNode* QuestNode) const;
 	virtual ~FQuestStageEvent() {}
 
 	virtual FString ToString() const;
+
+protected:
+	// Bound on first use, see FStoryNativeRegistry
+	mutable TSharedPtr<FStoryNativeCall> NativeCall;
+
+	bool CompileNative(bool bIsCondition, FString& ErrorMessage);
+	bool BindNative(bool bIsCondition) const;
 };
 
 USTRUCT(BlueprintType)
@@ -62,11 +71,19 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly)
 	bool InvertCondition;
 
+	// Result depends only on the target and story keys, so it is shared within a frame
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+	bool bIsPure = false;
+
 	virtual bool Compile(UQuestAsset* Quest, FString& ErrorMessage) override;
 	virtual bool InvokeCheck(UQuestRuntimeNode* QuestNode) const;
 	virtual FString ToString() const override;
 	virtual ~FQuestStageCondition() {}
 
 private:
+	// case sensitive hash of Command for the predicate cache, made on first use
+	mutable uint32 CommandHash = 0;
+
+	bool CallCheck(UObject* Executor) const;
 	bool CallCheckFunction(UObject* Executor, const TCHAR* Str, bool& checkResult) const;
 };
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UQuestRuntimeNode;
+
+// Key ids (FStoryKeyIds) required by one stage
+struct FQuestStageMaskRow
+{
+	TArray<int32> WaitHas;
+	TArray<int32> WaitDontHas;
+	TArray<int32> FailedIfGive;
+	TArray<int32> FailedIfRemove;
+
+	// stage has to be checked on every watched key change, e.g. it has failed predicates
+	bool bAlwaysCheck = false;
+};
+
+/*
+	Key requirements of active quest stages, stored as fixed width bit mask rows
+	with one array per requirement. A sweep over all rows finds the stages
+	whose keys now allow them to complete or fail, only those run the full check.
+*/
+struct DIALOGSYSTEMRUNTIME_API FQuestStageMaskTable
+{
+	enum EColumn
+	{
+		WaitHas,
+		WaitDontHas,
+		FailedIfGive,
+		FailedIfRemove,
+		Watch,
+		NumColumns
+	};
+
+	int32 Add(UQuestRuntimeNode* Node, const FQuestStageMaskRow& Row);
+	void Remove(int32 Row);
+	void Reset();
+
+	// Keys and Changed must have at least GetNumWords() words
+	void Sweep(const uint32* Keys, const uint32* Changed, TArray<UQuestRuntimeNode*>& OutCandidates) const;
+	void SweepScalar(const uint32* Keys, const uint32* Changed, TArray<UQuestRuntimeNode*>& OutCandidates) const;
+
+	int32 Num() const { return nodes.Num(); }
+	int32 GetNumWords() const { return numWords; }
+	UQuestRuntimeNode* GetNode(int32 Row) const { return nodes[Row]; }
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	// multiple of 4, one vector register per step
+	int32 numWords = 0;
+
+	TArray<UQuestRuntimeNode*> nodes;
+	TArray<uint8> alwaysCheck;
+	TArray<uint32> columns[NumColumns];
+
+	void Resize(int32 NewNumWords);
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "StoryAssetUsage.generated.h"
+
+// Story keys, triggers and quests used by a dialog or quest asset.
+// Written by the editor compiler and exported as asset registry tags, so usage can be found without loading assets.
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryAssetUsage
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FName> GiveKeys;
+
+	UPROPERTY()
+	TArray<FName> CheckKeys;
+
+	UPROPERTY()
+	TArray<FName> RemoveKeys;
+
+	UPROPERTY()
+	TArray<FName> WaitTriggers;
+
+	// object paths of started quest assets
+	UPROPERTY()
+	TArray<FName> StartQuests;
+
+	static const FName GiveKeysTag;
+	static const FName CheckKeysTag;
+	static const FName RemoveKeysTag;
+	static const FName WaitTriggersTag;
+	static const FName StartQuestsTag;
+
+	void Reset();
+	// sorts every list and drops duplicates and None
+	void Normalize();
+	void GetAssetRegistryTags(TArray<UObject::FAssetRegistryTag>& OutTags) const;
+
+	// tag values are written as ",A,B," with commas inside names escaped, so a whole name is matched with a single search
+	static bool TagContains(const FString& TagValue, const FName& Name);
+	static void ParseTag(const FString& TagValue, TArray<FName>& OutNames);
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectMacros.h"
+#include "StoryConditionExpression.generated.h"
+
+class UStoryKeyManager;
+
+UENUM()
+enum class EStoryConditionOp : uint8
+{
+	// push HasKey(Keys[Arg])
+	Key,
+	// push result of predicate slot Arg
+	Predicate,
+	Not,
+	// short circuit: keep the top value and jump to Arg if it is false (true), otherwise pop it
+	JumpIfFalse,
+	JumpIfTrue,
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryConditionInstruction
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	EStoryConditionOp Op = EStoryConditionOp::Key;
+
+	UPROPERTY()
+	uint16 Arg = 0;
+};
+
+/*
+	Boolean condition over story keys and predicate slots, e.g. "(A & !B) | Pred(0)".
+	Pred(N) refers to the N-th entry of the owner's predicate list.
+	Compiled in the editor into a flat postfix program, key-only branches are tested first.
+*/
+USTRUCT(BlueprintType)
+struct DIALOGSYSTEMRUNTIME_API FStoryConditionExpression
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Conditions")
+	FString Expression;
+
+	UPROPERTY()
+	TArray<FName> Keys;
+
+	UPROPERTY()
+	TArray<FStoryConditionInstruction> Program;
+
+	bool Compile(int32 NumPredicates, FString& ErrorMessage);
+	bool IsEmpty() const { return Program.Num() == 0; }
+	bool Evaluate(const UStoryKeyManager* StoryKeyManager, TFunctionRef<bool(int32)> CheckPredicate) const;
+};
\ No newline at end of file
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "EngineUtils.h"
+#include "Tickable.h"
+#include "StoryPredicateCache.h"
+#include "StoryContext.generated.h"
+
+class UStoryKeyManager;
+class UStoryTriggerManager;
+class UQuestProcessor;
+class UStoryObjectPool;
+class UDialogBarkManager;
+class UDialogScheduler;
+class UStoryPlayerComponent;
+class APawn;
+
+// Owns one set of story state (keys, triggers, quests).
+// Shared per game instance, or per player when the player has a UStoryPlayerComponent.
+UCLASS(BlueprintType)
+class DIALOGSYSTEMRUNTIME_API UStoryContext : public UObject, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+	// walks outers, the owner chain and the game instance, GetStoryContext caches the result for the frame
+	static UStoryContext* FindStoryContext(UObject* WorldContextObject);
+
+public:
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UStoryKeyManager* StoryKeyManager;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UStoryTriggerManager* StoryTriggerManager;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UQuestProcessor* QuestProcessor;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UStoryPlayerComponent* OwnerComponent;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UStoryObjectPool* ObjectPool;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UDialogBarkManager* BarkManager;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Gameplay|Story")
+	UDialogScheduler* DialogScheduler;
+
+	FStoryPredicateCache PredicateCache;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Story", meta = (WorldContext = "WorldContextObject"))
+	static UStoryContext* GetStoryContext(UObject* WorldContextObject);
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Story")
+	APawn* GetPlayerPawn() const;
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Story")
+	bool IsPlayerContext() const;
+
+	static UStoryContext* CreateStoryContext(UObject* Outer);
+	static int32 GetNumContexts();
+
+	// unroots the context used without a game instance, called on module shutdown
+	static void ReleaseFallbackContext();
+
+	virtual void BeginDestroy() override;
+
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual bool IsTickableWhenPaused() const override;
+	virtual TStatId GetStatId() const override;
+};
\ No newline at end of file
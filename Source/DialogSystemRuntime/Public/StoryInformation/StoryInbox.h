@@ -0,0 +1,170 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+#include "HAL/CriticalSection.h"
+#include "Misc/ScopeLock.h"
+#include "HAL/PlatformProcess.h"
+
+// Multi producer, single consumer inbox over a ring that is allocated on the first post.
+// Posts only claim a slot with a compare exchange and do not allocate. When the ring is full
+// posts go to a locked overflow list (which allocates) until the consumer drains it, so each
+// producer still sees its messages consumed in post order.
+template<typename T, uint32 Capacity>
+class TStoryInbox
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Inbox capacity must be a power of two");
+
+	struct FCell
+	{
+		TAtomic<uint32> Sequence;
+		T Item;
+	};
+
+	// most story contexts never get posts, they do not pay for the ring
+	TAtomic<FCell*> cells;
+	TAtomic<uint32> enqueuePos;
+	uint32 dequeuePos;
+
+	TArray<T> overflow;
+	TAtomic<bool> bOverflow;
+	FCriticalSection overflowLock;
+
+	FCell* GetCells()
+	{
+		auto current = cells.Load();
+		if (current != nullptr)
+			return current;
+
+		auto created = new FCell[Capacity];
+		for (uint32 i = 0; i < Capacity; i++)
+			created[i].Sequence.Store(i, EMemoryOrder::Relaxed);
+
+		FCell* expected = nullptr;
+		if (cells.CompareExchange(expected, created))
+			return created;
+
+		// another producer was first
+		delete[] created;
+		return expected;
+	}
+
+	bool TryEnqueue(const T& Item)
+	{
+		auto ring = GetCells();
+		auto pos = enqueuePos.Load(EMemoryOrder::Relaxed);
+
+		while (true)
+		{
+			auto& cell = ring[pos & (Capacity - 1)];
+			auto diff = (int32)(cell.Sequence.Load() - pos);
+
+			if (diff == 0)
+			{
+				if (enqueuePos.CompareExchange(pos, pos + 1))
+				{
+					cell.Item = Item;
+					cell.Sequence.Store(pos + 1);
+					return true;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueuePos.Load(EMemoryOrder::Relaxed);
+			}
+		}
+	}
+
+public:
+	TStoryInbox() : cells(nullptr), enqueuePos(0), dequeuePos(0), bOverflow(false)
+	{
+	}
+
+	~TStoryInbox()
+	{
+		delete[] cells.Load();
+	}
+
+	TStoryInbox(const TStoryInbox&) = delete;
+	TStoryInbox& operator=(const TStoryInbox&) = delete;
+
+	// any thread
+	void Enqueue(const T& Item)
+	{
+		if (!bOverflow.Load() && TryEnqueue(Item))
+			return;
+
+		FScopeLock lock(&overflowLock);
+		overflow.Add(Item);
+		bOverflow.Store(true);
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return (cells.Load() != nullptr ? Capacity * sizeof(FCell) : 0) + overflow.GetAllocatedSize();
+	}
+
+	/*
+		Consumer thread only, returns the number of drained items.
+		Drains the slots claimed before the call, then the overflow, posts made meanwhile wait for the next call.
+		A producer whose post went to the overflow keeps posting there until it is taken, so its later ring
+		posts are claimed after the snapshot and can not overtake it.
+	*/
+	template<typename FuncType>
+	int32 Drain(FuncType Func)
+	{
+		if (cells.Load() == nullptr && !bOverflow.Load())
+			return 0;
+
+		TArray<T> items;
+		uint32 end;
+
+		if (bOverflow.Load())
+		{
+			FScopeLock lock(&overflowLock);
+
+			// taken before the flag is cleared, ring posts after it get later slots
+			end = enqueuePos.Load();
+			Swap(items, overflow);
+			bOverflow.Store(false);
+		}
+		else
+		{
+			end = enqueuePos.Load();
+		}
+
+		// loaded after the snapshot, slots claimed before it are in this ring
+		auto ring = cells.Load();
+		auto count = 0;
+
+		while (ring != nullptr && dequeuePos != end)
+		{
+			auto& cell = ring[dequeuePos & (Capacity - 1)];
+			if ((int32)(cell.Sequence.Load() - (dequeuePos + 1)) < 0)
+			{
+				// claimed but not written yet, slots before the overflow have to be consumed first
+				if (items.Num() == 0)
+					break;
+
+				FPlatformProcess::Yield();
+				continue;
+			}
+
+			T item = MoveTemp(cell.Item);
+			cell.Sequence.Store(dequeuePos + Capacity);
+			dequeuePos++;
+
+			Func(item);
+			count++;
+		}
+
+		for (auto& item : items)
+			Func(item);
+
+		return count + items.Num();
+	}
+};
\ No newline at end of file
@@ -2,8 +2,51 @@
 
 #include "EngineUtils.h"
 #include "Components/ActorComponent.h"
+#include "StoryInbox.h"
+#include "Templates/Atomic.h"
 #include "StoryInformationManager.generated.h"
 
+// Immutable copy of the key set, safe to read from any thread
+struct DIALOGSYSTEMRUNTIME_API FStoryKeySnapshot : public TSharedFromThis<FStoryKeySnapshot, ESPMode::ThreadSafe>
+{
+	const TSet<FName> Keys;
+	const uint64 Version;
+
+	FStoryKeySnapshot(const TSet<FName>& InKeys, uint64 InVersion) : Keys(InKeys), Version(InVersion) {}
+
+	bool HasKey(FName Key) const { return Keys.Contains(Key); }
+	bool DontHasKey(FName Key) const { return !Keys.Contains(Key); }
+};
+
+typedef TSharedPtr<const FStoryKeySnapshot, ESPMode::ThreadSafe> FStoryKeySnapshotPtr;
+
+// Dense ids of story key names, shared by all story contexts, game thread only
+struct DIALOGSYSTEMRUNTIME_API FStoryKeyIds
+{
+	static int32 Get(FName Key);
+	static int32 Find(FName Key);
+	static int32 Num();
+};
+
+// Names what is changing story keys while in scope, so key listeners (the editor key window) can show it.
+// Scopes nest, game thread only.
+struct DIALOGSYSTEMRUNTIME_API FStoryKeyChangeScope
+{
+	FStoryKeyChangeScope(const TCHAR* InKind, const UObject* InObject = NULL, FName InDetail = NAME_None);
+	~FStoryKeyChangeScope();
+
+	// innermost scope as text, empty outside of any scope
+	static FString GetSource();
+
+private:
+	const TCHAR* kind;
+	const UObject* object;
+	FName detail;
+	FStoryKeyChangeScope* previous;
+
+	static FStoryKeyChangeScope* current;
+};
+
 DECLARE_MULTICAST_DELEGATE_OneParam(FStoryKeyChangeSignature, const FName&);
 DECLARE_MULTICAST_DELEGATE_OneParam(FStoryKeysChangeSignature, const TArray<FName>&);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FStoryKeyChangeSignatureBP, const FName&, StoreKey);
@@ -14,10 +57,37 @@ class DIALOGSYSTEMRUNTIME_API UStoryKeyManager : public UObject
 {
 	GENERATED_BODY()
 
-	static UStoryKeyManager* Instance;
+	struct FInboxItem
+	{
+		FName Key;
+		bool bAdd;
+	};
+
 	TSet<FName> Database;
+	TStoryInbox<FInboxItem, 256> inbox;
+
+	TAtomic<uint64> version;
+	uint64 snapshotVersion;
+
+	/*
+		Readers load the published pointer without a lock and take a reference from it. The last snapshots are
+		kept alive by the manager, so one replaced while a reader is between the load and the reference is only
+		released a few publishes (frames) later.
+	*/
+	static const int32 NumKeptSnapshots = 4;
+	FStoryKeySnapshotPtr keptSnapshots[NumKeptSnapshots];
+	int32 keptSnapshotIndex;
+	TAtomic<const FStoryKeySnapshot*> publishedSnapshot;
+
+	// bit per key id, mirrors Database
+	TArray<uint32> keyWords;
+
+	void MarkChanged();
+	void SetKeyBit(FName Key, bool bHasKey);
+	void RebuildKeyWords();
 
 public:
+	UStoryKeyManager();
 
 	FStoryKeyChangeSignature OnKeyAdd;
 	FStoryKeyChangeSignature OnKeyRemove;
@@ -62,7 +132,23 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|StoryKey")
 	void LoadFromBinary(const TArray<uint8>& Data);
 
-	virtual void BeginDestroy() override;
+	// thread safe, applied on the game thread once per frame
+	void PostAddKey(FName Key);
+	void PostRemoveKey(FName Key);
+
+	int32 ProcessInbox();
+
+	// incremented by every key change, cheap way to detect a stale snapshot or cache
+	uint64 GetKeysVersion() const;
+
+	// last published snapshot, lock free and thread safe; published once per frame after the inbox is drained
+	FStoryKeySnapshotPtr GetSnapshot() const;
+	void PublishSnapshot();
+
+	// key set as bits indexed by FStoryKeyIds, padded with zeros to at least MinWords
+	const uint32* GetKeyWords(int32 MinWords);
+
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
 
 	friend FArchive& operator<<(FArchive& Ar, UStoryKeyManager& A);
 };
@@ -0,0 +1,149 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Tuple.h"
+#include "Templates/IntegerSequence.h"
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Native call"), STAT_QaDS_NativeCall, STATGROUP_QaDS, DIALOGSYSTEMRUNTIME_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reflection call"), STAT_QaDS_ReflectionCall, STATGROUP_QaDS, DIALOGSYSTEMRUNTIME_API);
+
+/*
+	Parameters of native story functions, parsed once when the event is bound
+*/
+inline bool ParseStoryNativeParam(const FString& Str, bool& Out) { Out = Str.ToBool(); return true; }
+inline bool ParseStoryNativeParam(const FString& Str, int32& Out) { return LexTryParseString(Out, *Str); }
+inline bool ParseStoryNativeParam(const FString& Str, float& Out) { return LexTryParseString(Out, *Str); }
+inline bool ParseStoryNativeParam(const FString& Str, FName& Out) { Out = *Str; return true; }
+inline bool ParseStoryNativeParam(const FString& Str, FString& Out) { Out = Str; return true; }
+
+template<typename T> struct TStoryNativeParamType;
+template<> struct TStoryNativeParamType<bool> { static const TCHAR* GetName() { return TEXT("bool"); } };
+template<> struct TStoryNativeParamType<int32> { static const TCHAR* GetName() { return TEXT("int32"); } };
+template<> struct TStoryNativeParamType<float> { static const TCHAR* GetName() { return TEXT("float"); } };
+template<> struct TStoryNativeParamType<FName> { static const TCHAR* GetName() { return TEXT("FName"); } };
+template<> struct TStoryNativeParamType<FString> { static const TCHAR* GetName() { return TEXT("FString"); } };
+
+// Native function with its parameters already parsed
+class FStoryNativeCall
+{
+public:
+	virtual ~FStoryNativeCall() {}
+	virtual bool Call(UObject* Caller) const = 0;
+};
+
+template<typename TResult, typename... TArgs>
+class TStoryNativeCall : public FStoryNativeCall
+{
+	TFunction<TResult(UObject*, TArgs...)> function;
+	TTuple<typename TDecay<TArgs>::Type...> params;
+
+	template<uint32... Indices>
+	bool ParseParams(const TArray<FString>& Params, TIntegerSequence<uint32, Indices...>)
+	{
+		bool parsed[] = { true, ParseStoryNativeParam(Params[Indices], params.template Get<Indices>())... };
+
+		for (auto p : parsed)
+		{
+			if (!p)
+				return false;
+		}
+
+		return true;
+	}
+
+public:
+	TStoryNativeCall(const TFunction<TResult(UObject*, TArgs...)>& Function) : function(Function) {}
+
+	bool Parse(const TArray<FString>& Params)
+	{
+		return ParseParams(Params, TMakeIntegerSequence<uint32, sizeof...(TArgs)>());
+	}
+
+	virtual bool Call(UObject* Caller) const override
+	{
+		return CallFunction(Caller, (TResult*)NULL);
+	}
+
+private:
+	bool CallFunction(UObject* Caller, bool*) const
+	{
+		return params.ApplyAfter(function, Caller);
+	}
+
+	bool CallFunction(UObject* Caller, void*) const
+	{
+		params.ApplyAfter(function, Caller);
+		return true;
+	}
+};
+
+struct DIALOGSYSTEMRUNTIME_API FStoryNativeFunction
+{
+	FName Name;
+	bool bIsCondition;
+	TArray<FString> ParamTypes;
+	TFunction<TSharedPtr<FStoryNativeCall>(const TArray<FString>&)> Bind;
+};
+
+/*
+	Named C++ conditions and actions, called directly by events with the Native call type.
+	The first argument is the caller: UDialogProcessor for dialogs, UQuestRuntimeNode for quests.
+
+	FStoryNativeRegistry::Get().RegisterCondition<FName, int32>("HasItem", [](UObject* Caller, FName Item, int32 Count) { ... });
+*/
+class DIALOGSYSTEMRUNTIME_API FStoryNativeRegistry
+{
+	TMap<FName, FStoryNativeFunction> functions;
+
+	template<typename TResult, typename... TArgs>
+	void Register(FName Name, bool bIsCondition, const TFunction<TResult(UObject*, TArgs...)>& Function)
+	{
+		FStoryNativeFunction native;
+		native.Name = Name;
+		native.bIsCondition = bIsCondition;
+		native.ParamTypes = { FString(TStoryNativeParamType<typename TDecay<TArgs>::Type>::GetName())... };
+		native.Bind = [Function](const TArray<FString>& Params) -> TSharedPtr<FStoryNativeCall>
+		{
+			if (Params.Num() != sizeof...(TArgs))
+				return nullptr;
+
+			auto call = MakeShared<TStoryNativeCall<TResult, TArgs...>>(Function);
+			if (!call->Parse(Params))
+				return nullptr;
+
+			return call;
+		};
+
+		Add(native);
+	}
+
+	void Add(const FStoryNativeFunction& Native);
+
+public:
+	static FStoryNativeRegistry& Get();
+
+	template<typename... TArgs>
+	void RegisterCondition(FName Name, typename TIdentity<TFunction<bool(UObject*, TArgs...)>>::Type Function)
+	{
+		Register<bool, TArgs...>(Name, true, Function);
+	}
+
+	template<typename... TArgs>
+	void RegisterAction(FName Name, typename TIdentity<TFunction<void(UObject*, TArgs...)>>::Type Function)
+	{
+		Register<void, TArgs...>(Name, false, Function);
+	}
+
+	void Unregister(FName Name);
+	const FStoryNativeFunction* Find(FName Name) const;
+	void GetNames(bool bConditions, TArray<FName>& OutNames) const;
+
+	// Returns NULL and fills ErrorMessage if the function is not registered or the parameters do not parse
+	TSharedPtr<FStoryNativeCall> Bind(FName Name, bool bIsCondition, const TArray<FString>& Params, FString& ErrorMessage) const;
+
+	// Event compile: fits Params to the registered parameter count, binds and writes the event command
+	TSharedPtr<FStoryNativeCall> Compile(FName Name, bool bIsCondition, TArray<FString>& Params, FString& OutCommand, FString& ErrorMessage) const;
+
+	// Event call: binds Call if it is not bound yet (events loaded from an asset), errors are logged
+	bool BindOnce(FName Name, bool bIsCondition, const TArray<FString>& Params, TSharedPtr<FStoryNativeCall>& Call) const;
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "EngineUtils.h"
+#include "StoryObjectPool.generated.h"
+
+class UDialogProcessor;
+class UStoryContext;
+
+USTRUCT()
+struct FStoryPooledActors
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AActor*> Actors;
+};
+
+// Free dialog processors and script actors of one story context, reused instead of spawned
+UCLASS()
+class DIALOGSYSTEMRUNTIME_API UStoryObjectPool : public UObject
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UDialogProcessor*> freeProcessors;
+
+	// ended processors with the frame they ended in
+	UPROPERTY()
+	TArray<UDialogProcessor*> endedProcessors;
+
+	TArray<uint64> endedFrames;
+
+	void RecycleEndedProcessors();
+
+	UPROPERTY()
+	TMap<UClass*, FStoryPooledActors> freeActors;
+
+	int32 numFreeActors = 0;
+
+public:
+	UDialogProcessor* AcquireProcessor();
+
+	// called from EndDialog, the processor is reset and reused from the next frame on
+	void ReleaseProcessor(UDialogProcessor* Processor);
+
+	// spawns a new actor when the pool has none of this class in the world
+	AActor* AcquireActor(UWorld* World, UClass* ActorClass);
+	void ReleaseActor(AActor* Actor);
+
+	template<typename T>
+	T* AcquireActor(UWorld* World, TSubclassOf<T> ActorClass)
+	{
+		return Cast<T>(AcquireActor(World, ActorClass.Get()));
+	}
+
+	UFUNCTION(BlueprintCallable, Category = "Gameplay|Story")
+	void Empty();
+
+	int32 GetNumFreeProcessors() const { return freeProcessors.Num(); }
+	int32 GetNumFreeActors() const { return numFreeActors; }
+
+	static UStoryObjectPool* Get(UObject* WorldContextObject);
+
+	virtual void BeginDestroy() override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+};
\ No newline at end of file
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "EngineUtils.h"
+#include "Components/ActorComponent.h"
+#include "StoryReplication.h"
+#include "StoryPlayerComponent.generated.h"
+
+class UStoryContext;
+class UQuestRuntimeAsset;
+class UQuestRuntimeNode;
+class APawn;
+
+// Add to a PlayerController (or PlayerState) to give that player its own story state
+UCLASS(ClassGroup = (Story), meta = (BlueprintSpawnableComponent))
+class DIALOGSYSTEMRUNTIME_API UStoryPlayerComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	UStoryContext* StoryContext;
+
+	UPROPERTY(Replicated)
+	FStoryKeyNameArray KeyNames;
+
+	UPROPERTY(Replicated)
+	FStoryKeyWordArray KeyWords;
+
+	UPROPERTY(Replicated)
+	FStoryQuestStateArray QuestStates;
+
+	UPROPERTY(Replicated)
+	FStoryStageStateArray StageStates;
+
+	// server
+	TMap<FName, int32> serverKeyIds;
+	TMap<TWeakObjectPtr<UQuestRuntimeAsset>, int32> serverQuestIds;
+	TMap<int32, int32> serverQuestItems;
+	TMap<uint64, int32> serverStageItems;
+	TArray<int32> serverEndedQuests;
+	FTimerHandle serverPruneTimer;
+	int32 nextQuestId;
+
+#if STATS
+	// bytes of each key name in an RPC carrying the whole key list, and of that list for the owned keys
+	TArray<uint16> serverNameBytes;
+	uint32 serverNameListBytes = sizeof(int32);
+#endif
+
+	void SetArrayOwners();
+
+	void OnServerKeyAdd(const FName& Key);
+	void OnServerKeyRemove(const FName& Key);
+	void OnServerKeysLoaded(const TArray<FName>& Keys);
+	void OnServerStageStatus(UQuestRuntimeNode* Stage);
+	void SetReplicatedKey(FName Key, bool bHasKey);
+	void SetReplicatedQuest(UQuestRuntimeAsset* Quest);
+	int32 SetReplicatedStage(UQuestRuntimeNode* Stage);
+	void RebuildReplicatedQuests();
+	void PruneEndedQuests();
+	void ReindexReplicatedQuests();
+
+	UFUNCTION()
+	void OnServerQuestStart(UQuestRuntimeAsset* Quest);
+
+	UFUNCTION()
+	void OnServerQuestEnd(UQuestRuntimeAsset* Quest, EQuestCompleteStatus QuestStatus);
+
+	// client
+	TArray<FName> clientKeyNames;
+	TArray<uint32> clientAppliedWords;
+
+	UPROPERTY()
+	TMap<int32, UQuestRuntimeAsset*> clientQuests;
+
+public:
+	UStoryPlayerComponent();
+
+	virtual void PostInitProperties() override;
+	virtual void BeginPlay() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	void OnRepKeyName(const FStoryKeyNameItem& Item);
+	void OnRepKeyWords();
+	void OnRepQuestState(const FStoryQuestStateItem& Item);
+	void OnRepQuestRemoved(const FStoryQuestStateItem& Item);
+	void OnRepStageState(const FStoryStageStateItem& Item);
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Story")
+	UStoryContext* GetStoryContext();
+
+	UFUNCTION(BlueprintPure, Category = "Gameplay|Story")
+	APawn* GetPlayerPawn() const;
+
+	static UStoryPlayerComponent* FindPlayerComponent(UObject* Object);
+};
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+// Memoizes results of pure condition predicates.
+// Results live for one frame and are dropped as soon as the story keys change.
+struct DIALOGSYSTEMRUNTIME_API FStoryPredicateCache
+{
+	FStoryPredicateCache();
+
+	// CommandHash is a case sensitive hash of Command (see HashCommand), made once by the caller so lookups do not copy strings
+	bool Find(const UObject* Target, FName Function, const FString& Command, uint32 CommandHash, uint64 KeysVersion, bool& OutResult);
+	void Add(const UObject* Target, FName Function, const FString& Command, uint32 CommandHash, bool Result);
+	void Reset();
+
+	static uint32 HashCommand(const FString& Command);
+
+	uint32 GetHits() const { return hits; }
+	uint32 GetMisses() const { return misses; }
+
+private:
+	struct FKey
+	{
+		FObjectKey Target;
+		FName Function;
+		uint32 CommandHash;
+
+		FKey(const UObject* InTarget, FName InFunction, uint32 InCommandHash) : Target(InTarget), Function(InFunction), CommandHash(InCommandHash) {}
+
+		bool operator==(const FKey& Other) const
+		{
+			return Target == Other.Target && Function == Other.Function && CommandHash == Other.CommandHash;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.Target), HashCombine(GetTypeHash(Key.Function), Key.CommandHash));
+		}
+	};
+
+	// commands with the same hash, compared exactly
+	struct FResult
+	{
+		FString Command;
+		bool Result;
+	};
+
+	TMap<FKey, TArray<FResult, TInlineAllocator<1>>> results;
+	uint64 frame;
+	uint64 keysVersion;
+	uint32 hits;
+	uint32 misses;
+
+	void UpdateEpoch(uint64 KeysVersion);
+};
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FStoryPredicateStats
+{
+	int64 Calls = 0;
+	int64 TrueCount = 0;
+	double Seconds = 0;
+
+	double GetAverageTime() const { return Calls > 0 ? Seconds / Calls : 0; }
+	double GetTrueRate() const { return Calls > 0 ? (double)TrueCount / Calls : 0; }
+
+	// Expected cost of reaching a rejection through this predicate, lower should run first
+	double GetRank() const { return GetAverageTime() / FMath::Max(1.0 - GetTrueRate(), 1e-6); }
+};
+
+/*
+	Records how often predicates pass and how long they take while QaDS.ProfilePredicates is set.
+	Data is accumulated across sessions in Saved/QaDS/PredicateProfile.txt,
+	the editor uses it to reorder pure predicates on compile.
+*/
+class DIALOGSYSTEMRUNTIME_API FStoryPredicateProfiler
+{
+public:
+	static bool IsEnabled();
+
+	static FString MakeId(const UObject* Asset, const FString& NodeId, const FString& Predicate);
+	static void Record(const FString& Id, bool bResult, double Seconds);
+
+	static const TMap<FString, FStoryPredicateStats>& GetStats();
+	static FString GetFilePath();
+	static void Load();
+	static void Save();
+	static void Reset();
+
+	// Sorts each run of adjacent pure predicates by rank, impure predicates keep their place.
+	// Runs with no recorded data are left untouched. Returns true if the order changed.
+	template<typename TCondition>
+	static bool SortPredicates(TArray<TCondition>& Predicates, const UObject* Asset, const FString& NodeId)
+	{
+		TArray<double> ranks;
+		TArray<bool> pure;
+
+		for (auto& predicate : Predicates)
+		{
+			auto stats = GetStats().Find(MakeId(Asset, NodeId, predicate.ToString()));
+			ranks.Add(stats ? stats->GetRank() : -1);
+			pure.Add(predicate.bIsPure);
+		}
+
+		TArray<int32> order;
+		if (!SortRuns(ranks, pure, order))
+			return false;
+
+		TArray<TCondition> sorted;
+		for (auto index : order)
+			sorted.Add(Predicates[index]);
+
+		Predicates = sorted;
+		return true;
+	}
+
+private:
+	static bool SortRuns(const TArray<double>& Ranks, const TArray<bool>& Pure, TArray<int32>& OutOrder);
+};
\ No newline at end of file
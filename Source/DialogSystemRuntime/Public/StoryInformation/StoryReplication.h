@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Engine/NetSerialization.h"
+#include "QuestNode.h"
+#include "StoryReplication.generated.h"
+
+class UStoryPlayerComponent;
+class UQuestAsset;
+
+// Story keys are sent once as names, then only as bits of 32-bit words indexed by dense key id
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryKeyNameItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 KeyId = 0;
+
+	UPROPERTY()
+	FName Key;
+
+	void PostReplicatedAdd(const struct FStoryKeyNameArray& InArraySerializer);
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryKeyNameArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FStoryKeyNameItem> Items;
+
+	UStoryPlayerComponent* Owner = NULL;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryKeyWordItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 WordIndex = 0;
+
+	UPROPERTY()
+	uint32 Bits = 0;
+
+	void PostReplicatedAdd(const struct FStoryKeyWordArray& InArraySerializer);
+	void PostReplicatedChange(const struct FStoryKeyWordArray& InArraySerializer);
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryKeyWordArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FStoryKeyWordItem> Items;
+
+	UStoryPlayerComponent* Owner = NULL;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+// Quest status, stages are referenced by quest id and stage index in the quest asset
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryQuestStateItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 QuestId = 0;
+
+	UPROPERTY()
+	TSoftObjectPtr<UQuestAsset> Asset;
+
+	UPROPERTY()
+	EQuestCompleteStatus Status = EQuestCompleteStatus::None;
+
+	void PostReplicatedAdd(const struct FStoryQuestStateArray& InArraySerializer);
+	void PostReplicatedChange(const struct FStoryQuestStateArray& InArraySerializer);
+	void PreReplicatedRemove(const struct FStoryQuestStateArray& InArraySerializer);
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryQuestStateArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FStoryQuestStateItem> Items;
+
+	UStoryPlayerComponent* Owner = NULL;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryStageStateItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 QuestId = 0;
+
+	UPROPERTY()
+	uint16 StageIndex = 0;
+
+	UPROPERTY()
+	EQuestCompleteStatus Status = EQuestCompleteStatus::None;
+
+	void PostReplicatedAdd(const struct FStoryStageStateArray& InArraySerializer);
+	void PostReplicatedChange(const struct FStoryStageStateArray& InArraySerializer);
+};
+
+USTRUCT()
+struct DIALOGSYSTEMRUNTIME_API FStoryStageStateArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FStoryStageStateItem> Items;
+
+	UStoryPlayerComponent* Owner = NULL;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+};
+
+template<>
+struct TStructOpsTypeTraits<FStoryKeyNameArray> : public TStructOpsTypeTraitsBase2<FStoryKeyNameArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+template<>
+struct TStructOpsTypeTraits<FStoryKeyWordArray> : public TStructOpsTypeTraitsBase2<FStoryKeyWordArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+template<>
+struct TStructOpsTypeTraits<FStoryQuestStateArray> : public TStructOpsTypeTraitsBase2<FStoryQuestStateArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
+
+template<>
+struct TStructOpsTypeTraits<FStoryStageStateArray> : public TStructOpsTypeTraitsBase2<FStoryStageStateArray>
+{
+	enum { WithNetDeltaSerializer = true };
+};
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "EngineUtils.h"
+#include "StoryInbox.h"
 #include "StoryTriggerManager.generated.h"
 
 USTRUCT(BlueprintType)
@@ -27,7 +28,7 @@ class DIALOGSYSTEMRUNTIME_API UStoryTriggerManager : public UObject
 {
 	GENERATED_BODY()
 
-	static UStoryTriggerManager* Instance;
+	TStoryInbox<FStoryTrigger, 64> inbox;
 
 public:
 	UPROPERTY(BlueprintAssignable, Category = "Gameplay|Triggers")
@@ -39,5 +40,8 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Gameplay|Triggers")
 	void InvokeTrigger(const FStoryTrigger& Trigger);
 
-	virtual void BeginDestroy() override;
+	// thread safe, invoked on the game thread once per frame
+	void PostTrigger(const FStoryTrigger& Trigger);
+
+	int32 ProcessInbox();
 };